@@ -16,6 +16,7 @@
 #ifndef NEURAL_NETWORK_RUNTIME_UTILS_H
 #define NEURAL_NETWORK_RUNTIME_UTILS_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -51,6 +52,9 @@ std::unique_ptr<T> CreateUniquePtr(Args&&... args)
 
 std::string GenUniqueName(const std::string&, const std::string&, const std::string&);
 
+// 64 bits xxHash of the buffer, pass the previous hash as seed to hash discontinuous data.
+uint64_t GetXXHash64(const void* data, size_t length, uint64_t seed = 0);
+
 } // namespace NeuralNetworkRuntime
 } // namespace OHOS
 #endif // NEURAL_NETWORK_RUNTIME_UTILS_H
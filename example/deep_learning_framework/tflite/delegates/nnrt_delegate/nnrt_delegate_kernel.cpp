@@ -133,9 +133,8 @@ TfLiteStatus NnrtDelegateKernel::Invoke(TfLiteContext* context, TfLiteNode* node
         return kTfLiteError;
     }
 
-    // Create OH_NNExecutor_Construct
-    OH_NNExecutor* pNnExecution {nullptr};
-    pNnExecution = m_nnrt->OH_NNExecutor_Construct(m_pNnCompilation);
+    // Take an executor from the compilation, it is only constructed on the first invocation.
+    OH_NNExecutor* pNnExecution = AcquireExecutor();
     if (pNnExecution == nullptr) {
         TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "[NNRT-DELEGATE_KERNEL] Fail to create OH_NNExecutor instance.");
         return kTfLiteError;
@@ -143,17 +142,56 @@ TfLiteStatus NnrtDelegateKernel::Invoke(TfLiteContext* context, TfLiteNode* node
 
     // Set the input tensor buffers.
     OH_NN_Tensor inputNnTensor;
-    TF_LITE_ENSURE_STATUS(SetInputTensors(context, node, pNnExecution, inputNnTensor));
+    TfLiteStatus status = SetInputTensors(context, node, pNnExecution, inputNnTensor);
 
     // Get the output tensor buffers.
-    TF_LITE_ENSURE_STATUS(SetOutputTensors(context, node, pNnExecution));
+    if (status == kTfLiteOk) {
+        status = SetOutputTensors(context, node, pNnExecution);
+    }
 
     // Invoke delegated subgraph.
-    RETURN_TFLITE_ERROR_IF_NN_ERROR(m_nnrt->OH_NNExecutor_Run(pNnExecution), "running computation");
+    if (status == kTfLiteOk) {
+        OH_NN_ReturnCode ret = m_nnrt->OH_NNExecutor_Run(pNnExecution);
+        if (ret != OH_NN_SUCCESS) {
+            TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "NN API returned error %s at line %d while %s.\n",
+                NnrtErrorDescription(ret).c_str(), __LINE__, "running computation");
+            status = kTfLiteError;
+        }
+    }
 
-    m_nnrt->OH_NNExecutor_Destroy(&pNnExecution);
-    pNnExecution = nullptr;
-    return kTfLiteOk;
+    ReleaseExecutor(&pNnExecution);
+    return status;
+}
+
+OH_NNExecutor* NnrtDelegateKernel::AcquireExecutor()
+{
+    // Fall back to constructing a new executor if the executor pool is not provided by the library.
+    if ((m_nnrt->OH_NNCompilation_AcquireExecutor == nullptr) ||
+        (m_nnrt->OH_NNCompilation_ReleaseExecutor == nullptr)) {
+        return m_nnrt->OH_NNExecutor_Construct(m_pNnCompilation);
+    }
+
+    // The delegate binds the tflite buffers by itself, the tensors bound to the executor are not used here.
+    NN_Tensor** inputTensors {nullptr};
+    size_t inputCount {0};
+    NN_Tensor** outputTensors {nullptr};
+    size_t outputCount {0};
+    return m_nnrt->OH_NNCompilation_AcquireExecutor(m_pNnCompilation, &inputTensors, &inputCount, &outputTensors,
+        &outputCount);
+}
+
+void NnrtDelegateKernel::ReleaseExecutor(OH_NNExecutor** pNnExecution)
+{
+    if ((m_nnrt->OH_NNCompilation_AcquireExecutor == nullptr) ||
+        (m_nnrt->OH_NNCompilation_ReleaseExecutor == nullptr)) {
+        m_nnrt->OH_NNExecutor_Destroy(pNnExecution);
+        return;
+    }
+
+    OH_NN_ReturnCode ret = m_nnrt->OH_NNCompilation_ReleaseExecutor(m_pNnCompilation, pNnExecution);
+    if (ret != OH_NN_SUCCESS) {
+        TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "[NNRT-DELEGATE_KERNEL] Fail to release OH_NNExecutor instance.");
+    }
 }
 
 TfLiteStatus NnrtDelegateKernel::Map(const int32_t builtinCode, const NnrtOpMappingArgs& mappingArgs,
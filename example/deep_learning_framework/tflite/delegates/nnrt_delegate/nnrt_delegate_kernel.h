@@ -73,6 +73,8 @@ private:
         OH_NN_Tensor& nnTensor);
     TfLiteStatus SetOutputTensors(TfLiteContext* context, TfLiteNode* node, OH_NNExecutor* pNnExecution);
     TfLiteStatus SetNnOptions(TfLiteContext* context, const NnrtDelegate::Options& delegateOptions);
+    OH_NNExecutor* AcquireExecutor();
+    void ReleaseExecutor(OH_NNExecutor** pNnExecution);
 
 private:
     // True if initialization has been completed successfully
@@ -45,7 +45,7 @@ void LoadFunction(void* handle, const char* name, T* nnrtFunction)
 
 const NnrtApi LoadNnrt()
 {
-    NnrtApi nnrt;
+    NnrtApi nnrt {};
     nnrt.nnrtExists = false;
     void* libNeuralNetworks = nullptr;
 
@@ -78,6 +78,8 @@ const NnrtApi LoadNnrt()
     LoadFunction(libNeuralNetworks, "OH_NNCompilation_EnableFloat16", &nnrt.OH_NNCompilation_EnableFloat16);
     LoadFunction(libNeuralNetworks, "OH_NNCompilation_Build", &nnrt.OH_NNCompilation_Build);
     LoadFunction(libNeuralNetworks, "OH_NNCompilation_Destroy", &nnrt.OH_NNCompilation_Destroy);
+    LoadFunction(libNeuralNetworks, "OH_NNCompilation_AcquireExecutor", &nnrt.OH_NNCompilation_AcquireExecutor);
+    LoadFunction(libNeuralNetworks, "OH_NNCompilation_ReleaseExecutor", &nnrt.OH_NNCompilation_ReleaseExecutor);
 
     // NNExecutor
     LoadFunction(libNeuralNetworks, "OH_NNExecutor_Construct", &nnrt.OH_NNExecutor_Construct);
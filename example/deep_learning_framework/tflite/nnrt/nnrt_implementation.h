@@ -58,6 +58,9 @@ struct NnrtApi {
     OH_NN_ReturnCode (*OH_NNCompilation_SetDevice)(OH_NNCompilation* compilation, size_t deviceID);
     OH_NN_ReturnCode (*OH_NNCompilation_Build)(OH_NNCompilation* compilation);
     void (*OH_NNCompilation_Destroy)(OH_NNCompilation** compilation);
+    OH_NNExecutor* (*OH_NNCompilation_AcquireExecutor)(OH_NNCompilation* compilation, NN_Tensor*** inputTensor,
+        size_t* inputCount, NN_Tensor*** outputTensor, size_t* outputCount);
+    OH_NN_ReturnCode (*OH_NNCompilation_ReleaseExecutor)(OH_NNCompilation* compilation, OH_NNExecutor** executor);
     // Executor interface
     OH_NNExecutor* (*OH_NNExecutor_Construct)(OH_NNCompilation* compilation);
     OH_NN_ReturnCode (*OH_NNExecutor_SetInput)(OH_NNExecutor* executor, uint32_t inputIndex,
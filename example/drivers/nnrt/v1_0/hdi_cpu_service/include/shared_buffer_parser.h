@@ -32,7 +32,8 @@ public:
     SharedBufferParser() {};
     ~SharedBufferParser();
 
-    int32_t Init(const SharedBuffer& buffer);
+    // Buffers which are only read, such as the model caches, may come from read-only files.
+    int32_t Init(const SharedBuffer& buffer, bool isReadOnly = false);
     int32_t Init(const std::string& name, int32_t size);
     void* GetBufferPtr();
     SharedBuffer GetBuffer();
@@ -158,7 +158,7 @@ int32_t NnrtDeviceService::PrepareModelFromModelCache(const std::vector<SharedBu
     }
 
     SharedBufferParser parser;
-    auto ret = parser.Init(modelCache[0]);
+    auto ret = parser.Init(modelCache[0], true);
     if (ret != HDF_SUCCESS) {
         HDF_LOGE("Parse modle buffer failed.");
         return HDF_ERR_INVALID_PARAM;
@@ -141,9 +141,9 @@ int32_t PreparedModelService::UpdateOutput(const std::vector<IOTensor>& outputs,
         outputsDims.emplace_back(msShape.begin(), msShape.end());
 
         auto dataSize = msOutput.DataSize();
-        if (dataSize > output.data.bufferSize) {
+        if (dataSize > output.data.dataSize) {
             HDF_LOGE("Output buffer is not enough. actual size %{public}zu, buffer size %{public}u",
-                dataSize, output.data.bufferSize);
+                dataSize, output.data.dataSize);
             isOutputBufferEnough[i] = false;
             isEnough= false;
         }
@@ -299,7 +299,7 @@ int32_t PreparedModelService::SetInputs(const std::vector<IOTensor>& inputs)
             return HDF_ERR_INVALID_PARAM;
         }
 
-        auto data = const_cast<void*>(ashptr->ReadFromAshmem(input.data.dataSize, 0));
+        auto data = const_cast<void*>(ashptr->ReadFromAshmem(input.data.dataSize, input.data.offset));
         msInput.SetData(data);
         m_inputAshmems.emplace_back(ashptr);
     }
@@ -329,7 +329,7 @@ int32_t PreparedModelService::SetOutputs(const std::vector<IOTensor>& outputs)
             return HDF_ERR_INVALID_PARAM;
         }
 
-        auto data = const_cast<void*>(ashptr->ReadFromAshmem(output.data.dataSize, 0));
+        auto data = const_cast<void*>(ashptr->ReadFromAshmem(output.data.dataSize, output.data.offset));
         msOutput.SetAllocator(nullptr);
         msOutput.SetData(data);
         m_outputAshmems.emplace_back(ashptr);
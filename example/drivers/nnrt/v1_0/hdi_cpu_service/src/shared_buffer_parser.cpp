@@ -59,7 +59,7 @@ int32_t SharedBufferParser::Init(const std::string& name, int32_t size)
     return HDF_SUCCESS;
 }
 
-int32_t SharedBufferParser::Init(const SharedBuffer& buffer)
+int32_t SharedBufferParser::Init(const SharedBuffer& buffer, bool isReadOnly)
 {
     if (buffer.fd == INVALID_FD) {
         HDF_LOGE("Invalid buffer fd, it cannot be %{public}d.", INVALID_FD);
@@ -72,7 +72,8 @@ int32_t SharedBufferParser::Init(const SharedBuffer& buffer)
         return HDF_FAILURE;
     }
 
-    if (!m_ashptr->MapReadAndWriteAshmem()) {
+    bool isMapped = isReadOnly ? m_ashptr->MapReadOnlyAshmem() : m_ashptr->MapReadAndWriteAshmem();
+    if (!isMapped) {
         HDF_LOGE("Map buffer fd to address failed.");
         return HDF_FAILURE;
     }
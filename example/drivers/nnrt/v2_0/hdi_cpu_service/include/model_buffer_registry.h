@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_HDI_NNRT_V2_0_MODEL_BUFFER_REGISTRY_H
+#define OHOS_HDI_NNRT_V2_0_MODEL_BUFFER_REGISTRY_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace HDI {
+namespace Nnrt {
+namespace V2_0 {
+using ModelBuffer = std::vector<uint8_t>;
+
+// Deduplicates the serialized model buffers kept by the prepared models of the service. Preparing a model whose
+// serialized content equals a registered buffer references the registered buffer instead of keeping another copy of
+// it. This is buffer dedup only: every prepared model and context still builds its own model with its own weights.
+// A buffer is dropped with its last prepared model.
+class ModelBufferRegistry {
+public:
+    ModelBufferRegistry() = default;
+    ~ModelBufferRegistry() = default;
+
+    std::shared_ptr<const ModelBuffer> Register(const void* buffer, size_t length);
+
+private:
+    ModelBufferRegistry(const ModelBufferRegistry&) = delete;
+    ModelBufferRegistry& operator=(const ModelBufferRegistry&) = delete;
+
+private:
+    std::unordered_multimap<size_t, std::weak_ptr<const ModelBuffer>> m_buffers;
+    std::mutex m_mtx;
+};
+} // V2_0
+} // Nnrt
+} // HDI
+} // OHOS
+#endif // OHOS_HDI_NNRT_V2_0_MODEL_BUFFER_REGISTRY_H
@@ -17,9 +17,13 @@
 #define OHOS_HDI_NNRT_V2_0_NNRTDEVICESERVICE_H
 
 #include <memory>
+#include <mutex>
+#include <string>
 
 #include "v2_0/innrt_device.h"
 #include "ashmem.h"
+#include "model_buffer_registry.h"
+#include "shared_buffer_cache.h"
 #include "include/api/model.h"
 
 #include "mindspore_schema/model_generated.h"
@@ -82,7 +86,11 @@ private:
 
 private:
     std::shared_ptr<mindspore::Model> m_model {nullptr};
-    std::unordered_map<int, sptr<Ashmem>> m_ashmems;
+    // Buffers allocated for the client, by their region names
+    std::unordered_map<std::string, sptr<Ashmem>> m_ashmems;
+    std::mutex m_ashmemsMtx;
+    std::shared_ptr<SharedBufferCache> m_bufferCache {std::make_shared<SharedBufferCache>()};
+    std::shared_ptr<ModelBufferRegistry> m_modelRegistry {std::make_shared<ModelBufferRegistry>()};
 };
 } // V2_0
 } // Nnrt
@@ -16,6 +16,15 @@
 #ifndef OHOS_HDI_NNRT_V2_0_PREPAREDMODELSERVICE_H
 #define OHOS_HDI_NNRT_V2_0_PREPAREDMODELSERVICE_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "v2_0/iprepared_model.h"
 #include "include/api/data_type.h"
 #include "include/api/context.h"
@@ -23,19 +32,27 @@
 #include "include/api/model.h"
 #include "mindspore_schema/model_generated.h"
 #include "ashmem.h"
+#include "model_buffer_registry.h"
+#include "shared_buffer_cache.h"
 
 namespace OHOS {
 namespace HDI {
 namespace Nnrt {
 namespace V2_0 {
 constexpr int DYNAMIC_SHAPE_FLAG = -1;
+// Extension config of the dim ranges of the inputs, e.g. "1:8:64,3,224,224;1:16:128". Inputs are separated by ';' and
+// dimensions by ','. A dynamic dimension is given as "min:opt:max", a fixed one as its value.
+const std::string EXTENSION_KEY_INPUT_DIM_RANGES = "InputDimRanges";
 class PreparedModelService : public IPreparedModel {
 public:
     PreparedModelService() = default;
 
     virtual ~PreparedModelService();
 
-    explicit PreparedModelService(std::shared_ptr<mindspore::Context> context);
+    PreparedModelService(std::shared_ptr<mindspore::Context> context, std::shared_ptr<SharedBufferCache> bufferCache,
+        std::shared_ptr<ModelBufferRegistry> modelRegistry);
+
+    NNRT_ReturnCode SetDimRangesConfig(const std::map<std::string, std::vector<int8_t>>& extensions);
 
     NNRT_ReturnCode Compile(std::shared_ptr<mindspore::schema::MetaGraphT> graph);
 
@@ -50,27 +67,57 @@ public:
         std::vector<std::vector<uint32_t>>& maxInputDims) override;
 
 private:
-    NNRT_ReturnCode SetInputs(const std::vector<IOTensor>& inputs);
-    NNRT_ReturnCode SetOutputs(const std::vector<IOTensor>& outputs);
-    NNRT_ReturnCode GetMSInputsAndOutputs();
-    NNRT_ReturnCode CompareTensor(const IOTensor& tensor, const mindspore::MSTensor& msTensor);
+    // Everything a run mutates, so that concurrent runs on different contexts do not interfere with each other.
+    struct ExecutionContext {
+        std::shared_ptr<mindspore::Model> model {nullptr};
+        std::vector<mindspore::MSTensor> inputs;
+        std::vector<mindspore::MSTensor> outputs;
+        std::vector<sptr<Ashmem>> inputAshmems;
+        std::vector<sptr<Ashmem>> outputAshmems;
+        std::vector<std::vector<int64_t>> resizedDims;
+        std::vector<bool> isOutputBound;
+    };
+
+    NNRT_ReturnCode SetInputs(ExecutionContext& context, const std::vector<IOTensor>& inputs);
+    NNRT_ReturnCode SetOutputs(ExecutionContext& context, const std::vector<IOTensor>& outputs);
+    NNRT_ReturnCode BindDynamicOutputs(ExecutionContext& context, const std::vector<IOTensor>& outputs);
+    NNRT_ReturnCode GetMSInputsAndOutputs(ExecutionContext& context);
+    NNRT_ReturnCode CompareTensor(const IOTensor& tensor, const mindspore::MSTensor& msTensor, size_t index);
+    NNRT_ReturnCode InitDimRanges();
+    NNRT_ReturnCode ResizeToOptDims(ExecutionContext& context);
     sptr<Ashmem> ParseBuffer(const SharedBuffer& buffer);
-    NNRT_ReturnCode UpdateOutput(const std::vector<IOTensor>& outputs,
+    NNRT_ReturnCode UpdateOutput(ExecutionContext& context, const std::vector<IOTensor>& outputs,
         std::vector<std::vector<int32_t>>& outputsDims, bool& isOutputBufferEnough);
-    void ResetInputAndOutput();
+    void ResetInputAndOutput(ExecutionContext& context);
+    NNRT_ReturnCode RunWithContext(ExecutionContext& context, const std::vector<IOTensor>& inputs,
+        const std::vector<IOTensor>& outputs, std::vector<std::vector<int32_t>>& outputsDims);
+    NNRT_ReturnCode RegisterModelBuffer(const void* modelBuffer, size_t length);
+    NNRT_ReturnCode CreateExecutionContext(std::unique_ptr<ExecutionContext>& context);
+    NNRT_ReturnCode AcquireExecutionContext(std::unique_ptr<ExecutionContext>& context);
+    void InitExecutionContexts(std::unique_ptr<ExecutionContext> context);
+    void ReleaseExecutionContext(std::unique_ptr<ExecutionContext> context);
 
 private:
     std::shared_ptr<mindspore::schema::MetaGraphT> m_graph {nullptr};
     std::shared_ptr<mindspore::Context> m_context {nullptr};
-    flatbuffers::FlatBufferBuilder m_builder;
-    std::shared_ptr<mindspore::Model> m_model {nullptr};
+    std::shared_ptr<ModelBufferRegistry> m_modelRegistry {nullptr};
+    std::shared_ptr<const ModelBuffer> m_modelBuffer {nullptr};
     sptr<Ashmem> m_cacheBuffer {nullptr};
-    std::vector<sptr<Ashmem>> m_inputAshmems;
-    std::vector<mindspore::MSTensor> m_inputs;
-    std::vector<sptr<Ashmem>> m_outputAshmems;
-    std::vector<mindspore::MSTensor> m_outputs;
+    std::shared_ptr<SharedBufferCache> m_bufferCache {nullptr};
     std::vector<std::vector<int64_t>> m_inputDims;
+    std::vector<std::vector<std::array<int64_t, 3>>> m_dimRangesConfig;
+    std::vector<std::vector<int64_t>> m_minInputDims;
+    std::vector<std::vector<int64_t>> m_optInputDims;
+    std::vector<std::vector<int64_t>> m_maxInputDims;
     bool m_isDynamicShape {false};
+    std::vector<std::unique_ptr<ExecutionContext>> m_idleContexts;
+    size_t m_contextNum {0};
+    size_t m_maxContextNum {1};
+    std::mutex m_contextMtx;
+    std::condition_variable m_contextCond;
+    // Reported in the log when the prepared model is destroyed
+    std::atomic<uint64_t> m_resizeSkippedCount {0};
+    std::atomic<uint64_t> m_resizedCount {0};
 };
 } // V2_0
 } // Nnrt
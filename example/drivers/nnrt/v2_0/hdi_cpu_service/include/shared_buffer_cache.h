@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_HDI_NNRT_V2_0_SHARED_BUFFER_CACHE_H
+#define OHOS_HDI_NNRT_V2_0_SHARED_BUFFER_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ashmem.h"
+#include "v2_0/nnrt_types.h"
+
+namespace OHOS {
+namespace HDI {
+namespace Nnrt {
+namespace V2_0 {
+// Keeps the shared buffers of IOTensors mapped between runs, so that running again on the same tensors does not
+// map and unmap them every time. The HDI stub duplicates the fd of every SharedBuffer it receives, and all Ashmem fds
+// refer to the same device file, so neither the fd nor its inode identifies a buffer. The buffers allocated by
+// NnrtDeviceService::AllocateBuffer are given unique region names instead, and only those are cached by their names.
+// Other buffers, such as tensors created from a user fd, are mapped for a single run. A mapping stays alive until the
+// buffer is released by NnrtDeviceService::ReleaseBuffer, or until it is evicted as the least recently used one. The
+// runs still using a dropped mapping keep it mapped until they finish.
+class SharedBufferCache {
+public:
+    SharedBufferCache() = default;
+    ~SharedBufferCache() = default;
+
+    // Name of a new buffer region, which makes the buffer cacheable.
+    static std::string CreateRegionName();
+    static bool GetRegionName(int fd, std::string& name);
+
+    // Takes the ownership of buffer.fd, it is either kept by the cache or closed.
+    sptr<Ashmem> Map(const SharedBuffer& buffer);
+    void Invalidate(const SharedBuffer& buffer);
+
+private:
+    struct Mapping {
+        sptr<Ashmem> ashmem {nullptr};
+        uint32_t bufferSize {0};
+        std::list<std::string>::iterator lruIter;
+    };
+
+    SharedBufferCache(const SharedBufferCache&) = delete;
+    SharedBufferCache& operator=(const SharedBufferCache&) = delete;
+
+    sptr<Ashmem> MapBuffer(const SharedBuffer& buffer) const;
+    void EvictMappings(size_t newBufferSize);
+    void EraseMapping(std::unordered_map<std::string, Mapping>::iterator iter);
+
+private:
+    static std::atomic<uint64_t> s_nextRegionId;
+
+    std::unordered_map<std::string, Mapping> m_mappings;
+    // Region names of m_mappings, the most recently used one first
+    std::list<std::string> m_lruKeys;
+    size_t m_mappedSize {0};
+    std::mutex m_mtx;
+};
+} // V2_0
+} // Nnrt
+} // HDI
+} // OHOS
+#endif // OHOS_HDI_NNRT_V2_0_SHARED_BUFFER_CACHE_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model_buffer_registry.h"
+
+#include <cstring>
+#include <string_view>
+
+#include "hdf_log.h"
+
+namespace OHOS {
+namespace HDI {
+namespace Nnrt {
+namespace V2_0 {
+std::shared_ptr<const ModelBuffer> ModelBufferRegistry::Register(const void* buffer, size_t length)
+{
+    if (buffer == nullptr || length == 0) {
+        HDF_LOGE("Register model buffer failed, buffer cannot be nullptr and length cannot be zero.");
+        return nullptr;
+    }
+
+    size_t hash = std::hash<std::string_view>()(std::string_view(static_cast<const char*>(buffer), length));
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto range = m_buffers.equal_range(hash);
+    for (auto iter = range.first; iter != range.second;) {
+        auto registered = iter->second.lock();
+        if (registered == nullptr) {
+            iter = m_buffers.erase(iter);
+            continue;
+        }
+
+        // Compare the content as well, different models may have the same hash.
+        if (registered->size() == length && memcmp(registered->data(), buffer, length) == 0) {
+            HDF_LOGI("Share the registered model buffer of %{public}zu bytes.", length);
+            return registered;
+        }
+        ++iter;
+    }
+
+    auto data = static_cast<const uint8_t*>(buffer);
+    std::shared_ptr<const ModelBuffer> modelBuffer = std::make_shared<const ModelBuffer>(data, data + length);
+    m_buffers.emplace(hash, modelBuffer);
+    return modelBuffer;
+}
+} // V2_0
+} // Nnrt
+} // HDI
+} // OHOS
@@ -131,12 +131,19 @@ int32_t NnrtDeviceService::PrepareModel(const Model& model, const ModelConfig& c
     }
 
     auto context = TransModelConfig(config);
-    sptr<PreparedModelService> service = new (std::nothrow) PreparedModelService(context);
+    sptr<PreparedModelService> service =
+        new (std::nothrow) PreparedModelService(context, m_bufferCache, m_modelRegistry);
     if (service == nullptr) {
         HDF_LOGE("Create new PreparedModelService instance failed.");
         return NNRT_ReturnCode::NNRT_OUT_OF_MEMORY;
     }
 
+    ret = service->SetDimRangesConfig(config.extensions);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        HDF_LOGE("Set dim ranges of the inputs failed.");
+        return ret;
+    }
+
     ret = service->Compile(graph);
     if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
         HDF_LOGE("Prepared model failed.");
@@ -180,7 +187,7 @@ int32_t NnrtDeviceService::PrepareModelFromModelCache(const std::vector<SharedBu
     }
 
     SharedBufferParser parser;
-    auto result = parser.Init(modelCache[0]);
+    auto result = parser.Init(modelCache[0], true);
     if (result != HDF_SUCCESS) {
         HDF_LOGE("Parse model buffer failed.");
         return NNRT_ReturnCode::NNRT_INVALID_BUFFER;
@@ -199,12 +206,19 @@ int32_t NnrtDeviceService::PrepareModelFromModelCache(const std::vector<SharedBu
     }
 
     auto context = TransModelConfig(config);
-    sptr<PreparedModelService> service = new (std::nothrow) PreparedModelService(context);
+    sptr<PreparedModelService> service =
+        new (std::nothrow) PreparedModelService(context, m_bufferCache, m_modelRegistry);
     if (service == nullptr) {
         HDF_LOGE("Create new instance PreparedModelService failed.");
         return NNRT_ReturnCode::NNRT_OUT_OF_MEMORY;
     }
 
+    ret = service->SetDimRangesConfig(config.extensions);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        HDF_LOGE("Set dim ranges of the inputs failed.");
+        return ret;
+    }
+
     void* modelBuffer = parser.GetBufferPtr();
     ret = service->Compile(modelBuffer, modelCache[0].dataSize);
     if (result != NNRT_ReturnCode::NNRT_SUCCESS) {
@@ -218,7 +232,9 @@ int32_t NnrtDeviceService::PrepareModelFromModelCache(const std::vector<SharedBu
 
 int32_t NnrtDeviceService::AllocateBuffer(uint32_t length, SharedBuffer& buffer)
 {
-    sptr<Ashmem> ashptr = Ashmem::CreateAshmem("allocateBuffer", length);
+    // The unique region name tells the buffer apart from the others when the client sends it back.
+    std::string name = SharedBufferCache::CreateRegionName();
+    sptr<Ashmem> ashptr = Ashmem::CreateAshmem(name.c_str(), length);
     if (ashptr == nullptr) {
         HDF_LOGE("Create shared memory failed.");
         return NNRT_ReturnCode::NNRT_OUT_OF_MEMORY;
@@ -234,12 +250,17 @@ int32_t NnrtDeviceService::AllocateBuffer(uint32_t length, SharedBuffer& buffer)
     buffer.offset = 0;
     buffer.dataSize = length;
 
-    m_ashmems[buffer.fd] = ashptr;
+    std::lock_guard<std::mutex> lock(m_ashmemsMtx);
+    m_ashmems[name] = ashptr;
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
 int32_t NnrtDeviceService::ReleaseBuffer(const SharedBuffer& buffer)
 {
+    std::string name;
+    bool hasName = (buffer.fd != -1) && SharedBufferCache::GetRegionName(buffer.fd, name);
+    m_bufferCache->Invalidate(buffer);
+
     // parser will close current fd.
     SharedBufferParser parser;
     auto ret = parser.Init(buffer);
@@ -248,11 +269,17 @@ int32_t NnrtDeviceService::ReleaseBuffer(const SharedBuffer& buffer)
         return NNRT_ReturnCode::NNRT_INVALID_BUFFER;
     }
 
-    for (auto& ash : m_ashmems) {
-        ash.second->UnmapAshmem();
-        ash.second->CloseAshmem();
+    if (!hasName) {
+        return NNRT_ReturnCode::NNRT_SUCCESS;
+    }
+
+    std::lock_guard<std::mutex> lock(m_ashmemsMtx);
+    auto iter = m_ashmems.find(name);
+    if (iter != m_ashmems.end()) {
+        iter->second->UnmapAshmem();
+        iter->second->CloseAshmem();
+        m_ashmems.erase(iter);
     }
-    m_ashmems.clear();
 
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
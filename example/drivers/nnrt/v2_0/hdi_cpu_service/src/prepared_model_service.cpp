@@ -15,36 +15,104 @@
 
 #include "prepared_model_service.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <thread>
+
 #include <hdf_base.h>
 #include "securec.h"
 #include "hdf_log.h"
 
-#include "shared_buffer_parser.h"
-
 namespace OHOS {
 namespace HDI {
 namespace Nnrt {
 namespace V2_0 {
-constexpr uint32_t MIN_DIM = 1;
-constexpr uint32_t MAX_DIM = 10;
-PreparedModelService::PreparedModelService(std::shared_ptr<mindspore::Context> context)
-    : m_context(context) {}
+namespace {
+constexpr int64_t MIN_DIM = 1;
+constexpr int64_t MAX_DIM = 10;
+constexpr size_t MAX_EXECUTION_CONTEXT_NUM = 4;
+constexpr size_t DIM_RANGE_MIN_INDEX = 0;
+constexpr size_t DIM_RANGE_OPT_INDEX = 1;
+constexpr size_t DIM_RANGE_MAX_INDEX = 2;
+
+std::vector<std::string> SplitString(const std::string& text, char delimiter)
+{
+    std::vector<std::string> items;
+    size_t begin = 0;
+    size_t end = text.find(delimiter);
+    while (end != std::string::npos) {
+        items.emplace_back(text.substr(begin, end - begin));
+        begin = end + 1;
+        end = text.find(delimiter, begin);
+    }
+    items.emplace_back(text.substr(begin));
+    return items;
+}
+
+bool ParseDimRange(const std::string& text, std::array<int64_t, 3>& range)
+{
+    auto values = SplitString(text, ':');
+    if (values.size() != 1 && values.size() != range.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i].empty() || values[i].find_first_not_of("0123456789") != std::string::npos ||
+            values[i].size() > std::numeric_limits<int32_t>::digits10) {
+            return false;
+        }
+        range[i] = std::stoll(values[i]);
+    }
+    if (values.size() == 1) {
+        range.fill(range[DIM_RANGE_MIN_INDEX]);
+    }
+    return true;
+}
+} // namespace
+
+PreparedModelService::PreparedModelService(std::shared_ptr<mindspore::Context> context,
+    std::shared_ptr<SharedBufferCache> bufferCache, std::shared_ptr<ModelBufferRegistry> modelRegistry)
+    : m_context(context), m_bufferCache(bufferCache), m_modelRegistry(modelRegistry) {}
 
 PreparedModelService::~PreparedModelService()
 {
+    if (m_isDynamicShape) {
+        HDF_LOGI("Resize skipped %{public}llu times, resized %{public}llu times.",
+            static_cast<unsigned long long>(m_resizeSkippedCount), static_cast<unsigned long long>(m_resizedCount));
+    }
+
     if (m_cacheBuffer != nullptr) {
         m_cacheBuffer->CloseAshmem();
     }
 
-    for (auto& inputAsh : m_inputAshmems) {
-        inputAsh->UnmapAshmem();
-        inputAsh->CloseAshmem();
-    }
+    // Input and output buffers are shared with m_bufferCache, they are unmapped when the last reference is dropped.
+    m_idleContexts.clear();
+}
 
-    for (auto& outputAsh : m_outputAshmems) {
-        outputAsh->UnmapAshmem();
-        outputAsh->CloseAshmem();
+NNRT_ReturnCode PreparedModelService::SetDimRangesConfig(const std::map<std::string, std::vector<int8_t>>& extensions)
+{
+    auto iter = extensions.find(EXTENSION_KEY_INPUT_DIM_RANGES);
+    if (iter == extensions.end()) {
+        return NNRT_ReturnCode::NNRT_SUCCESS;
+    }
+
+    std::string config(iter->second.begin(), iter->second.end());
+    config = config.substr(0, config.find('\0'));
+    m_dimRangesConfig.clear();
+    for (const auto& inputConfig : SplitString(config, ';')) {
+        std::vector<std::array<int64_t, 3>> inputRanges;
+        for (const auto& dimConfig : SplitString(inputConfig, ',')) {
+            std::array<int64_t, 3> range {};
+            if (!ParseDimRange(dimConfig, range)) {
+                HDF_LOGE("Dim range \"%{public}s\" is invalid.", dimConfig.c_str());
+                m_dimRangesConfig.clear();
+                return NNRT_ReturnCode::NNRT_INVALID_PARAMETER;
+            }
+            inputRanges.emplace_back(range);
+        }
+        m_dimRangesConfig.emplace_back(std::move(inputRanges));
     }
+    return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
 int32_t PreparedModelService::ExportModelCache(std::vector<SharedBuffer>& modelCache)
@@ -63,8 +131,13 @@ int32_t PreparedModelService::ExportModelCache(std::vector<SharedBuffer>& modelC
         return HDF_SUCCESS;
     }
 
-    auto size = m_builder.GetSize();
-    auto buffer = m_builder.GetBufferPointer();
+    if (m_modelBuffer == nullptr) {
+        HDF_LOGE("Model has not been prepared yet.");
+        return NNRT_ReturnCode::NNRT_INVALID_MODEL;
+    }
+
+    auto size = m_modelBuffer->size();
+    auto buffer = m_modelBuffer->data();
     const char* name = m_graph != nullptr ? m_graph->name.c_str() : "CacheModel";
     sptr<Ashmem> cache = Ashmem::CreateAshmem(name, size);
     if (cache == nullptr) {
@@ -96,33 +169,48 @@ int32_t PreparedModelService::ExportModelCache(std::vector<SharedBuffer>& modelC
 int32_t PreparedModelService::Run(const std::vector<IOTensor>& inputs, const std::vector<IOTensor>& outputs,
     std::vector<std::vector<int32_t>>& outputsDims)
 {
-    auto ret = SetInputs(inputs);
+    std::unique_ptr<ExecutionContext> context {nullptr};
+    auto ret = AcquireExecutionContext(context);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        HDF_LOGE("Acquire execution context failed.");
+        return ret;
+    }
+
+    ret = RunWithContext(*context, inputs, outputs, outputsDims);
+    ResetInputAndOutput(*context);
+    ReleaseExecutionContext(std::move(context));
+    return ret;
+}
+
+NNRT_ReturnCode PreparedModelService::RunWithContext(ExecutionContext& context, const std::vector<IOTensor>& inputs,
+    const std::vector<IOTensor>& outputs, std::vector<std::vector<int32_t>>& outputsDims)
+{
+    auto ret = SetInputs(context, inputs);
     if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
         HDF_LOGE("Inputs tensor is invalid.");
         return ret;
     }
 
     if (!m_isDynamicShape) {
-        ret = SetOutputs(outputs);
-        if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
-            HDF_LOGE("Output tensor is invalid.");
-            ResetInputAndOutput();
-            return ret;
-        }
+        ret = SetOutputs(context, outputs);
+    } else {
+        ret = BindDynamicOutputs(context, outputs);
+    }
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        HDF_LOGE("Output tensor is invalid.");
+        return ret;
     }
 
-    auto msRet = m_model->Predict(m_inputs, &m_outputs);
+    auto msRet = context.model->Predict(context.inputs, &context.outputs);
     if (msRet != mindspore::kSuccess) {
         HDF_LOGE("Run model failed.");
-        ResetInputAndOutput();
         return NNRT_ReturnCode::NNRT_FAILED;
     }
 
     bool isOutputBufferEnough {false};
-    ret = UpdateOutput(outputs, outputsDims, isOutputBufferEnough);
+    ret = UpdateOutput(context, outputs, outputsDims, isOutputBufferEnough);
     if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
         HDF_LOGE("Update output dimension or data failed.");
-        ResetInputAndOutput();
         return ret;
     }
 
@@ -131,73 +219,206 @@ int32_t PreparedModelService::Run(const std::vector<IOTensor>& inputs, const std
         return NNRT_ReturnCode::NNRT_INSUFFICIENT_BUFFER;
     }
 
-    ResetInputAndOutput();
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
+NNRT_ReturnCode PreparedModelService::CreateExecutionContext(std::unique_ptr<ExecutionContext>& context)
+{
+    if (m_modelBuffer == nullptr) {
+        HDF_LOGE("Model has not been prepared yet.");
+        return NNRT_ReturnCode::NNRT_INVALID_MODEL;
+    }
+
+    context = std::make_unique<ExecutionContext>();
+    context->model = std::make_shared<mindspore::Model>();
+    mindspore::Status msRet =
+        context->model->Build(m_modelBuffer->data(), m_modelBuffer->size(), mindspore::kMindIR, m_context);
+    if (msRet != mindspore::kSuccess) {
+        HDF_LOGE("Build model of execution context failed.");
+        context.reset();
+        return NNRT_ReturnCode::NNRT_INVALID_MODEL;
+    }
+
+    auto ret = GetMSInputsAndOutputs(*context);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        HDF_LOGE("Model without inputs or outputs is invalid.");
+        context.reset();
+        return ret;
+    }
+
+    ret = ResizeToOptDims(*context);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        context.reset();
+        return ret;
+    }
+    return NNRT_ReturnCode::NNRT_SUCCESS;
+}
+
+NNRT_ReturnCode PreparedModelService::AcquireExecutionContext(std::unique_ptr<ExecutionContext>& context)
+{
+    std::unique_lock<std::mutex> lock(m_contextMtx);
+    m_contextCond.wait(lock, [this] { return !m_idleContexts.empty() || (m_contextNum < m_maxContextNum); });
+    if (!m_idleContexts.empty()) {
+        context = std::move(m_idleContexts.back());
+        m_idleContexts.pop_back();
+        return NNRT_ReturnCode::NNRT_SUCCESS;
+    }
+
+    // Every context holds a copy of the model in MindSpore Lite, they are created only when runs overlap.
+    ++m_contextNum;
+    lock.unlock();
+    auto ret = CreateExecutionContext(context);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        lock.lock();
+        --m_contextNum;
+        m_contextCond.notify_one();
+    }
+    return ret;
+}
+
+void PreparedModelService::InitExecutionContexts(std::unique_ptr<ExecutionContext> context)
+{
+    std::lock_guard<std::mutex> lock(m_contextMtx);
+    size_t coreNum = std::thread::hardware_concurrency();
+    m_maxContextNum = std::max<size_t>(1, std::min(coreNum, MAX_EXECUTION_CONTEXT_NUM));
+    m_idleContexts.emplace_back(std::move(context));
+    m_contextNum = 1;
+}
+
+void PreparedModelService::ReleaseExecutionContext(std::unique_ptr<ExecutionContext> context)
+{
+    std::lock_guard<std::mutex> lock(m_contextMtx);
+    m_idleContexts.emplace_back(std::move(context));
+    m_contextCond.notify_one();
+}
+
 int32_t PreparedModelService::GetInputDimRanges(std::vector<std::vector<uint32_t>>& minInputDims,
     std::vector<std::vector<uint32_t>>& maxInputDims)
 {
-    if (m_inputDims.empty()) {
+    if (m_minInputDims.empty()) {
         HDF_LOGE("Model has not been prepared yet.");
         return NNRT_ReturnCode::NNRT_INVALID_MODEL;
     }
 
     minInputDims.clear();
     maxInputDims.clear();
+    for (size_t i = 0; i < m_minInputDims.size(); ++i) {
+        minInputDims.emplace_back(m_minInputDims[i].begin(), m_minInputDims[i].end());
+        maxInputDims.emplace_back(m_maxInputDims[i].begin(), m_maxInputDims[i].end());
+    }
+
+    return NNRT_ReturnCode::NNRT_SUCCESS;
+}
+
+NNRT_ReturnCode PreparedModelService::InitDimRanges()
+{
+    if (!m_dimRangesConfig.empty() && (m_dimRangesConfig.size() != m_inputDims.size())) {
+        HDF_LOGE("Dim ranges of %{public}zu inputs are given, but the model has %{public}zu inputs.",
+            m_dimRangesConfig.size(), m_inputDims.size());
+        return NNRT_ReturnCode::NNRT_INVALID_PARAMETER;
+    }
+
+    m_minInputDims.clear();
+    m_optInputDims.clear();
+    m_maxInputDims.clear();
+    for (size_t i = 0; i < m_inputDims.size(); ++i) {
+        const auto& inputShape = m_inputDims[i];
+        if (!m_dimRangesConfig.empty() && (m_dimRangesConfig[i].size() != inputShape.size())) {
+            HDF_LOGE("Rank of the dim ranges of input %{public}zu dose not match that of model.", i);
+            return NNRT_ReturnCode::NNRT_INVALID_PARAMETER;
+        }
 
-    for (auto inputShape : m_inputDims) {
-        std::vector<uint32_t> minInputShape;
-        std::vector<uint32_t> maxInputShape;
-        for (auto dim : inputShape) {
-            if (dim != DYNAMIC_SHAPE_FLAG) { // Min and max are same if the dimension is fixed.
-                if (dim <= 0) {
-                    HDF_LOGE("Dimesion value is invalid.");
-                    return NNRT_ReturnCode::NNRT_INVALID_SHAPE;
-                }
-                minInputShape.push_back(static_cast<uint32_t>(dim));
-                maxInputShape.push_back(static_cast<uint32_t>(dim));
-            } else {                        // Dimension range is [1, 10].
-                minInputShape.push_back(MIN_DIM);
-                maxInputShape.push_back(MAX_DIM);
+        std::vector<int64_t> minInputShape;
+        std::vector<int64_t> optInputShape;
+        std::vector<int64_t> maxInputShape;
+        for (size_t j = 0; j < inputShape.size(); ++j) {
+            int64_t dim = inputShape[j];
+            if (dim != DYNAMIC_SHAPE_FLAG && dim <= 0) {
+                HDF_LOGE("Dimesion value is invalid.");
+                return NNRT_ReturnCode::NNRT_INVALID_SHAPE;
             }
+
+            // Without the config, min and max are same if the dimension is fixed, otherwise the range is [1, 10].
+            std::array<int64_t, 3> range {dim, dim, dim};
+            if (!m_dimRangesConfig.empty()) {
+                range = m_dimRangesConfig[i][j];
+            } else if (dim == DYNAMIC_SHAPE_FLAG) {
+                range = {MIN_DIM, MIN_DIM, MAX_DIM};
+            }
+
+            bool isFixedDimValid = (dim == DYNAMIC_SHAPE_FLAG) ||
+                ((range[DIM_RANGE_MIN_INDEX] == dim) && (range[DIM_RANGE_MAX_INDEX] == dim));
+            if (!isFixedDimValid || (range[DIM_RANGE_MIN_INDEX] < MIN_DIM) ||
+                (range[DIM_RANGE_MIN_INDEX] > range[DIM_RANGE_OPT_INDEX]) ||
+                (range[DIM_RANGE_OPT_INDEX] > range[DIM_RANGE_MAX_INDEX])) {
+                HDF_LOGE("Dim range of dimension %{public}zu of input %{public}zu is invalid.", j, i);
+                return NNRT_ReturnCode::NNRT_INVALID_PARAMETER;
+            }
+            minInputShape.emplace_back(range[DIM_RANGE_MIN_INDEX]);
+            optInputShape.emplace_back(range[DIM_RANGE_OPT_INDEX]);
+            maxInputShape.emplace_back(range[DIM_RANGE_MAX_INDEX]);
         }
-        minInputDims.push_back(std::move(minInputShape));
-        maxInputDims.push_back(std::move(maxInputShape));
+        m_minInputDims.emplace_back(std::move(minInputShape));
+        m_optInputDims.emplace_back(std::move(optInputShape));
+        m_maxInputDims.emplace_back(std::move(maxInputShape));
     }
 
+    // Only the configured opt shapes are planned in advance.
+    if (m_dimRangesConfig.empty()) {
+        m_optInputDims.clear();
+    }
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
-NNRT_ReturnCode PreparedModelService::UpdateOutput(const std::vector<IOTensor>& outputs,
+NNRT_ReturnCode PreparedModelService::ResizeToOptDims(ExecutionContext& context)
+{
+    if (!m_isDynamicShape || m_optInputDims.empty()) {
+        return NNRT_ReturnCode::NNRT_SUCCESS;
+    }
+
+    // Plans the memory of the context for the opt shapes, the runs of these shapes need no resize.
+    auto msRet = context.model->Resize(context.inputs, m_optInputDims);
+    if (msRet != mindspore::kSuccess) {
+        HDF_LOGE("Resize to the opt shapes failed.");
+        return NNRT_ReturnCode::NNRT_FAILED;
+    }
+    auto ret = GetMSInputsAndOutputs(context);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        HDF_LOGE("Get ms inputs or outputs failed after resize.");
+        return ret;
+    }
+    context.resizedDims = m_optInputDims;
+    return NNRT_ReturnCode::NNRT_SUCCESS;
+}
+
+NNRT_ReturnCode PreparedModelService::UpdateOutput(ExecutionContext& context, const std::vector<IOTensor>& outputs,
     std::vector<std::vector<int32_t>>& outputsDims, bool& isOutputBufferEnough)
 {
     isOutputBufferEnough = true;
-    size_t outputSize = m_outputs.size();
+    size_t outputSize = context.outputs.size();
     for (size_t i = 0; i < outputSize; i++) {
-        auto& msOutput = m_outputs[i];
+        auto& msOutput = context.outputs[i];
         auto& output = outputs[i];
 
         auto msShape = msOutput.Shape();
         outputsDims.emplace_back(msShape.begin(), msShape.end());
 
         auto dataSize = msOutput.DataSize();
-        if (dataSize > output.data.bufferSize) {
+        if (dataSize > output.data.dataSize) {
             HDF_LOGE("Output buffer is not enough. actual size %{public}zu, buffer size %{public}u",
-                dataSize, output.data.bufferSize);
+                dataSize, output.data.dataSize);
             isOutputBufferEnough = false;
         }
 
-        if (isOutputBufferEnough && m_isDynamicShape) {
+        if (isOutputBufferEnough && m_isDynamicShape && !context.isOutputBound[i]) {
             auto msData = msOutput.MutableData();
-            SharedBufferParser parser;
-            auto ret = parser.Init(output.data);
-            if (ret != HDF_SUCCESS) {
+            sptr<Ashmem> ashptr = ParseBuffer(output.data);
+            if (ashptr == nullptr) {
                 HDF_LOGE("Parse %zu th output data failed.", i);
                 return NNRT_ReturnCode::NNRT_INVALID_BUFFER;
             }
 
-            auto data = parser.GetBufferPtr();
+            auto data = const_cast<void*>(ashptr->ReadFromAshmem(output.data.dataSize, output.data.offset));
             auto memRet = memcpy_s(data, dataSize, msData, dataSize);
             if (memRet != EOK) {
                 HDF_LOGE("Copy output memory failed.");
@@ -209,17 +430,36 @@ NNRT_ReturnCode PreparedModelService::UpdateOutput(const std::vector<IOTensor>&
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
-void PreparedModelService::ResetInputAndOutput()
+void PreparedModelService::ResetInputAndOutput(ExecutionContext& context)
 {
-    for (auto& msInput : m_inputs) {
+    for (auto& msInput : context.inputs) {
         msInput.SetData(nullptr);
     }
 
-    if (!m_isDynamicShape) {
-        for (auto& msOutput : m_outputs) {
-            msOutput.SetData(nullptr);
+    for (size_t i = 0; i < context.outputs.size(); ++i) {
+        bool isOutputBound = (i < context.isOutputBound.size()) && context.isOutputBound[i];
+        if (!m_isDynamicShape || isOutputBound) {
+            context.outputs[i].SetData(nullptr);
         }
     }
+    context.isOutputBound.clear();
+    context.inputAshmems.clear();
+    context.outputAshmems.clear();
+}
+
+NNRT_ReturnCode PreparedModelService::RegisterModelBuffer(const void* modelBuffer, size_t length)
+{
+    if (m_modelRegistry == nullptr) {
+        HDF_LOGE("Model buffer registry is not set.");
+        return NNRT_ReturnCode::NNRT_FAILED;
+    }
+
+    m_modelBuffer = m_modelRegistry->Register(modelBuffer, length);
+    if (m_modelBuffer == nullptr) {
+        HDF_LOGE("Register model buffer failed.");
+        return NNRT_ReturnCode::NNRT_OUT_OF_MEMORY;
+    }
+    return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
 NNRT_ReturnCode PreparedModelService::Compile(std::shared_ptr<mindspore::schema::MetaGraphT> graph)
@@ -236,33 +476,44 @@ NNRT_ReturnCode PreparedModelService::Compile(std::shared_ptr<mindspore::schema:
             break;
         }
     }
-    auto offset = mindspore::schema::MetaGraph::Pack(m_builder, graph.get());
-    m_builder.Finish(offset);
-    mindspore::schema::FinishMetaGraphBuffer(m_builder, offset);
-    auto modelSize = m_builder.GetSize();
-    uint8_t* modelBuffer = m_builder.GetBufferPointer();
+    flatbuffers::FlatBufferBuilder builder;
+    auto offset = mindspore::schema::MetaGraph::Pack(builder, graph.get());
+    builder.Finish(offset);
+    mindspore::schema::FinishMetaGraphBuffer(builder, offset);
+    auto modelSize = builder.GetSize();
+    uint8_t* modelBuffer = builder.GetBufferPointer();
     if (modelBuffer == nullptr) {
         HDF_LOGE("Model is invalid.");
         return NNRT_ReturnCode::NNRT_INVALID_MODEL;
     }
 
-    m_model = std::make_shared<mindspore::Model>();
-    mindspore::Status msRet = m_model->Build(modelBuffer, modelSize, mindspore::kMindIR, m_context);
-    if (msRet != mindspore::kSuccess) {
-        HDF_LOGE("Prepare model failed, please make sure model is validate.");
-        return NNRT_ReturnCode::NNRT_INVALID_MODEL;
+    // The buffer is kept for the execution contexts created later, shared with the models of identical content.
+    auto ret = RegisterModelBuffer(modelBuffer, modelSize);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        return ret;
     }
-
-    auto ret = GetMSInputsAndOutputs();
+    std::unique_ptr<ExecutionContext> context {nullptr};
+    ret = CreateExecutionContext(context);
     if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
-        HDF_LOGE("Model without inputs or outputs is invalid.");
+        HDF_LOGE("Prepare model failed, please make sure model is validate.");
         return ret;
     }
 
-    for (auto input : m_inputs) {
+    for (auto input : context->inputs) {
         m_inputDims.push_back(input.Shape());
     }
 
+    ret = InitDimRanges();
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        HDF_LOGE("Dim ranges of the inputs are invalid.");
+        return ret;
+    }
+    ret = ResizeToOptDims(*context);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        return ret;
+    }
+
+    InitExecutionContexts(std::move(context));
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
@@ -273,20 +524,22 @@ NNRT_ReturnCode PreparedModelService::Compile(const void* modelBuffer, size_t le
         return NNRT_ReturnCode::NNRT_INVALID_BUFFER;
     }
 
-    m_model = std::make_shared<mindspore::Model>();
-    mindspore::Status msRet = m_model->Build(modelBuffer, length, mindspore::kMindIR, m_context);
-    if (msRet != mindspore::kSuccess) {
-        HDF_LOGE("Prepare model from cache failed, please make sure model cache is valid.");
-        return NNRT_ReturnCode::NNRT_INVALID_MODEL_CACHE;
+    // The cache buffer is released by the caller, keep a copy for the execution contexts created later.
+    auto ret = RegisterModelBuffer(modelBuffer, length);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        return ret;
     }
 
-    auto ret = GetMSInputsAndOutputs();
-    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
-        HDF_LOGE("Model without inputs or outputs is invalid.");
+    std::unique_ptr<ExecutionContext> context {nullptr};
+    ret = CreateExecutionContext(context);
+    if (ret == NNRT_ReturnCode::NNRT_INVALID_MODEL) {
+        HDF_LOGE("Prepare model from cache failed, please make sure model cache is valid.");
+        return NNRT_ReturnCode::NNRT_INVALID_MODEL_CACHE;
+    } else if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
         return ret;
     }
 
-    for (auto input : m_inputs) {
+    for (auto input : context->inputs) {
         auto shapes = input.Shape();
         if (std::find(shapes.begin(), shapes.end(), DYNAMIC_SHAPE_FLAG) != shapes.end()) {
             m_isDynamicShape = true;
@@ -294,32 +547,39 @@ NNRT_ReturnCode PreparedModelService::Compile(const void* modelBuffer, size_t le
         }
     }
 
-    for (auto input : m_inputs) {
+    for (auto input : context->inputs) {
         m_inputDims.push_back(input.Shape());
     }
 
+    ret = InitDimRanges();
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        HDF_LOGE("Dim ranges of the inputs are invalid.");
+        return ret;
+    }
+    ret = ResizeToOptDims(*context);
+    if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
+        return ret;
+    }
+
+    InitExecutionContexts(std::move(context));
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
-NNRT_ReturnCode PreparedModelService::SetInputs(const std::vector<IOTensor>& inputs)
+NNRT_ReturnCode PreparedModelService::SetInputs(ExecutionContext& context, const std::vector<IOTensor>& inputs)
 {
-    if (inputs.size() != m_inputs.size()) {
-        HDF_LOGE("inputs size is invalid. expect: %zu, actual: %zu", m_inputs.size(), inputs.size());
+    if (inputs.size() != context.inputs.size()) {
+        HDF_LOGE("inputs size is invalid. expect: %zu, actual: %zu", context.inputs.size(), inputs.size());
         return NNRT_ReturnCode::NNRT_INVALID_INPUT;
     }
-    for (auto& ash : m_inputAshmems) {
-        ash->UnmapAshmem();
-        ash->CloseAshmem();
-    }
-    m_inputAshmems.clear();
+    context.inputAshmems.clear();
 
     NNRT_ReturnCode ret;
-    size_t inputSize = m_inputs.size();
+    size_t inputSize = context.inputs.size();
     std::vector<std::vector<int64_t>> tmpAllDims;
     for (size_t i = 0; i < inputSize; i++) {
         auto& input = inputs[i];
-        auto& msInput = m_inputs[i];
-        ret = CompareTensor(input, msInput);
+        auto& msInput = context.inputs[i];
+        ret = CompareTensor(input, msInput, i);
         if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
             HDF_LOGE("Input tensor %{public}zu is not match that of model. Please check the input tensor.", i);
             return ret;
@@ -327,51 +587,54 @@ NNRT_ReturnCode PreparedModelService::SetInputs(const std::vector<IOTensor>& inp
         tmpAllDims.emplace_back(input.dimensions.begin(), input.dimensions.end());
     }
 
-    if (m_isDynamicShape) {
-        auto msRet = m_model->Resize(m_inputs, tmpAllDims);
+    // The context keeps the shapes of its last resize, running again with the same shapes needs no re-planning.
+    if (m_isDynamicShape && (tmpAllDims == context.resizedDims)) {
+        ++m_resizeSkippedCount;
+    } else if (m_isDynamicShape) {
+        context.resizedDims.clear();
+        auto msRet = context.model->Resize(context.inputs, tmpAllDims);
         if (msRet != mindspore::kSuccess) {
             HDF_LOGE("Resize for dynamic inputs failed.");
             return NNRT_ReturnCode::NNRT_FAILED;
         }
-        ret = GetMSInputsAndOutputs();
+        ret = GetMSInputsAndOutputs(context);
         if (ret != NNRT_ReturnCode::NNRT_SUCCESS) {
             HDF_LOGE("Get ms inputs or outputs failed after resize.");
             return ret;
         }
+        context.resizedDims = std::move(tmpAllDims);
+        ++m_resizedCount;
     }
 
     for (size_t i = 0; i < inputSize; i++) {
         auto& input = inputs[i];
-        auto& msInput = m_inputs[i];
+        auto& msInput = context.inputs[i];
         sptr<Ashmem> ashptr = ParseBuffer(input.data);
         if (ashptr == nullptr) {
             HDF_LOGE("Parse %zuth input data failed.", i);
             return NNRT_ReturnCode::NNRT_INVALID_PARAMETER;
         }
 
-        auto data = const_cast<void*>(ashptr->ReadFromAshmem(input.data.dataSize, 0));
+        auto data = const_cast<void*>(ashptr->ReadFromAshmem(input.data.dataSize, input.data.offset));
         msInput.SetData(data);
-        m_inputAshmems.emplace_back(ashptr);
+        context.inputAshmems.emplace_back(ashptr);
     }
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
-NNRT_ReturnCode PreparedModelService::SetOutputs(const std::vector<IOTensor>& outputs)
+NNRT_ReturnCode PreparedModelService::SetOutputs(ExecutionContext& context, const std::vector<IOTensor>& outputs)
 {
-    HDF_LOGI("Start Set outputs, m_outputs size=%zu", m_outputs.size());
-    if (outputs.size() != m_outputs.size()) {
-        HDF_LOGE("outputs size is invalid. expect: %{public}zu, actual: %{public}zu", m_outputs.size(), outputs.size());
+    HDF_LOGI("Start Set outputs, outputs size=%zu", context.outputs.size());
+    if (outputs.size() != context.outputs.size()) {
+        HDF_LOGE("outputs size is invalid. expect: %{public}zu, actual: %{public}zu", context.outputs.size(),
+            outputs.size());
         return NNRT_ReturnCode::NNRT_INVALID_OUTPUT;
     }
-    for (auto ash : m_outputAshmems) {
-        ash->UnmapAshmem();
-        ash->CloseAshmem();
-    }
-    m_outputAshmems.clear();
+    context.outputAshmems.clear();
 
-    for (size_t i = 0; i < m_outputs.size(); i++) {
+    for (size_t i = 0; i < context.outputs.size(); i++) {
         auto& output = outputs[i];
-        auto& msOutput = m_outputs[i];
+        auto& msOutput = context.outputs[i];
 
         sptr<Ashmem> ashptr = ParseBuffer(output.data);
         if (ashptr == nullptr) {
@@ -379,31 +642,71 @@ NNRT_ReturnCode PreparedModelService::SetOutputs(const std::vector<IOTensor>& ou
             return NNRT_ReturnCode::NNRT_INVALID_PARAMETER;
         }
 
-        auto data = const_cast<void*>(ashptr->ReadFromAshmem(output.data.dataSize, 0));
+        auto data = const_cast<void*>(ashptr->ReadFromAshmem(output.data.dataSize, output.data.offset));
         msOutput.SetAllocator(nullptr);
         msOutput.SetData(data);
-        m_outputAshmems.emplace_back(ashptr);
+        context.outputAshmems.emplace_back(ashptr);
     }
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
-NNRT_ReturnCode PreparedModelService::GetMSInputsAndOutputs()
+NNRT_ReturnCode PreparedModelService::BindDynamicOutputs(ExecutionContext& context,
+    const std::vector<IOTensor>& outputs)
 {
-    m_inputs = m_model->GetInputs();
-    if (m_inputs.empty()) {
+    if (outputs.size() != context.outputs.size()) {
+        HDF_LOGE("outputs size is invalid. expect: %{public}zu, actual: %{public}zu", context.outputs.size(),
+            outputs.size());
+        return NNRT_ReturnCode::NNRT_INVALID_OUTPUT;
+    }
+    context.outputAshmems.clear();
+    context.isOutputBound.assign(context.outputs.size(), false);
+
+    // Outputs whose shapes are inferred by the resize are written to the client buffers directly if they fit, the
+    // others are allocated by MindSpore Lite and copied back by UpdateOutput.
+    for (size_t i = 0; i < context.outputs.size(); i++) {
+        auto& output = outputs[i];
+        auto& msOutput = context.outputs[i];
+        auto msShape = msOutput.Shape();
+        if (std::any_of(msShape.begin(), msShape.end(), [](int64_t dim) { return dim < 0; }) ||
+            (msOutput.DataSize() > output.data.dataSize)) {
+            continue;
+        }
+
+        sptr<Ashmem> ashptr = ParseBuffer(output.data);
+        if (ashptr == nullptr) {
+            HDF_LOGE("Parse %{public}zu th output data failed.", i);
+            return NNRT_ReturnCode::NNRT_INVALID_PARAMETER;
+        }
+
+        auto data = const_cast<void*>(ashptr->ReadFromAshmem(output.data.dataSize, output.data.offset));
+        if (data == nullptr) {
+            continue;
+        }
+        msOutput.SetData(data);
+        context.outputAshmems.emplace_back(ashptr);
+        context.isOutputBound[i] = true;
+    }
+    return NNRT_ReturnCode::NNRT_SUCCESS;
+}
+
+NNRT_ReturnCode PreparedModelService::GetMSInputsAndOutputs(ExecutionContext& context)
+{
+    context.inputs = context.model->GetInputs();
+    if (context.inputs.empty()) {
         HDF_LOGE("Get inputs failed.");
         return NNRT_ReturnCode::NNRT_FAILED;
     }
 
-    m_outputs = m_model->GetOutputs();
-    if (m_outputs.empty()) {
+    context.outputs = context.model->GetOutputs();
+    if (context.outputs.empty()) {
         HDF_LOGE("Get outputs failed.");
         return NNRT_ReturnCode::NNRT_FAILED;
     }
     return NNRT_ReturnCode::NNRT_SUCCESS;
 }
 
-NNRT_ReturnCode PreparedModelService::CompareTensor(const IOTensor& tensor, const mindspore::MSTensor& msTensor)
+NNRT_ReturnCode PreparedModelService::CompareTensor(const IOTensor& tensor, const mindspore::MSTensor& msTensor,
+    size_t index)
 {
     auto dataType = static_cast<DataType>(msTensor.DataType());
     if (tensor.dataType != dataType) {
@@ -417,20 +720,22 @@ NNRT_ReturnCode PreparedModelService::CompareTensor(const IOTensor& tensor, cons
         return NNRT_ReturnCode::NNRT_INVALID_FORMAT;
     }
 
-    if (tensor.dimensions.size() != msTensor.Shape().size()) {
+    // The shape of msTensor is fixed by the last resize, compare with the shape of the model instead.
+    const auto& modelDims = m_inputDims[index];
+    if (tensor.dimensions.size() != modelDims.size()) {
         HDF_LOGE("Rank of tensor dose not match that of model.");
         return NNRT_ReturnCode::NNRT_INVALID_SHAPE;
     }
 
     for (size_t i = 0; i < tensor.dimensions.size(); i++) {
-        int modelDim = static_cast<int>(msTensor.Shape()[i]);
+        int modelDim = static_cast<int>(modelDims[i]);
         int tensorDim = tensor.dimensions[i];
         if (modelDim != DYNAMIC_SHAPE_FLAG) {
             if (tensorDim != modelDim) {
                 HDF_LOGE("Dimension %{public}zu of tensor dose not match that of model.", i);
                 return NNRT_ReturnCode::NNRT_INVALID_SHAPE;
             }
-        } else if (tensorDim < static_cast<int>(MIN_DIM) || tensorDim > static_cast<int>(MAX_DIM)) {
+        } else if (tensorDim < m_minInputDims[index][i] || tensorDim > m_maxInputDims[index][i]) {
                 HDF_LOGE("Dimension %{public}zu of tensor is out of dynamic range.", i);
                 return NNRT_ReturnCode::NNRT_OUT_OF_DIMENTION_RANGES;
         }
@@ -446,15 +751,13 @@ sptr<Ashmem> PreparedModelService::ParseBuffer(const SharedBuffer& buffer)
         return nullptr;
     }
 
-    HDF_LOGW("NNRT buffer fd=%{public}d, length=%{public}u", buffer.fd, buffer.dataSize);
-
-    sptr<Ashmem> ashptr = new (std::nothrow) Ashmem(buffer.fd, buffer.bufferSize);
-    if (ashptr == nullptr) {
-        HDF_LOGE("Create shared memory failed.");
+    if (m_bufferCache == nullptr) {
+        HDF_LOGE("Shared buffer cache is not set.");
         return nullptr;
     }
 
-    if (!ashptr->MapReadAndWriteAshmem()) {
+    sptr<Ashmem> ashptr = m_bufferCache->Map(buffer);
+    if (ashptr == nullptr) {
         HDF_LOGE("Map buffer fd to address failed.");
         return nullptr;
     }
@@ -462,8 +765,6 @@ sptr<Ashmem> PreparedModelService::ParseBuffer(const SharedBuffer& buffer)
     const void* data = ashptr->ReadFromAshmem(buffer.dataSize, buffer.offset);
     if (data == nullptr) {
         HDF_LOGE("Get data address failed.");
-        ashptr->UnmapAshmem();
-        ashptr->CloseAshmem();
         return nullptr;
     }
     return ashptr;
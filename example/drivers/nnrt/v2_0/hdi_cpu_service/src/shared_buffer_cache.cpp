@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shared_buffer_cache.h"
+
+#include <cstring>
+#include <linux/ashmem.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "hdf_log.h"
+
+namespace OHOS {
+namespace HDI {
+namespace Nnrt {
+namespace V2_0 {
+namespace {
+const int INVALID_FD = -1;
+const char REGION_NAME_PREFIX[] = "nnrt_buffer_";
+// Every cached mapping keeps an fd open, so both the number and the total size of the mappings are bounded.
+const size_t MAX_CACHED_MAPPINGS = 64;
+const size_t MAX_CACHED_SIZE = 256 * 1024 * 1024;
+}
+
+std::atomic<uint64_t> SharedBufferCache::s_nextRegionId {0};
+
+std::string SharedBufferCache::CreateRegionName()
+{
+    return REGION_NAME_PREFIX + std::to_string(s_nextRegionId++);
+}
+
+bool SharedBufferCache::GetRegionName(int fd, std::string& name)
+{
+    char regionName[ASHMEM_NAME_LEN] = {0};
+    if (ioctl(fd, ASHMEM_GET_NAME, regionName) != 0) {
+        HDF_LOGE("Get region name of buffer fd %{public}d failed.", fd);
+        return false;
+    }
+    regionName[ASHMEM_NAME_LEN - 1] = '\0';
+    name = regionName;
+    return true;
+}
+
+sptr<Ashmem> SharedBufferCache::MapBuffer(const SharedBuffer& buffer) const
+{
+    sptr<Ashmem> ashptr = new (std::nothrow) Ashmem(buffer.fd, buffer.bufferSize);
+    if (ashptr == nullptr) {
+        HDF_LOGE("Create shared memory failed.");
+        close(buffer.fd);
+        return nullptr;
+    }
+
+    if (!ashptr->MapReadAndWriteAshmem()) {
+        HDF_LOGE("Map buffer fd to address failed.");
+        ashptr->CloseAshmem();
+        return nullptr;
+    }
+    return ashptr;
+}
+
+void SharedBufferCache::EraseMapping(std::unordered_map<std::string, Mapping>::iterator iter)
+{
+    // Called with m_mtx locked. A run in progress may still use the mapping, the Ashmem holding it is unmapped and
+    // closed when the last reference to it is dropped.
+    m_mappedSize -= iter->second.bufferSize;
+    m_lruKeys.erase(iter->second.lruIter);
+    m_mappings.erase(iter);
+}
+
+void SharedBufferCache::EvictMappings(size_t newBufferSize)
+{
+    // Called with m_mtx locked.
+    while (!m_lruKeys.empty() &&
+        ((m_mappings.size() >= MAX_CACHED_MAPPINGS) || (m_mappedSize + newBufferSize > MAX_CACHED_SIZE))) {
+        EraseMapping(m_mappings.find(m_lruKeys.back()));
+    }
+}
+
+sptr<Ashmem> SharedBufferCache::Map(const SharedBuffer& buffer)
+{
+    if (buffer.fd == INVALID_FD) {
+        HDF_LOGE("Invalid buffer fd, it cannot be %{public}d.", INVALID_FD);
+        return nullptr;
+    }
+
+    std::string name;
+    if (!GetRegionName(buffer.fd, name) || (name.compare(0, strlen(REGION_NAME_PREFIX), REGION_NAME_PREFIX) != 0)) {
+        // Not allocated by the service, the buffer cannot be told apart from the others.
+        return MapBuffer(buffer);
+    }
+
+    // Tensors sub-allocated from one shared memory send the size up to their own end, a mapping of the same shared
+    // memory which is at least as large covers them as well.
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto iter = m_mappings.find(name);
+    if ((iter != m_mappings.end()) && (iter->second.bufferSize >= buffer.bufferSize)) {
+        // The cached mapping keeps its own fd of the same shared memory, the duplicated one is no longer needed.
+        if (iter->second.ashmem->GetAshmemFd() != buffer.fd) {
+            close(buffer.fd);
+        }
+        m_lruKeys.splice(m_lruKeys.begin(), m_lruKeys, iter->second.lruIter);
+        return iter->second.ashmem;
+    }
+    if (iter != m_mappings.end()) {
+        EraseMapping(iter);
+    }
+
+    sptr<Ashmem> ashptr = MapBuffer(buffer);
+    if (ashptr == nullptr) {
+        return nullptr;
+    }
+
+    EvictMappings(buffer.bufferSize);
+    m_lruKeys.emplace_front(name);
+    m_mappings.emplace(name, Mapping {ashptr, buffer.bufferSize, m_lruKeys.begin()});
+    m_mappedSize += buffer.bufferSize;
+    return ashptr;
+}
+
+void SharedBufferCache::Invalidate(const SharedBuffer& buffer)
+{
+    if (buffer.fd == INVALID_FD) {
+        return;
+    }
+
+    std::string name;
+    if (!GetRegionName(buffer.fd, name)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto iter = m_mappings.find(name);
+    if (iter != m_mappings.end()) {
+        EraseMapping(iter);
+    }
+}
+} // V2_0
+} // Nnrt
+} // HDI
+} // OHOS
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "build_scheduler.h"
+
+#include <algorithm>
+
+#include "common/log.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace {
+constexpr size_t MAX_BUILD_WORKER_NUM = 4;
+constexpr size_t MAX_PENDING_BUILD_NUM = 256;
+}
+
+BuildScheduler& BuildScheduler::GetInstance()
+{
+    static BuildScheduler instance;
+    return instance;
+}
+
+BuildScheduler::BuildScheduler()
+{
+    size_t coreNum = std::thread::hardware_concurrency();
+    m_maxWorkerNum = std::max<size_t>(1, std::min(coreNum, MAX_BUILD_WORKER_NUM));
+}
+
+BuildScheduler::~BuildScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_isStopped = true;
+    }
+    m_taskCond.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+OH_NN_ReturnCode BuildScheduler::Submit(Task&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (m_isStopped) {
+            LOGE("[BuildScheduler] Submit failed, the scheduler has been stopped.");
+            return OH_NN_OPERATION_FORBIDDEN;
+        }
+        if (m_tasks.size() >= MAX_PENDING_BUILD_NUM) {
+            LOGE("[BuildScheduler] Submit failed, too many pending builds: %{public}zu.", m_tasks.size());
+            return OH_NN_OPERATION_FORBIDDEN;
+        }
+        m_tasks.emplace_back(std::move(task));
+
+        if ((m_idleWorkerNum < m_tasks.size()) && (m_workers.size() < m_maxWorkerNum)) {
+            m_workers.emplace_back(&BuildScheduler::WorkerLoop, this);
+        }
+    }
+    m_taskCond.notify_one();
+    return OH_NN_SUCCESS;
+}
+
+void BuildScheduler::WorkerLoop()
+{
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            ++m_idleWorkerNum;
+            m_taskCond.wait(lock, [this] { return m_isStopped || !m_tasks.empty(); });
+            --m_idleWorkerNum;
+            // Pending builds are still drained when stopping, so that every callback is called exactly once.
+            if (m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_CORE_BUILD_SCHEDULER_H
+#define NEURAL_NETWORK_CORE_BUILD_SCHEDULER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "interfaces/kits/c/neural_network_runtime/neural_network_runtime_type.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+// Runs the asynchronous builds of all compilations and the cache saving after them. At most one build per CPU core,
+// and no more than MAX_BUILD_WORKER_NUM, runs at the same time, workers are started when tasks are submitted.
+class BuildScheduler {
+public:
+    using Task = std::function<void()>;
+
+    static BuildScheduler& GetInstance();
+
+    OH_NN_ReturnCode Submit(Task&& task);
+
+private:
+    BuildScheduler();
+    ~BuildScheduler();
+    BuildScheduler(const BuildScheduler&) = delete;
+    BuildScheduler& operator=(const BuildScheduler&) = delete;
+
+    void WorkerLoop();
+
+private:
+    size_t m_maxWorkerNum {1};
+    size_t m_idleWorkerNum {0};
+    bool m_isStopped {false};
+    std::deque<Task> m_tasks;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mtx;
+    std::condition_variable m_taskCond;
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_CORE_BUILD_SCHEDULER_H
@@ -19,6 +19,8 @@
 #include <vector>
 #include <utility>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
 #include <unordered_map>
 
 #include "compiler.h"
@@ -26,6 +28,9 @@
 
 namespace OHOS {
 namespace NeuralNetworkRuntime {
+class ExecutorPool;
+class RequestBatcher;
+
 struct Compilation {
     size_t backendID {0};
     void* nnModel {nullptr};
@@ -38,9 +43,20 @@ struct Compilation {
     OH_NN_PerformanceMode performance {OH_NN_PERFORMANCE_NONE};
     bool enableFp16 {false};
     Compiler* compiler {nullptr};
+    ExecutorPool* executorPool {nullptr};
+    std::shared_ptr<RequestBatcher> requestBatcher {nullptr};
     std::vector<std::shared_ptr<void>> options;
     std::unordered_map<std::string, std::vector<char>> configs;
 
+    // State of OH_NNCompilation_Build and OH_NNCompilation_BuildAsync. OH_NNCompilation_Destroy waits for the build in
+    // progress, and leaves the destruction to the cache saving task or the last OH_NNCompilation_ReleaseExecutor if it
+    // is called before the cache is saved or while executors are acquired.
+    std::mutex buildMtx;
+    std::condition_variable buildCond;
+    bool isBuilding {false};
+    bool isSavingCache {false};
+    bool isDestroyPending {false};
+
     ~Compilation()
     {
         options.clear();
@@ -46,6 +46,14 @@ public:
 
     virtual OH_NN_ReturnCode SetExtensionConfig(const std::unordered_map<std::string, std::vector<char>>& configs) = 0;
     virtual OH_NN_ReturnCode SetOptions(const std::vector<std::shared_ptr<void>>& options) = 0;
+
+    // With the cache saving deferred, Build leaves the cache to be saved by SaveToCacheFile when it reports a pending
+    // cache. Compilers which do not support it save the cache in Build.
+    virtual void SetCacheSaveDeferred(bool isDeferred) {}
+    virtual bool IsCacheSavePending() const
+    {
+        return false;
+    }
 };
 } // namespace NeuralNetworkRuntime
 } // namespace OHOS
@@ -41,11 +41,17 @@ struct ModelConfig {
     std::string isProfiling;
     std::string cachePath;
     std::map<std::string, std::string> opLayout;
+    std::map<std::string, std::vector<int8_t>> extensions;
+    // Alignment of the constant tensors packed for the device, 0 means the default.
+    size_t constTensorAlignment {0};
 };
 
 struct Buffer {
     void* data;
     size_t length;
+    // Set when data is a region of a file mapping, so the device can share the file instead of copying data.
+    int fd {-1};
+    size_t offset {0};
 };
 
 struct QuantParam {
@@ -25,6 +25,8 @@
 
 namespace OHOS {
 namespace NeuralNetworkRuntime {
+class RequestBatcher;
+
 class Executor {
 public:
     Executor() = default;
@@ -54,7 +56,50 @@ public:
                                       size_t outputSize,
                                       int32_t timeout,
                                       void* userData) = 0;
+    virtual OH_NN_ReturnCode RunBatch(NN_Tensor* inputTensors[],
+                                      size_t inputSize,
+                                      NN_Tensor* outputTensors[],
+                                      size_t outputSize,
+                                      size_t batchSize) = 0;
+    virtual OH_NN_ReturnCode BindIOTensors(NN_Tensor* inputTensors[],
+                                           size_t inputSize,
+                                           NN_Tensor* outputTensors[],
+                                           size_t outputSize,
+                                           size_t* bindingId) = 0;
+    virtual OH_NN_ReturnCode RunSyncWithBinding(size_t bindingId) = 0;
+    virtual OH_NN_ReturnCode UnbindIOTensors(size_t bindingId) = 0;
+    virtual OH_NN_ReturnCode SetOutputAutoGrowth(bool enable) = 0;
     virtual size_t GetBackendID() = 0;
+
+    // The APIs of older versions cast the executor to NNExecutor, executors of other types are rejected by them.
+    virtual bool IsCompatibleWithOldAPIs() const
+    {
+        return true;
+    }
+
+    // Takes the output shapes of a run issued by another executor of the compilation on behalf of this one, e.g. in a
+    // batch merged by the request batcher, so that GetOutputShape returns them.
+    virtual OH_NN_ReturnCode SyncOutputShapes(NN_Tensor* outputTensors[], size_t outputSize)
+    {
+        return OH_NN_SUCCESS;
+    }
+
+    // Clears the state left by the user of the executor, e.g. the callbacks and the bound tensors, so that the executor
+    // pool hands it to the next user as a new one.
+    virtual void Reset() {}
+
+    // Synchronous runs go through the request batcher of the compilation if dynamic batching is enabled.
+    void SetRequestBatcher(std::shared_ptr<RequestBatcher> requestBatcher)
+    {
+        m_requestBatcher = requestBatcher;
+    }
+    std::shared_ptr<RequestBatcher> GetRequestBatcher() const
+    {
+        return m_requestBatcher;
+    }
+
+private:
+    std::shared_ptr<RequestBatcher> m_requestBatcher {nullptr};
 };
 }  // namespace NeuralNetworkRuntime
 }  // namespace OHOS
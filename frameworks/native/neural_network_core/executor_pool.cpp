@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "executor_pool.h"
+
+#include "backend_manager.h"
+#include "request_batcher.h"
+#include "common/log.h"
+#include "common/utils.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace {
+constexpr size_t MAX_POOLED_EXECUTOR_NUM = 16;
+}
+
+ExecutorPool::ExecutorPool(Compilation* compilation) : m_compilation(compilation) {}
+
+ExecutorPool::~ExecutorPool()
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (m_executors.size() != m_idleExecutors.size()) {
+        LOGW("[ExecutorPool] %{public}zu executors are not released before destroying the pool.",
+            m_executors.size() - m_idleExecutors.size());
+    }
+
+    const BackendManager& backendManager = BackendManager::GetInstance();
+    std::shared_ptr<Backend> backend = backendManager.GetBackend(m_compilation->backendID);
+    if (backend == nullptr) {
+        LOGE("[ExecutorPool] Failed to get backend %{public}zu, executors are leaked.", m_compilation->backendID);
+        return;
+    }
+
+    for (auto& item : m_executors) {
+        DestroyPooledExecutor(backend, *(item.second));
+    }
+    m_executors.clear();
+    m_idleExecutors.clear();
+}
+
+OH_NN_ReturnCode ExecutorPool::Acquire(PooledExecutor** pooledExecutor)
+{
+    if (pooledExecutor == nullptr) {
+        LOGE("[ExecutorPool] Acquire failed, pooledExecutor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (!m_idleExecutors.empty()) {
+        *pooledExecutor = m_idleExecutors.back();
+        m_idleExecutors.pop_back();
+        return OH_NN_SUCCESS;
+    }
+
+    if (m_executors.size() >= MAX_POOLED_EXECUTOR_NUM) {
+        LOGE("[ExecutorPool] Acquire failed, all the %{public}zu executors of the pool are in use.",
+            MAX_POOLED_EXECUTOR_NUM);
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    const BackendManager& backendManager = BackendManager::GetInstance();
+    std::shared_ptr<Backend> backend = backendManager.GetBackend(m_compilation->backendID);
+    if (backend == nullptr) {
+        LOGE("[ExecutorPool] Acquire failed, failed to get backend %{public}zu.", m_compilation->backendID);
+        return OH_NN_NULL_PTR;
+    }
+
+    std::unique_ptr<PooledExecutor> newExecutor = CreateUniquePtr<PooledExecutor>();
+    if (newExecutor == nullptr) {
+        LOGE("[ExecutorPool] Acquire failed, failed to create pooled executor.");
+        return OH_NN_MEMORY_ERROR;
+    }
+
+    OH_NN_ReturnCode ret = CreatePooledExecutor(backend, *newExecutor);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[ExecutorPool] Acquire failed, failed to create executor.");
+        return ret;
+    }
+
+    *pooledExecutor = newExecutor.get();
+    m_executors.emplace(newExecutor->executor, std::move(newExecutor));
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode ExecutorPool::Release(Executor* executor)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto iter = m_executors.find(executor);
+    if (iter == m_executors.end()) {
+        LOGE("[ExecutorPool] Release failed, the executor is not acquired from this compilation.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    PooledExecutor* pooledExecutor = iter->second.get();
+    for (auto idleExecutor : m_idleExecutors) {
+        if (idleExecutor == pooledExecutor) {
+            LOGE("[ExecutorPool] Release failed, the executor has been released before.");
+            return OH_NN_INVALID_PARAMETER;
+        }
+    }
+
+    // The callbacks, bindings and buffers set by this user must not be seen by the next one.
+    executor->Reset();
+    m_idleExecutors.emplace_back(pooledExecutor);
+    return OH_NN_SUCCESS;
+}
+
+size_t ExecutorPool::GetAcquiredNum()
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    return m_executors.size() - m_idleExecutors.size();
+}
+
+OH_NN_ReturnCode ExecutorPool::CreatePooledExecutor(std::shared_ptr<Backend> backend,
+    PooledExecutor& pooledExecutor) const
+{
+    pooledExecutor.executor = backend->CreateExecutor(m_compilation);
+    if (pooledExecutor.executor == nullptr) {
+        LOGE("[ExecutorPool] CreatePooledExecutor failed, failed to create executor.");
+        return OH_NN_FAILED;
+    }
+    pooledExecutor.executor->SetRequestBatcher(m_compilation->requestBatcher);
+    if (m_compilation->requestBatcher != nullptr) {
+        m_compilation->requestBatcher->AddExecutor();
+    }
+
+    OH_NN_ReturnCode ret = BindTensors(backend, pooledExecutor);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[ExecutorPool] CreatePooledExecutor failed, failed to bind tensors to executor.");
+        DestroyPooledExecutor(backend, pooledExecutor);
+        return ret;
+    }
+
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode ExecutorPool::BindTensors(std::shared_ptr<Backend> backend, PooledExecutor& pooledExecutor) const
+{
+    Executor* executor = pooledExecutor.executor;
+    size_t inputNum = executor->GetInputNum();
+    size_t outputNum = executor->GetOutputNum();
+
+    // Tensors of dynamic shape cannot be allocated in advance, the caller has to create them for every run.
+    std::vector<TensorDesc*> tensorDescs;
+    bool isDynamicShape = false;
+    for (size_t i = 0; i < inputNum + outputNum; ++i) {
+        NN_TensorDesc* desc = (i < inputNum) ?
+            executor->CreateInputTensorDesc(i) : executor->CreateOutputTensorDesc(i - inputNum);
+        if (desc == nullptr) {
+            LOGE("[ExecutorPool] BindTensors failed, failed to create tensor desc %{public}zu.", i);
+            for (auto tensorDesc : tensorDescs) {
+                delete tensorDesc;
+            }
+            return OH_NN_NULL_PTR;
+        }
+        TensorDesc* tensorDesc = reinterpret_cast<TensorDesc*>(desc);
+        size_t byteSize {0};
+        if (tensorDesc->GetByteSize(&byteSize) != OH_NN_SUCCESS || byteSize == 0) {
+            isDynamicShape = true;
+        }
+        tensorDescs.emplace_back(tensorDesc);
+    }
+
+    OH_NN_ReturnCode ret {OH_NN_SUCCESS};
+    for (size_t i = 0; (i < tensorDescs.size()) && !isDynamicShape; ++i) {
+        Tensor* tensor = backend->CreateTensor(tensorDescs[i]);
+        if (tensor == nullptr) {
+            LOGE("[ExecutorPool] BindTensors failed, failed to create tensor %{public}zu.", i);
+            ret = OH_NN_MEMORY_ERROR;
+            break;
+        }
+        ret = tensor->CreateData();
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("[ExecutorPool] BindTensors failed, failed to create data of tensor %{public}zu.", i);
+            backend->DestroyTensor(tensor);
+            break;
+        }
+
+        auto& tensors = (i < inputNum) ? pooledExecutor.inputTensors : pooledExecutor.outputTensors;
+        tensors.emplace_back(reinterpret_cast<NN_Tensor*>(tensor));
+    }
+
+    for (auto tensorDesc : tensorDescs) {
+        delete tensorDesc;
+    }
+    if (isDynamicShape) {
+        LOGI("[ExecutorPool] Model has dynamic inputs or outputs, tensors are not bound to the executor.");
+    }
+    return ret;
+}
+
+void ExecutorPool::DestroyPooledExecutor(std::shared_ptr<Backend> backend, PooledExecutor& pooledExecutor) const
+{
+    for (auto tensor : pooledExecutor.inputTensors) {
+        backend->DestroyTensor(reinterpret_cast<Tensor*>(tensor));
+    }
+    pooledExecutor.inputTensors.clear();
+
+    for (auto tensor : pooledExecutor.outputTensors) {
+        backend->DestroyTensor(reinterpret_cast<Tensor*>(tensor));
+    }
+    pooledExecutor.outputTensors.clear();
+
+    if (pooledExecutor.executor != nullptr) {
+        backend->DestroyExecutor(pooledExecutor.executor);
+        pooledExecutor.executor = nullptr;
+        if (m_compilation->requestBatcher != nullptr) {
+            m_compilation->requestBatcher->RemoveExecutor();
+        }
+    }
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_CORE_EXECUTOR_POOL_H
+#define NEURAL_NETWORK_CORE_EXECUTOR_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "backend.h"
+#include "compilation.h"
+#include "executor.h"
+#include "tensor.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+struct PooledExecutor {
+    Executor* executor {nullptr};
+    std::vector<NN_Tensor*> inputTensors;
+    std::vector<NN_Tensor*> outputTensors;
+};
+
+// Executors owned by a built compilation. The executors and their input/output tensors are created on the first
+// acquisition and handed out again after being released, so the steady state inference allocates nothing. The pool
+// holds at most MAX_POOLED_EXECUTOR_NUM executors, and a released executor is reset before it is handed out again.
+class ExecutorPool {
+public:
+    explicit ExecutorPool(Compilation* compilation);
+    ~ExecutorPool();
+
+    OH_NN_ReturnCode Acquire(PooledExecutor** pooledExecutor);
+    OH_NN_ReturnCode Release(Executor* executor);
+    size_t GetAcquiredNum();
+
+private:
+    ExecutorPool(const ExecutorPool&) = delete;
+    ExecutorPool& operator=(const ExecutorPool&) = delete;
+
+    OH_NN_ReturnCode CreatePooledExecutor(std::shared_ptr<Backend> backend, PooledExecutor& pooledExecutor) const;
+    OH_NN_ReturnCode BindTensors(std::shared_ptr<Backend> backend, PooledExecutor& pooledExecutor) const;
+    void DestroyPooledExecutor(std::shared_ptr<Backend> backend, PooledExecutor& pooledExecutor) const;
+
+private:
+    Compilation* m_compilation {nullptr};
+    std::unordered_map<Executor*, std::unique_ptr<PooledExecutor>> m_executors;
+    std::vector<PooledExecutor*> m_idleExecutors;
+    std::mutex m_mtx;
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_CORE_EXECUTOR_POOL_H
@@ -22,7 +22,10 @@
 #include "executor.h"
 #include "tensor.h"
 #include "compilation.h"
+#include "executor_pool.h"
+#include "request_batcher.h"
 #include "backend_manager.h"
+#include "build_scheduler.h"
 
 using namespace OHOS::NeuralNetworkRuntime;
 #define NNRT_API __attribute__((visibility("default")))
@@ -241,8 +244,8 @@ NNRT_API OH_NN_ReturnCode OH_NNCompilation_ImportCacheFromBuffer(OH_NNCompilatio
     }
 
     Compilation* compilationImpr = reinterpret_cast<Compilation*>(compilation);
-    compilationImpr->offlineModelBuffer.first = const_cast<void*>(buffer);
-    compilationImpr->offlineModelBuffer.second = modelSize;
+    compilationImpr->cacheBuffer.first = const_cast<void*>(buffer);
+    compilationImpr->cacheBuffer.second = modelSize;
 
     return OH_NN_SUCCESS;
 }
@@ -470,15 +473,8 @@ OH_NN_ReturnCode SetCompilationOptions(Compilation* compilation)
     return OH_NN_SUCCESS;
 }
 
-NNRT_API OH_NN_ReturnCode OH_NNCompilation_Build(OH_NNCompilation *compilation)
+OH_NN_ReturnCode BuildCompilation(Compilation* compilationImpr, bool isCacheSaveDeferred)
 {
-    if (compilation == nullptr) {
-        LOGE("OH_NNCompilation_Build failed, compilation is nullptr.");
-        return OH_NN_INVALID_PARAMETER;
-    }
-
-    Compilation* compilationImpr = reinterpret_cast<Compilation*>(compilation);
-
     if (((compilationImpr->nnModel != nullptr) && (compilationImpr->offlineModelPath != nullptr)) ||
         ((compilationImpr->nnModel != nullptr) &&
          ((compilationImpr->offlineModelBuffer.first != nullptr) ||
@@ -490,6 +486,12 @@ NNRT_API OH_NN_ReturnCode OH_NNCompilation_Build(OH_NNCompilation *compilation)
         return OH_NN_INVALID_PARAMETER;
     }
 
+    if ((compilationImpr->cacheBuffer.first != nullptr) &&
+        ((compilationImpr->offlineModelPath != nullptr) || (compilationImpr->offlineModelBuffer.first != nullptr))) {
+        LOGE("OH_NNCompilation_Build failed, cache buffer cannot be used with offline model.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
     OH_NN_ReturnCode ret = OH_NN_SUCCESS;
     if (compilationImpr->compiler != nullptr) {
         LOGE("OH_NNCompilation_Build failed, the compiler in compilation is not nullptr, "
@@ -510,6 +512,7 @@ NNRT_API OH_NN_ReturnCode OH_NNCompilation_Build(OH_NNCompilation *compilation)
         LOGE("OH_NNCompilation_Build failed, faile to create compiler.");
         return ret;
     }
+    compilationImpr->compiler->SetCacheSaveDeferred(isCacheSaveDeferred);
 
     bool isBuild = compilationImpr->compiler->IsBuild();
     if (isBuild) {
@@ -517,28 +520,77 @@ NNRT_API OH_NN_ReturnCode OH_NNCompilation_Build(OH_NNCompilation *compilation)
         return OH_NN_OPERATION_FORBIDDEN;
     }
 
-    ret = compilationImpr->compiler->Build();
+    ret = RequestBatcher::Create(compilationImpr->configs, compilationImpr->requestBatcher);
     if (ret != OH_NN_SUCCESS) {
-        LOGE("OH_NNCompilation_Build failed, faile to build compilation.");
+        LOGE("OH_NNCompilation_Build failed, fail to create request batcher.");
         return ret;
     }
 
+    ret = OH_NN_FAILED;
+    if (compilationImpr->cacheBuffer.first != nullptr) {
+        ret = compilationImpr->compiler->RestoreFromCacheBuffer(compilationImpr->cacheBuffer.first,
+                                                                 compilationImpr->cacheBuffer.second);
+        if ((ret != OH_NN_SUCCESS) && ((compilationImpr->nnModel == nullptr) || (ret == OH_NN_OPERATION_FORBIDDEN))) {
+            LOGE("OH_NNCompilation_Build failed, fail to restore compilation from cache buffer.");
+            return ret;
+        }
+    }
+
+    // Build the model online if there is no cache buffer or the cache buffer is out of date.
+    if (ret != OH_NN_SUCCESS) {
+        ret = compilationImpr->compiler->Build();
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("OH_NNCompilation_Build failed, faile to build compilation.");
+            return ret;
+        }
+    }
+
+    compilationImpr->executorPool = new (std::nothrow) ExecutorPool(compilationImpr);
+    if (compilationImpr->executorPool == nullptr) {
+        LOGW("OH_NNCompilation_Build, failed to create executor pool, OH_NNCompilation_AcquireExecutor is disabled.");
+    }
+
     return OH_NN_SUCCESS;
 }
 
-NNRT_API void OH_NNCompilation_Destroy(OH_NNCompilation **compilation)
+void FinishBuilding(Compilation* compilationImpr)
+{
+    {
+        std::lock_guard<std::mutex> lock(compilationImpr->buildMtx);
+        compilationImpr->isBuilding = false;
+    }
+    compilationImpr->buildCond.notify_all();
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNCompilation_Build(OH_NNCompilation *compilation)
 {
     if (compilation == nullptr) {
-        LOGE("OH_NNCompilation_Destroy failed, compilation is nullptr.");
-        return;
+        LOGE("OH_NNCompilation_Build failed, compilation is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
     }
 
-    if (*compilation == nullptr) {
-        LOGE("OH_NNCompilation_Destroy failed, compilation is nullptr.");
-        return;
+    Compilation* compilationImpr = reinterpret_cast<Compilation*>(compilation);
+    {
+        std::lock_guard<std::mutex> lock(compilationImpr->buildMtx);
+        if (compilationImpr->isBuilding) {
+            LOGE("OH_NNCompilation_Build failed, compilation is being built.");
+            return OH_NN_OPERATION_FORBIDDEN;
+        }
+        compilationImpr->isBuilding = true;
+    }
+
+    OH_NN_ReturnCode ret = BuildCompilation(compilationImpr, false);
+    FinishBuilding(compilationImpr);
+    return ret;
+}
+
+void DestroyCompilation(Compilation* compilationImpr)
+{
+    if (compilationImpr->executorPool != nullptr) {
+        delete compilationImpr->executorPool;
+        compilationImpr->executorPool = nullptr;
     }
 
-    Compilation* compilationImpr = reinterpret_cast<Compilation*>(*compilation);
     if (compilationImpr->compiler != nullptr) {
         const BackendManager& manager = BackendManager::GetInstance();
         std::shared_ptr<Backend> backend = manager.GetBackend(compilationImpr->backendID);
@@ -555,6 +607,118 @@ NNRT_API void OH_NNCompilation_Destroy(OH_NNCompilation **compilation)
     }
 
     delete compilationImpr;
+}
+
+// The caller holds buildMtx. The compilation cannot be destroyed while the cache is being saved or its executors are
+// acquired, the destruction is left to the last of them.
+bool IsCompilationInUse(Compilation* compilationImpr)
+{
+    return compilationImpr->isSavingCache ||
+        ((compilationImpr->executorPool != nullptr) && (compilationImpr->executorPool->GetAcquiredNum() != 0));
+}
+
+void SaveCacheInBackground(Compilation* compilationImpr)
+{
+    auto saveCache = [compilationImpr]() {
+        OH_NN_ReturnCode ret = compilationImpr->compiler->SaveToCacheFile();
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("OH_NNCompilation_BuildAsync, build success, but fail to save cache to file.");
+        }
+
+        bool isDestroyPending {false};
+        {
+            std::lock_guard<std::mutex> lock(compilationImpr->buildMtx);
+            compilationImpr->isSavingCache = false;
+            isDestroyPending = compilationImpr->isDestroyPending && !IsCompilationInUse(compilationImpr);
+        }
+        // OH_NNCompilation_Destroy was called while the cache was being saved, and left the destruction to us.
+        if (isDestroyPending) {
+            DestroyCompilation(compilationImpr);
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(compilationImpr->buildMtx);
+        compilationImpr->isSavingCache = true;
+    }
+    if (BuildScheduler::GetInstance().Submit(saveCache) != OH_NN_SUCCESS) {
+        saveCache();
+    }
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNCompilation_BuildAsync(OH_NNCompilation *compilation,
+                                                      NN_OnBuildDone onBuildDone,
+                                                      void *userData)
+{
+    if (compilation == nullptr) {
+        LOGE("OH_NNCompilation_BuildAsync failed, compilation is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (onBuildDone == nullptr) {
+        LOGE("OH_NNCompilation_BuildAsync failed, onBuildDone is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    Compilation* compilationImpr = reinterpret_cast<Compilation*>(compilation);
+    {
+        std::lock_guard<std::mutex> lock(compilationImpr->buildMtx);
+        if (compilationImpr->isBuilding || (compilationImpr->compiler != nullptr)) {
+            LOGE("OH_NNCompilation_BuildAsync failed, compilation is being built or has been built.");
+            return OH_NN_OPERATION_FORBIDDEN;
+        }
+        compilationImpr->isBuilding = true;
+    }
+
+    auto build = [compilationImpr, onBuildDone, userData]() {
+        // The cache is saved after the callback, the compilation can be used as soon as the model is prepared.
+        OH_NN_ReturnCode ret = BuildCompilation(compilationImpr, true);
+        bool isCacheSavePending = (ret == OH_NN_SUCCESS) && compilationImpr->compiler->IsCacheSavePending();
+        if (isCacheSavePending) {
+            SaveCacheInBackground(compilationImpr);
+        }
+        // The compilation may be destroyed as soon as the build is finished, don't touch it any more.
+        FinishBuilding(compilationImpr);
+        onBuildDone(userData, ret);
+    };
+
+    OH_NN_ReturnCode ret = BuildScheduler::GetInstance().Submit(build);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("OH_NNCompilation_BuildAsync failed, fail to submit the build.");
+        FinishBuilding(compilationImpr);
+    }
+    return ret;
+}
+
+NNRT_API void OH_NNCompilation_Destroy(OH_NNCompilation **compilation)
+{
+    if (compilation == nullptr) {
+        LOGE("OH_NNCompilation_Destroy failed, compilation is nullptr.");
+        return;
+    }
+
+    if (*compilation == nullptr) {
+        LOGE("OH_NNCompilation_Destroy failed, compilation is nullptr.");
+        return;
+    }
+
+    Compilation* compilationImpr = reinterpret_cast<Compilation*>(*compilation);
+    {
+        // The compilation cannot be released under a build in progress, wait for the build to finish.
+        std::unique_lock<std::mutex> lock(compilationImpr->buildMtx);
+        if (compilationImpr->isBuilding) {
+            LOGW("OH_NNCompilation_Destroy, compilation is being built, wait for the build to finish.");
+            compilationImpr->buildCond.wait(lock, [compilationImpr] { return !compilationImpr->isBuilding; });
+        }
+        if (IsCompilationInUse(compilationImpr)) {
+            LOGI("OH_NNCompilation_Destroy, compilation is in use, it is destroyed when it is no longer used.");
+            compilationImpr->isDestroyPending = true;
+            *compilation = nullptr;
+            return;
+        }
+    }
+
+    DestroyCompilation(compilationImpr);
     *compilation = nullptr;
 }
 
@@ -999,6 +1163,10 @@ NNRT_API OH_NNExecutor *OH_NNExecutor_Construct(OH_NNCompilation *compilation)
         LOGE("OH_NNExecutor_Construct failed, failed to create executor.");
         return nullptr;
     }
+    executorImpl->SetRequestBatcher(compilationImpl->requestBatcher);
+    if (compilationImpl->requestBatcher != nullptr) {
+        compilationImpl->requestBatcher->AddExecutor();
+    }
 
     OH_NNExecutor *executor = reinterpret_cast<OH_NNExecutor *>(executorImpl);
     return executor;
@@ -1024,12 +1192,101 @@ NNRT_API void OH_NNExecutor_Destroy(OH_NNExecutor **executor)
         return;
     }
 
+    std::shared_ptr<RequestBatcher> requestBatcher = executorImpl->GetRequestBatcher();
     auto returnCode = backend->DestroyExecutor(executorImpl);
     if (returnCode != OH_NN_SUCCESS) {
         LOGE("OH_NNExecutor_Destroy failed, failed to destroy executor.");
         return;
     }
+    if (requestBatcher != nullptr) {
+        requestBatcher->RemoveExecutor();
+    }
+    *executor = nullptr;
+}
+
+NNRT_API OH_NNExecutor *OH_NNCompilation_AcquireExecutor(OH_NNCompilation *compilation,
+                                                         NN_Tensor ***inputTensor,
+                                                         size_t *inputCount,
+                                                         NN_Tensor ***outputTensor,
+                                                         size_t *outputCount)
+{
+    if (compilation == nullptr) {
+        LOGE("OH_NNCompilation_AcquireExecutor failed, compilation is nullptr.");
+        return nullptr;
+    }
+    if ((inputTensor == nullptr) || (inputCount == nullptr)) {
+        LOGE("OH_NNCompilation_AcquireExecutor failed, inputTensor or inputCount is nullptr.");
+        return nullptr;
+    }
+    if ((outputTensor == nullptr) || (outputCount == nullptr)) {
+        LOGE("OH_NNCompilation_AcquireExecutor failed, outputTensor or outputCount is nullptr.");
+        return nullptr;
+    }
+
+    Compilation *compilationImpl = reinterpret_cast<Compilation *>(compilation);
+    if (compilationImpl->executorPool == nullptr) {
+        LOGE("OH_NNCompilation_AcquireExecutor failed, compilation has not been built successfully.");
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(compilationImpl->buildMtx);
+        if (compilationImpl->isDestroyPending) {
+            LOGE("OH_NNCompilation_AcquireExecutor failed, compilation has been destroyed.");
+            return nullptr;
+        }
+    }
+
+    PooledExecutor* pooledExecutor = nullptr;
+    OH_NN_ReturnCode ret = compilationImpl->executorPool->Acquire(&pooledExecutor);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("OH_NNCompilation_AcquireExecutor failed, failed to acquire executor from pool.");
+        return nullptr;
+    }
+
+    *inputTensor = pooledExecutor->inputTensors.empty() ? nullptr : pooledExecutor->inputTensors.data();
+    *inputCount = pooledExecutor->inputTensors.size();
+    *outputTensor = pooledExecutor->outputTensors.empty() ? nullptr : pooledExecutor->outputTensors.data();
+    *outputCount = pooledExecutor->outputTensors.size();
+    return reinterpret_cast<OH_NNExecutor *>(pooledExecutor->executor);
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNCompilation_ReleaseExecutor(OH_NNCompilation *compilation, OH_NNExecutor **executor)
+{
+    if (compilation == nullptr) {
+        LOGE("OH_NNCompilation_ReleaseExecutor failed, compilation is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if ((executor == nullptr) || (*executor == nullptr)) {
+        LOGE("OH_NNCompilation_ReleaseExecutor failed, executor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    Compilation *compilationImpl = reinterpret_cast<Compilation *>(compilation);
+    if (compilationImpl->executorPool == nullptr) {
+        LOGE("OH_NNCompilation_ReleaseExecutor failed, compilation has not been built successfully.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    Executor *executorImpl = reinterpret_cast<Executor *>(*executor);
+    bool isDestroyPending {false};
+    {
+        // Released under buildMtx, so that OH_NNCompilation_Destroy either sees the executor acquired and leaves the
+        // destruction to us, or sees it released.
+        std::lock_guard<std::mutex> lock(compilationImpl->buildMtx);
+        OH_NN_ReturnCode ret = compilationImpl->executorPool->Release(executorImpl);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("OH_NNCompilation_ReleaseExecutor failed, failed to release executor to pool.");
+            return ret;
+        }
+        isDestroyPending = compilationImpl->isDestroyPending && !IsCompilationInUse(compilationImpl);
+    }
     *executor = nullptr;
+
+    // OH_NNCompilation_Destroy was called while the executors were acquired, and left the destruction to us.
+    if (isDestroyPending) {
+        DestroyCompilation(compilationImpl);
+    }
+    return OH_NN_SUCCESS;
 }
 
 NNRT_API OH_NN_ReturnCode OH_NNExecutor_GetOutputShape(OH_NNExecutor *executor,
@@ -1197,6 +1454,10 @@ NNRT_API OH_NN_ReturnCode OH_NNExecutor_RunSync(OH_NNExecutor *executor,
     }
 
     Executor *executorImpl = reinterpret_cast<Executor *>(executor);
+    std::shared_ptr<RequestBatcher> requestBatcher = executorImpl->GetRequestBatcher();
+    if (requestBatcher != nullptr) {
+        return requestBatcher->Run(executorImpl, inputTensor, inputCount, outputTensor, outputCount);
+    }
     return executorImpl->RunSync(inputTensor, inputCount, outputTensor, outputCount);
 }
 
@@ -1235,4 +1496,109 @@ NNRT_API OH_NN_ReturnCode OH_NNExecutor_RunAsync(OH_NNExecutor *executor,
 
     Executor *executorImpl = reinterpret_cast<Executor *>(executor);
     return executorImpl->RunAsync(inputTensor, inputCount, outputTensor, outputCount, timeout, userData);
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNExecutor_RunBatch(OH_NNExecutor *executor,
+                                                 NN_Tensor *inputTensor[],
+                                                 size_t inputCount,
+                                                 NN_Tensor *outputTensor[],
+                                                 size_t outputCount,
+                                                 size_t batchCount)
+{
+    if (executor == nullptr) {
+        LOGE("OH_NNExecutor_RunBatch failed, executor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (inputTensor == nullptr) {
+        LOGE("OH_NNExecutor_RunBatch failed, inputTensor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (inputCount == 0) {
+        LOGE("OH_NNExecutor_RunBatch failed, inputCount is 0.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (outputTensor == nullptr) {
+        LOGE("OH_NNExecutor_RunBatch failed, outputTensor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (outputCount == 0) {
+        LOGE("OH_NNExecutor_RunBatch failed, outputCount is 0.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (batchCount == 0) {
+        LOGE("OH_NNExecutor_RunBatch failed, batchCount is 0.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    Executor *executorImpl = reinterpret_cast<Executor *>(executor);
+    return executorImpl->RunBatch(inputTensor, inputCount, outputTensor, outputCount, batchCount);
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNExecutor_BindIOTensors(OH_NNExecutor *executor,
+                                                      NN_Tensor *inputTensor[],
+                                                      size_t inputCount,
+                                                      NN_Tensor *outputTensor[],
+                                                      size_t outputCount,
+                                                      size_t *bindingId)
+{
+    if (executor == nullptr) {
+        LOGE("OH_NNExecutor_BindIOTensors failed, executor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (inputTensor == nullptr) {
+        LOGE("OH_NNExecutor_BindIOTensors failed, inputTensor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (inputCount == 0) {
+        LOGE("OH_NNExecutor_BindIOTensors failed, inputCount is 0.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (outputTensor == nullptr) {
+        LOGE("OH_NNExecutor_BindIOTensors failed, outputTensor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (outputCount == 0) {
+        LOGE("OH_NNExecutor_BindIOTensors failed, outputCount is 0.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (bindingId == nullptr) {
+        LOGE("OH_NNExecutor_BindIOTensors failed, bindingId is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    Executor *executorImpl = reinterpret_cast<Executor *>(executor);
+    return executorImpl->BindIOTensors(inputTensor, inputCount, outputTensor, outputCount, bindingId);
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNExecutor_RunSyncWithBinding(OH_NNExecutor *executor, size_t bindingId)
+{
+    if (executor == nullptr) {
+        LOGE("OH_NNExecutor_RunSyncWithBinding failed, executor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    Executor *executorImpl = reinterpret_cast<Executor *>(executor);
+    return executorImpl->RunSyncWithBinding(bindingId);
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNExecutor_UnbindIOTensors(OH_NNExecutor *executor, size_t bindingId)
+{
+    if (executor == nullptr) {
+        LOGE("OH_NNExecutor_UnbindIOTensors failed, executor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    Executor *executorImpl = reinterpret_cast<Executor *>(executor);
+    return executorImpl->UnbindIOTensors(bindingId);
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNExecutor_SetOutputAutoGrowth(OH_NNExecutor *executor, bool enable)
+{
+    if (executor == nullptr) {
+        LOGE("OH_NNExecutor_SetOutputAutoGrowth failed, executor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    Executor *executorImpl = reinterpret_cast<Executor *>(executor);
+    return executorImpl->SetOutputAutoGrowth(enable);
 }
\ No newline at end of file
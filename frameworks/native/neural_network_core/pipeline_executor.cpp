@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline_executor.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+
+#include "backend_manager.h"
+#include "common/log.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+PipelineExecutor::PipelineExecutor(size_t backendID, size_t inputNum, size_t outputNum,
+    const std::vector<PipelineStage>& stages, const std::vector<std::shared_ptr<TensorDesc>>& intermediateTensorDescs)
+    : m_backendID(backendID),
+    m_inputNum(inputNum),
+    m_outputNum(outputNum),
+    m_stages(stages),
+    m_intermediateTensorDescs(intermediateTensorDescs)
+{
+    m_intermediateBackendIDs.resize(m_intermediateTensorDescs.size(), m_backendID);
+    for (const auto& stage : m_stages) {
+        for (const auto& ref : stage.outputs) {
+            if ((ref.kind == PipelineTensorKind::INTERMEDIATE) && (ref.index < m_intermediateBackendIDs.size())) {
+                m_intermediateBackendIDs[ref.index] = stage.backendID;
+            }
+        }
+    }
+}
+
+PipelineExecutor::~PipelineExecutor()
+{
+    for (auto& tensors : m_intermediateTensors) {
+        DestroyIntermediateTensors(tensors);
+    }
+    m_intermediateTensors.clear();
+
+    const BackendManager& backendManager = BackendManager::GetInstance();
+    for (auto& stage : m_stages) {
+        if (stage.executor == nullptr) {
+            continue;
+        }
+        std::shared_ptr<Backend> backend = backendManager.GetBackend(stage.backendID);
+        if (backend == nullptr) {
+            LOGE("[PipelineExecutor] Failed to get backend %{public}zu, executor of the stage is leaked.",
+                 stage.backendID);
+            continue;
+        }
+        backend->DestroyExecutor(stage.executor);
+        stage.executor = nullptr;
+    }
+}
+
+void PipelineExecutor::DestroyIntermediateTensors(std::vector<Tensor*>& tensors) const
+{
+    const BackendManager& backendManager = BackendManager::GetInstance();
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        std::shared_ptr<Backend> backend = backendManager.GetBackend(m_intermediateBackendIDs[i]);
+        if ((tensors[i] != nullptr) && (backend != nullptr)) {
+            backend->DestroyTensor(tensors[i]);
+        }
+    }
+    tensors.clear();
+}
+
+bool PipelineExecutor::FindStageInput(size_t inputIndex, size_t& stageIndex, size_t& stageInputIndex) const
+{
+    for (size_t i = 0; i < m_stages.size(); ++i) {
+        const auto& inputs = m_stages[i].inputs;
+        for (size_t j = 0; j < inputs.size(); ++j) {
+            if ((inputs[j].kind == PipelineTensorKind::PIPELINE_INPUT) && (inputs[j].index == inputIndex)) {
+                stageIndex = i;
+                stageInputIndex = j;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool PipelineExecutor::FindStageOutput(size_t outputIndex, size_t& stageIndex, size_t& stageOutputIndex) const
+{
+    for (size_t i = 0; i < m_stages.size(); ++i) {
+        const auto& outputs = m_stages[i].outputs;
+        for (size_t j = 0; j < outputs.size(); ++j) {
+            if ((outputs[j].kind == PipelineTensorKind::PIPELINE_OUTPUT) && (outputs[j].index == outputIndex)) {
+                stageIndex = i;
+                stageOutputIndex = j;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+OH_NN_ReturnCode PipelineExecutor::GetInputDimRange(size_t inputIndex, size_t** minInputDims, size_t** maxInputDims,
+    size_t* shapeNum) const
+{
+    size_t stageIndex {0};
+    size_t stageInputIndex {0};
+    if (!FindStageInput(inputIndex, stageIndex, stageInputIndex)) {
+        LOGE("[PipelineExecutor] GetInputDimRange failed, input %{public}zu is not used by any stage.", inputIndex);
+        return OH_NN_INVALID_PARAMETER;
+    }
+    return m_stages[stageIndex].executor->GetInputDimRange(stageInputIndex, minInputDims, maxInputDims, shapeNum);
+}
+
+OH_NN_ReturnCode PipelineExecutor::GetOutputShape(uint32_t outputIndex, int32_t** shape, uint32_t* shapeNum) const
+{
+    size_t stageIndex {0};
+    size_t stageOutputIndex {0};
+    if (!FindStageOutput(outputIndex, stageIndex, stageOutputIndex)) {
+        LOGE("[PipelineExecutor] GetOutputShape failed, output %{public}u is not produced by any stage.", outputIndex);
+        return OH_NN_INVALID_PARAMETER;
+    }
+    return m_stages[stageIndex].executor->GetOutputShape(static_cast<uint32_t>(stageOutputIndex), shape, shapeNum);
+}
+
+size_t PipelineExecutor::GetInputNum() const
+{
+    return m_inputNum;
+}
+
+size_t PipelineExecutor::GetOutputNum() const
+{
+    return m_outputNum;
+}
+
+NN_TensorDesc* PipelineExecutor::CreateInputTensorDesc(size_t index) const
+{
+    size_t stageIndex {0};
+    size_t stageInputIndex {0};
+    if (!FindStageInput(index, stageIndex, stageInputIndex)) {
+        LOGE("[PipelineExecutor] CreateInputTensorDesc failed, input %{public}zu is not used by any stage.", index);
+        return nullptr;
+    }
+    return m_stages[stageIndex].executor->CreateInputTensorDesc(stageInputIndex);
+}
+
+NN_TensorDesc* PipelineExecutor::CreateOutputTensorDesc(size_t index) const
+{
+    size_t stageIndex {0};
+    size_t stageOutputIndex {0};
+    if (!FindStageOutput(index, stageIndex, stageOutputIndex)) {
+        LOGE("[PipelineExecutor] CreateOutputTensorDesc failed, output %{public}zu is not produced by any stage.",
+             index);
+        return nullptr;
+    }
+    return m_stages[stageIndex].executor->CreateOutputTensorDesc(stageOutputIndex);
+}
+
+OH_NN_ReturnCode PipelineExecutor::SetOnRunDone(NN_OnRunDone onRunDone)
+{
+    LOGE("[PipelineExecutor] SetOnRunDone failed, asynchronous runs are not supported by partitioned models.");
+    return OH_NN_OPERATION_FORBIDDEN;
+}
+
+OH_NN_ReturnCode PipelineExecutor::SetOnServiceDied(NN_OnServiceDied onServiceDied)
+{
+    for (auto& stage : m_stages) {
+        OH_NN_ReturnCode ret = stage.executor->SetOnServiceDied(onServiceDied);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("[PipelineExecutor] SetOnServiceDied failed, failed to set it to the stage of backend %{public}zu.",
+                 stage.backendID);
+            return ret;
+        }
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode PipelineExecutor::CheckIOTensors(NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize) const
+{
+    if ((inputSize != m_inputNum) || (outputSize != m_outputNum)) {
+        LOGE("[PipelineExecutor] inputSize:%{public}zu or outputSize:%{public}zu is not equal to that of model.",
+             inputSize, outputSize);
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if ((std::find(inputTensors, inputTensors + inputSize, nullptr) != inputTensors + inputSize) ||
+        (std::find(outputTensors, outputTensors + outputSize, nullptr) != outputTensors + outputSize)) {
+        LOGE("[PipelineExecutor] Input or output tensor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode PipelineExecutor::PrepareIntermediateTensors(size_t slotNum)
+{
+    // Called with m_runMtx locked. Slots are kept for the following runs.
+    const BackendManager& backendManager = BackendManager::GetInstance();
+    while (m_intermediateTensors.size() < slotNum) {
+        std::vector<Tensor*> tensors;
+        for (size_t i = 0; i < m_intermediateTensorDescs.size(); ++i) {
+            std::shared_ptr<Backend> backend = backendManager.GetBackend(m_intermediateBackendIDs[i]);
+            Tensor* tensor = (backend != nullptr) ? backend->CreateTensor(m_intermediateTensorDescs[i].get()) : nullptr;
+            if (tensor == nullptr) {
+                LOGE("[PipelineExecutor] Failed to create intermediate tensor %{public}zu on backend %{public}zu.", i,
+                     m_intermediateBackendIDs[i]);
+                DestroyIntermediateTensors(tensors);
+                return OH_NN_MEMORY_ERROR;
+            }
+
+            tensors.emplace_back(tensor);
+            OH_NN_ReturnCode ret = tensor->CreateData();
+            if (ret != OH_NN_SUCCESS) {
+                LOGE("[PipelineExecutor] Failed to allocate intermediate tensor %{public}zu.", i);
+                DestroyIntermediateTensors(tensors);
+                return ret;
+            }
+        }
+        m_intermediateTensors.emplace_back(std::move(tensors));
+    }
+    return OH_NN_SUCCESS;
+}
+
+NN_Tensor* PipelineExecutor::GetStageTensor(const PipelineTensorRef& ref, NN_Tensor* inputTensors[],
+    NN_Tensor* outputTensors[], size_t slot) const
+{
+    switch (ref.kind) {
+        case PipelineTensorKind::PIPELINE_INPUT:
+            return (ref.index < m_inputNum) ? inputTensors[ref.index] : nullptr;
+        case PipelineTensorKind::PIPELINE_OUTPUT:
+            return (ref.index < m_outputNum) ? outputTensors[ref.index] : nullptr;
+        default:
+            return (ref.index < m_intermediateTensors[slot].size()) ?
+                reinterpret_cast<NN_Tensor*>(m_intermediateTensors[slot][ref.index]) : nullptr;
+    }
+}
+
+OH_NN_ReturnCode PipelineExecutor::RunStage(size_t stageIndex, NN_Tensor* inputTensors[], NN_Tensor* outputTensors[],
+    size_t slot)
+{
+    PipelineStage& stage = m_stages[stageIndex];
+    std::vector<NN_Tensor*> stageInputs;
+    std::vector<NN_Tensor*> stageOutputs;
+    for (const auto& ref : stage.inputs) {
+        stageInputs.emplace_back(GetStageTensor(ref, inputTensors, outputTensors, slot));
+    }
+    for (const auto& ref : stage.outputs) {
+        stageOutputs.emplace_back(GetStageTensor(ref, inputTensors, outputTensors, slot));
+    }
+
+    OH_NN_ReturnCode ret = stage.executor->RunSync(stageInputs.data(), stageInputs.size(), stageOutputs.data(),
+        stageOutputs.size());
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[PipelineExecutor] Failed to run stage %{public}zu on backend %{public}zu.", stageIndex,
+             stage.backendID);
+    }
+    return ret;
+}
+
+OH_NN_ReturnCode PipelineExecutor::RunSync(NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize)
+{
+    OH_NN_ReturnCode ret = CheckIOTensors(inputTensors, inputSize, outputTensors, outputSize);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[PipelineExecutor] RunSync failed, invalid input or output tensors.");
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> lock(m_runMtx);
+    ret = PrepareIntermediateTensors(1);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[PipelineExecutor] RunSync failed, failed to prepare intermediate tensors.");
+        return ret;
+    }
+
+    for (size_t i = 0; i < m_stages.size(); ++i) {
+        ret = RunStage(i, inputTensors, outputTensors, 0);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("[PipelineExecutor] RunSync failed, failed to run stage %{public}zu.", i);
+            return ret;
+        }
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode PipelineExecutor::RunAsync(NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize, int32_t timeout, void* userData)
+{
+    LOGE("[PipelineExecutor] RunAsync failed, asynchronous runs are not supported by partitioned models.");
+    return OH_NN_OPERATION_FORBIDDEN;
+}
+
+OH_NN_ReturnCode PipelineExecutor::RunBatch(NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize, size_t batchSize)
+{
+    if (batchSize == 0) {
+        LOGE("[PipelineExecutor] RunBatch failed, batchSize is 0.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    for (size_t i = 0; i < batchSize; ++i) {
+        OH_NN_ReturnCode ret = CheckIOTensors(inputTensors + i * inputSize, inputSize,
+            outputTensors + i * outputSize, outputSize);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("[PipelineExecutor] RunBatch failed, invalid input or output tensors of request %{public}zu.", i);
+            return ret;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_runMtx);
+    size_t stageNum = m_stages.size();
+    size_t slotNum = std::min(stageNum, batchSize);
+    OH_NN_ReturnCode ret = PrepareIntermediateTensors(slotNum);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[PipelineExecutor] RunBatch failed, failed to prepare intermediate tensors.");
+        return ret;
+    }
+
+    // Stage s runs request r once stage s - 1 has finished it. The first stage reuses the slot of request
+    // r - slotNum, so it waits until the last stage has finished that request.
+    std::vector<size_t> doneNums(stageNum, 0);
+    OH_NN_ReturnCode batchRet = OH_NN_SUCCESS;
+    std::mutex progressMtx;
+    std::condition_variable progressCond;
+    auto runStageLoop = [&](size_t stageIndex) {
+        for (size_t r = 0; r < batchSize; ++r) {
+            {
+                std::unique_lock<std::mutex> progressLock(progressMtx);
+                progressCond.wait(progressLock, [&]() {
+                    if (batchRet != OH_NN_SUCCESS) {
+                        return true;
+                    }
+                    return (stageIndex == 0) ? (doneNums[stageNum - 1] + slotNum > r) :
+                        (doneNums[stageIndex - 1] > r);
+                });
+                if (batchRet != OH_NN_SUCCESS) {
+                    return;
+                }
+            }
+
+            OH_NN_ReturnCode stageRet = RunStage(stageIndex, inputTensors + r * inputSize,
+                outputTensors + r * outputSize, r % slotNum);
+            {
+                std::lock_guard<std::mutex> progressLock(progressMtx);
+                if (stageRet != OH_NN_SUCCESS) {
+                    batchRet = (batchRet == OH_NN_SUCCESS) ? stageRet : batchRet;
+                } else {
+                    ++doneNums[stageIndex];
+                }
+            }
+            progressCond.notify_all();
+            if (stageRet != OH_NN_SUCCESS) {
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < stageNum; ++i) {
+        workers.emplace_back(runStageLoop, i);
+    }
+    runStageLoop(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (batchRet != OH_NN_SUCCESS) {
+        LOGE("[PipelineExecutor] RunBatch failed, failed to run the requests through the stages.");
+    }
+    return batchRet;
+}
+
+OH_NN_ReturnCode PipelineExecutor::BindIOTensors(NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize, size_t* bindingId)
+{
+    OH_NN_ReturnCode ret = CheckIOTensors(inputTensors, inputSize, outputTensors, outputSize);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[PipelineExecutor] BindIOTensors failed, invalid input or output tensors.");
+        return ret;
+    }
+
+    IOBinding binding;
+    binding.inputs.assign(inputTensors, inputTensors + inputSize);
+    binding.outputs.assign(outputTensors, outputTensors + outputSize);
+
+    std::lock_guard<std::mutex> lock(m_bindingMtx);
+    *bindingId = m_nextBindingId++;
+    m_ioBindings.emplace(*bindingId, std::move(binding));
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode PipelineExecutor::RunSyncWithBinding(size_t bindingId)
+{
+    IOBinding binding;
+    {
+        std::lock_guard<std::mutex> lock(m_bindingMtx);
+        auto iter = m_ioBindings.find(bindingId);
+        if (iter == m_ioBindings.end()) {
+            LOGE("[PipelineExecutor] RunSyncWithBinding failed, binding %{public}zu does not exist.", bindingId);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        binding = iter->second;
+    }
+
+    return RunSync(binding.inputs.data(), binding.inputs.size(), binding.outputs.data(), binding.outputs.size());
+}
+
+OH_NN_ReturnCode PipelineExecutor::UnbindIOTensors(size_t bindingId)
+{
+    std::lock_guard<std::mutex> lock(m_bindingMtx);
+    if (m_ioBindings.erase(bindingId) == 0) {
+        LOGE("[PipelineExecutor] UnbindIOTensors failed, binding %{public}zu does not exist.", bindingId);
+        return OH_NN_INVALID_PARAMETER;
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode PipelineExecutor::SetOutputAutoGrowth(bool enable)
+{
+    for (auto& stage : m_stages) {
+        OH_NN_ReturnCode ret = stage.executor->SetOutputAutoGrowth(enable);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("[PipelineExecutor] SetOutputAutoGrowth failed, failed to set it to the stage of backend %{public}zu.",
+                 stage.backendID);
+            return ret;
+        }
+    }
+    return OH_NN_SUCCESS;
+}
+
+size_t PipelineExecutor::GetBackendID()
+{
+    return m_backendID;
+}
+
+bool PipelineExecutor::IsCompatibleWithOldAPIs() const
+{
+    return false;
+}
+
+void PipelineExecutor::Reset()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_bindingMtx);
+        m_ioBindings.clear();
+    }
+
+    for (auto& stage : m_stages) {
+        stage.executor->Reset();
+    }
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_CORE_PIPELINE_EXECUTOR_H
+#define NEURAL_NETWORK_CORE_PIPELINE_EXECUTOR_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "executor.h"
+#include "tensor.h"
+#include "tensor_desc.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+// A tensor of a pipeline stage is an input or output of the pipeline, or an intermediate tensor passed between stages.
+enum class PipelineTensorKind {
+    PIPELINE_INPUT,
+    PIPELINE_OUTPUT,
+    INTERMEDIATE,
+};
+
+struct PipelineTensorRef {
+    PipelineTensorKind kind {PipelineTensorKind::INTERMEDIATE};
+    size_t index {0};
+};
+
+struct PipelineStage {
+    size_t backendID {0};
+    // Owned by the pipeline and destroyed by the backend of the stage.
+    Executor* executor {nullptr};
+    std::vector<PipelineTensorRef> inputs;
+    std::vector<PipelineTensorRef> outputs;
+};
+
+// Runs a model split into stages compiled on different backends, the stages run one after another in their order.
+// An intermediate tensor is allocated by the backend of the stage producing it, the stages consuming it read its
+// shared memory directly. RunBatch overlaps the stages of consecutive requests, every stage runs in its own thread.
+class PipelineExecutor : public Executor {
+public:
+    PipelineExecutor(size_t backendID,
+                     size_t inputNum,
+                     size_t outputNum,
+                     const std::vector<PipelineStage>& stages,
+                     const std::vector<std::shared_ptr<TensorDesc>>& intermediateTensorDescs);
+    ~PipelineExecutor() override;
+
+    OH_NN_ReturnCode GetInputDimRange(size_t inputIndex,
+                                      size_t** minInputDims,
+                                      size_t** maxInputDims,
+                                      size_t* shapeNum) const override;
+    OH_NN_ReturnCode GetOutputShape(uint32_t outputIndex, int32_t** shape, uint32_t* shapeNum) const override;
+
+    size_t GetInputNum() const override;
+    size_t GetOutputNum() const override;
+    NN_TensorDesc* CreateInputTensorDesc(size_t index) const override;
+    NN_TensorDesc* CreateOutputTensorDesc(size_t index) const override;
+
+    OH_NN_ReturnCode SetOnRunDone(NN_OnRunDone onRunDone) override;
+    OH_NN_ReturnCode SetOnServiceDied(NN_OnServiceDied onServiceDied) override;
+    OH_NN_ReturnCode RunSync(NN_Tensor* inputTensors[],
+                             size_t inputSize,
+                             NN_Tensor* outputTensors[],
+                             size_t outputSize) override;
+    OH_NN_ReturnCode RunAsync(NN_Tensor* inputTensors[],
+                              size_t inputSize,
+                              NN_Tensor* outputTensors[],
+                              size_t outputSize,
+                              int32_t timeout,
+                              void* userData) override;
+    OH_NN_ReturnCode RunBatch(NN_Tensor* inputTensors[],
+                              size_t inputSize,
+                              NN_Tensor* outputTensors[],
+                              size_t outputSize,
+                              size_t batchSize) override;
+    OH_NN_ReturnCode BindIOTensors(NN_Tensor* inputTensors[],
+                                   size_t inputSize,
+                                   NN_Tensor* outputTensors[],
+                                   size_t outputSize,
+                                   size_t* bindingId) override;
+    OH_NN_ReturnCode RunSyncWithBinding(size_t bindingId) override;
+    OH_NN_ReturnCode UnbindIOTensors(size_t bindingId) override;
+    OH_NN_ReturnCode SetOutputAutoGrowth(bool enable) override;
+    size_t GetBackendID() override;
+    bool IsCompatibleWithOldAPIs() const override;
+    void Reset() override;
+
+private:
+    PipelineExecutor(const PipelineExecutor&) = delete;
+    PipelineExecutor& operator=(const PipelineExecutor&) = delete;
+
+    void DestroyIntermediateTensors(std::vector<Tensor*>& tensors) const;
+    bool FindStageInput(size_t inputIndex, size_t& stageIndex, size_t& stageInputIndex) const;
+    bool FindStageOutput(size_t outputIndex, size_t& stageIndex, size_t& stageOutputIndex) const;
+    OH_NN_ReturnCode CheckIOTensors(NN_Tensor* inputTensors[],
+                                    size_t inputSize,
+                                    NN_Tensor* outputTensors[],
+                                    size_t outputSize) const;
+    OH_NN_ReturnCode PrepareIntermediateTensors(size_t slotNum);
+    NN_Tensor* GetStageTensor(const PipelineTensorRef& ref,
+                              NN_Tensor* inputTensors[],
+                              NN_Tensor* outputTensors[],
+                              size_t slot) const;
+    OH_NN_ReturnCode RunStage(size_t stageIndex, NN_Tensor* inputTensors[], NN_Tensor* outputTensors[], size_t slot);
+
+private:
+    size_t m_backendID {0};
+    size_t m_inputNum {0};
+    size_t m_outputNum {0};
+    std::vector<PipelineStage> m_stages;
+    std::vector<std::shared_ptr<TensorDesc>> m_intermediateTensorDescs;
+    // Backend of the stage producing every intermediate tensor
+    std::vector<size_t> m_intermediateBackendIDs;
+
+    // Intermediate tensors of every request in flight, a batch of requests uses up to one slot per stage.
+    std::vector<std::vector<Tensor*>> m_intermediateTensors;
+    std::mutex m_runMtx;
+
+    // Tensors bound by BindIOTensors
+    struct IOBinding {
+        std::vector<NN_Tensor*> inputs;
+        std::vector<NN_Tensor*> outputs;
+    };
+    std::unordered_map<size_t, IOBinding> m_ioBindings;
+    size_t m_nextBindingId {0};
+    std::mutex m_bindingMtx;
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_CORE_PIPELINE_EXECUTOR_H
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "request_batcher.h"
+
+#include <algorithm>
+
+#include "common/log.h"
+#include "common/utils.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace {
+const size_t MAX_DYNAMIC_BATCH_SIZE = 256;
+const size_t DEFAULT_DYNAMIC_BATCH_TIMEOUT = 1000; // microseconds
+const size_t MAX_DYNAMIC_BATCH_TIMEOUT = 1000000; // microseconds
+const size_t MAX_CONFIG_DIGITS = 7;
+
+OH_NN_ReturnCode ParseConfig(const std::unordered_map<std::string, std::vector<char>>& configs, const char* key,
+    size_t maxValue, size_t& value, bool& isSet)
+{
+    isSet = false;
+    auto iter = configs.find(key);
+    if (iter == configs.end()) {
+        return OH_NN_SUCCESS;
+    }
+
+    // The value is a decimal string, e.g. "8".
+    std::string valueStr(iter->second.begin(), iter->second.end());
+    valueStr = valueStr.substr(0, valueStr.find('\0'));
+    if (valueStr.empty() || (valueStr.find_first_not_of("0123456789") != std::string::npos) ||
+        (valueStr.size() > MAX_CONFIG_DIGITS) || (std::stoul(valueStr) > maxValue)) {
+        LOGE("[RequestBatcher] %{public}s should be an integer no greater than %{public}zu.", key, maxValue);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    value = static_cast<size_t>(std::stoul(valueStr));
+    isSet = true;
+    return OH_NN_SUCCESS;
+}
+} // namespace
+
+RequestBatcher::RequestBatcher(size_t maxBatchSize, std::chrono::microseconds timeout)
+    : m_maxBatchSize(maxBatchSize), m_timeout(timeout) {}
+
+OH_NN_ReturnCode RequestBatcher::Create(const std::unordered_map<std::string, std::vector<char>>& configs,
+    std::shared_ptr<RequestBatcher>& requestBatcher)
+{
+    requestBatcher = nullptr;
+
+    size_t maxBatchSize {0};
+    bool isSet {false};
+    OH_NN_ReturnCode ret = ParseConfig(configs, EXTENSION_KEY_DYNAMIC_BATCH_MAX_SIZE, MAX_DYNAMIC_BATCH_SIZE,
+        maxBatchSize, isSet);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[RequestBatcher] Create failed, invalid max batch size.");
+        return ret;
+    }
+    if (!isSet || (maxBatchSize <= 1)) {
+        return OH_NN_SUCCESS;
+    }
+
+    size_t timeout {DEFAULT_DYNAMIC_BATCH_TIMEOUT};
+    ret = ParseConfig(configs, EXTENSION_KEY_DYNAMIC_BATCH_TIMEOUT, MAX_DYNAMIC_BATCH_TIMEOUT, timeout, isSet);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[RequestBatcher] Create failed, invalid timeout.");
+        return ret;
+    }
+
+    requestBatcher = CreateSharedPtr<RequestBatcher>(maxBatchSize, std::chrono::microseconds(timeout));
+    if (requestBatcher == nullptr) {
+        LOGE("[RequestBatcher] Create failed, failed to create request batcher.");
+        return OH_NN_MEMORY_ERROR;
+    }
+
+    LOGI("[RequestBatcher] Dynamic batching is enabled, max batch size %{public}zu, timeout %{public}zu us.",
+        maxBatchSize, timeout);
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode RequestBatcher::Run(Executor* executor, NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize)
+{
+    Request request;
+    request.executor = executor;
+    request.inputTensors = inputTensors;
+    request.inputSize = inputSize;
+    request.outputTensors = outputTensors;
+    request.outputSize = outputSize;
+
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_pendingRequests.emplace_back(&request);
+    ++m_requestNums[executor];
+    m_cond.notify_all();
+    while (!request.isDone) {
+        if (m_isCollecting) {
+            m_cond.wait(lock);
+            continue;
+        }
+
+        // No request is collecting the next batch, so this one does. It waits for more requests until the batch is
+        // full, no more requests can join it, or the latency window is closed, then hands over the collecting and runs
+        // the batch.
+        m_isCollecting = true;
+        auto deadline = std::chrono::steady_clock::now() + m_timeout;
+        m_cond.wait_until(lock, deadline, [this] { return IsBatchReady(); });
+
+        size_t batchSize = std::min(m_pendingRequests.size(), m_maxBatchSize);
+        std::vector<Request*> requests(m_pendingRequests.begin(), m_pendingRequests.begin() + batchSize);
+        m_pendingRequests.erase(m_pendingRequests.begin(), m_pendingRequests.begin() + batchSize);
+        m_isCollecting = false;
+        m_cond.notify_all();
+
+        lock.unlock();
+        RunRequests(requests);
+        lock.lock();
+
+        for (auto runRequest : requests) {
+            runRequest->isDone = true;
+            auto iter = m_requestNums.find(runRequest->executor);
+            if ((iter != m_requestNums.end()) && (--(iter->second) == 0)) {
+                m_requestNums.erase(iter);
+            }
+        }
+        m_cond.notify_all();
+    }
+
+    return request.ret;
+}
+
+void RequestBatcher::AddExecutor()
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    ++m_executorNum;
+}
+
+void RequestBatcher::RemoveExecutor()
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (m_executorNum > 0) {
+        --m_executorNum;
+    }
+    // The collecting request may be waiting for the removed executor.
+    m_cond.notify_all();
+}
+
+bool RequestBatcher::IsBatchReady() const
+{
+    // Called with m_mtx locked. Every executor with a request pending or running cannot issue another one before it
+    // returns, unless the executor is shared by threads, in which case the batch is only smaller than it could be.
+    return (m_pendingRequests.size() >= m_maxBatchSize) || (m_requestNums.size() >= m_executorNum);
+}
+
+void RequestBatcher::RunRequests(const std::vector<Request*>& requests) const
+{
+    const Request* firstRequest = requests[0];
+    bool isBatchable = requests.size() > 1;
+    std::vector<NN_Tensor*> inputTensors;
+    std::vector<NN_Tensor*> outputTensors;
+    for (size_t i = 0; (i < requests.size()) && isBatchable; ++i) {
+        const Request* request = requests[i];
+        if ((request->inputSize != firstRequest->inputSize) || (request->outputSize != firstRequest->outputSize)) {
+            isBatchable = false;
+            break;
+        }
+        inputTensors.insert(inputTensors.end(), request->inputTensors, request->inputTensors + request->inputSize);
+        outputTensors.insert(outputTensors.end(), request->outputTensors,
+            request->outputTensors + request->outputSize);
+    }
+
+    // Executors of one compilation share the prepared model, so any of them can run the requests of the others. The
+    // output shapes of every request are passed to its own executor afterwards.
+    if (isBatchable) {
+        OH_NN_ReturnCode ret = firstRequest->executor->RunBatch(inputTensors.data(), firstRequest->inputSize,
+            outputTensors.data(), firstRequest->outputSize, requests.size());
+        if (ret != OH_NN_INVALID_PARAMETER) {
+            for (auto request : requests) {
+                request->ret = ret;
+                if (ret == OH_NN_SUCCESS) {
+                    request->ret = request->executor->SyncOutputShapes(request->outputTensors, request->outputSize);
+                }
+            }
+            return;
+        }
+        LOGW("[RequestBatcher] Failed to run requests in batch, run them one by one to find the invalid one.");
+    }
+
+    for (auto request : requests) {
+        request->ret = request->executor->RunSync(request->inputTensors, request->inputSize,
+            request->outputTensors, request->outputSize);
+    }
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
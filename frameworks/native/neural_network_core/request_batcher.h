@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_CORE_REQUEST_BATCHER_H
+#define NEURAL_NETWORK_CORE_REQUEST_BATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "executor.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+const char EXTENSION_KEY_DYNAMIC_BATCH_MAX_SIZE[] = "DynamicBatchMaxSize";
+const char EXTENSION_KEY_DYNAMIC_BATCH_TIMEOUT[] = "DynamicBatchTimeout";
+
+// Merges the synchronous runs issued concurrently on the executors of one compilation. The first request waits up to
+// the timeout for other requests, then runs all collected requests with one Executor::RunBatch call, which stacks
+// them along the first dimension when the input dim ranges allow it. The wait ends early once every executor of the
+// compilation has a request in the batcher, since no more requests can join the batch then.
+class RequestBatcher {
+public:
+    RequestBatcher(size_t maxBatchSize, std::chrono::microseconds timeout);
+    ~RequestBatcher() = default;
+
+    // requestBatcher is set to nullptr if dynamic batching is not enabled by the extension configs.
+    static OH_NN_ReturnCode Create(const std::unordered_map<std::string, std::vector<char>>& configs,
+                                   std::shared_ptr<RequestBatcher>& requestBatcher);
+
+    OH_NN_ReturnCode Run(Executor* executor,
+                         NN_Tensor* inputTensors[],
+                         size_t inputSize,
+                         NN_Tensor* outputTensors[],
+                         size_t outputSize);
+    // Executors of the compilation, which may issue requests to the batcher.
+    void AddExecutor();
+    void RemoveExecutor();
+
+private:
+    struct Request {
+        Executor* executor {nullptr};
+        NN_Tensor** inputTensors {nullptr};
+        size_t inputSize {0};
+        NN_Tensor** outputTensors {nullptr};
+        size_t outputSize {0};
+        bool isDone {false};
+        OH_NN_ReturnCode ret {OH_NN_FAILED};
+    };
+
+    RequestBatcher(const RequestBatcher&) = delete;
+    RequestBatcher& operator=(const RequestBatcher&) = delete;
+
+    bool IsBatchReady() const;
+    void RunRequests(const std::vector<Request*>& requests) const;
+
+private:
+    size_t m_maxBatchSize {1};
+    std::chrono::microseconds m_timeout {0};
+    std::deque<Request*> m_pendingRequests;
+    std::unordered_map<Executor*, size_t> m_requestNums;
+    size_t m_executorNum {0};
+    bool m_isCollecting {false};
+    std::mutex m_mtx;
+    std::condition_variable m_cond;
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_CORE_REQUEST_BATCHER_H
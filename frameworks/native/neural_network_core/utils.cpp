@@ -15,8 +15,109 @@
 
 #include "common/utils.h"
 
+#include <cstring>
+
 namespace OHOS {
 namespace NeuralNetworkRuntime {
+namespace {
+constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+constexpr size_t XXH_STRIPE_SIZE = 32;
+
+inline uint64_t RotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// std::memcpy with a constant size is lowered to one unaligned load, so the lanes stay in registers.
+inline uint64_t ReadUint64(const char* buffer)
+{
+    uint64_t value {0};
+    std::memcpy(&value, buffer, sizeof(value));
+    return value;
+}
+
+inline uint32_t ReadUint32(const char* buffer)
+{
+    uint32_t value {0};
+    std::memcpy(&value, buffer, sizeof(value));
+    return value;
+}
+
+inline uint64_t XXHashRound(uint64_t acc, uint64_t input)
+{
+    acc += input * XXH_PRIME64_2;
+    acc = RotateLeft(acc, 31);
+    return acc * XXH_PRIME64_1;
+}
+
+inline uint64_t XXHashMergeRound(uint64_t acc, uint64_t value)
+{
+    acc ^= XXHashRound(0, value);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+} // namespace
+
+// XXH64. The four independent lanes have no table lookups and no carried byte dependency, so the
+// compiler keeps them in registers and the loop runs close to memory bandwidth.
+uint64_t GetXXHash64(const void* data, size_t length, uint64_t seed)
+{
+    const char* buffer = static_cast<const char*>(data);
+    const char* end = buffer + length;
+    uint64_t hash {0};
+    if (length >= XXH_STRIPE_SIZE) {
+        uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        uint64_t v2 = seed + XXH_PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_PRIME64_1;
+        const char* limit = end - XXH_STRIPE_SIZE;
+        do {
+            v1 = XXHashRound(v1, ReadUint64(buffer));
+            v2 = XXHashRound(v2, ReadUint64(buffer + 8));
+            v3 = XXHashRound(v3, ReadUint64(buffer + 16));
+            v4 = XXHashRound(v4, ReadUint64(buffer + 24));
+            buffer += XXH_STRIPE_SIZE;
+        } while (buffer <= limit);
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = XXHashMergeRound(hash, v1);
+        hash = XXHashMergeRound(hash, v2);
+        hash = XXHashMergeRound(hash, v3);
+        hash = XXHashMergeRound(hash, v4);
+    } else {
+        hash = seed + XXH_PRIME64_5;
+    }
+
+    hash += static_cast<uint64_t>(length);
+    while (buffer + sizeof(uint64_t) <= end) {
+        hash ^= XXHashRound(0, ReadUint64(buffer));
+        hash = RotateLeft(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        buffer += sizeof(uint64_t);
+    }
+
+    if (buffer + sizeof(uint32_t) <= end) {
+        hash ^= static_cast<uint64_t>(ReadUint32(buffer)) * XXH_PRIME64_1;
+        hash = RotateLeft(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        buffer += sizeof(uint32_t);
+    }
+
+    while (buffer < end) {
+        hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*buffer)) * XXH_PRIME64_5;
+        hash = RotateLeft(hash, 11) * XXH_PRIME64_1;
+        ++buffer;
+    }
+
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
 std::string GenUniqueName(
     const std::string& deviceName, const std::string& vendorName, const std::string& version)
 {
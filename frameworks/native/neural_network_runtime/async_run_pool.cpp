@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "async_run_pool.h"
+
+#include "common/log.h"
+#include "common/utils.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace {
+// One thread feeds the device while the other prepares the next request.
+constexpr size_t ASYNC_WORKER_NUM = 2;
+constexpr size_t MAX_PENDING_TASK_NUM = 1024;
+}
+
+AsyncRunPool::AsyncRunPool(size_t workerNum)
+{
+    for (size_t i = 0; i < workerNum; ++i) {
+        m_workers.emplace_back(&AsyncRunPool::WorkerLoop, this);
+    }
+}
+
+AsyncRunPool::~AsyncRunPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_isStopped = true;
+    }
+    m_taskCond.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+OH_NN_ReturnCode AsyncRunPool::Submit(const void* owner, Task&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (m_isStopped) {
+            LOGE("[AsyncRunPool] Submit failed, the pool has been stopped.");
+            return OH_NN_OPERATION_FORBIDDEN;
+        }
+        if (m_pendingTaskNum >= MAX_PENDING_TASK_NUM) {
+            LOGE("[AsyncRunPool] Submit failed, too many pending requests: %{public}zu.", m_pendingTaskNum);
+            return OH_NN_OPERATION_FORBIDDEN;
+        }
+
+        OwnerQueue& ownerQueue = m_ownerQueues[owner];
+        ownerQueue.tasks.emplace_back(std::move(task));
+        ++m_pendingTaskNum;
+        if (!ownerQueue.isRunning && (ownerQueue.tasks.size() == 1)) {
+            m_readyOwners.emplace_back(owner);
+        }
+    }
+    m_taskCond.notify_one();
+    return OH_NN_SUCCESS;
+}
+
+void AsyncRunPool::WorkerLoop()
+{
+    while (true) {
+        Task task;
+        const void* owner {nullptr};
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            m_taskCond.wait(lock, [this] { return m_isStopped || !m_readyOwners.empty(); });
+            // Pending requests are still drained when stopping, so that every callback is called exactly once. The
+            // remaining requests of an owner whose request is running are drained by the worker running it.
+            if (m_readyOwners.empty()) {
+                return;
+            }
+            owner = m_readyOwners.front();
+            m_readyOwners.pop_front();
+            OwnerQueue& ownerQueue = m_ownerQueues[owner];
+            task = std::move(ownerQueue.tasks.front());
+            ownerQueue.tasks.pop_front();
+            ownerQueue.isRunning = true;
+            --m_pendingTaskNum;
+        }
+        task();
+
+        bool isReady {false};
+        {
+            // The owner goes to the back of the line, behind the owners which have been waiting.
+            std::lock_guard<std::mutex> lock(m_mtx);
+            auto iter = m_ownerQueues.find(owner);
+            iter->second.isRunning = false;
+            if (iter->second.tasks.empty()) {
+                m_ownerQueues.erase(iter);
+            } else {
+                m_readyOwners.emplace_back(owner);
+                isReady = true;
+            }
+        }
+        if (isReady) {
+            m_taskCond.notify_one();
+        }
+    }
+}
+
+std::shared_ptr<AsyncRunPool> AsyncRunPool::GetPool(size_t backendID)
+{
+    static std::mutex poolMtx;
+    static std::unordered_map<size_t, std::shared_ptr<AsyncRunPool>> pools;
+
+    std::lock_guard<std::mutex> lock(poolMtx);
+    auto iter = pools.find(backendID);
+    if (iter != pools.end()) {
+        return iter->second;
+    }
+
+    std::shared_ptr<AsyncRunPool> pool = CreateSharedPtr<AsyncRunPool>(ASYNC_WORKER_NUM);
+    if (pool == nullptr) {
+        LOGE("[AsyncRunPool] GetPool failed, fail to create pool for backend %{public}zu.", backendID);
+        return nullptr;
+    }
+    pools.emplace(backendID, pool);
+    return pool;
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_RUNTIME_ASYNC_RUN_POOL_H
+#define NEURAL_NETWORK_RUNTIME_ASYNC_RUN_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "interfaces/kits/c/neural_network_runtime/neural_network_runtime_type.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+// Worker pool which serves the asynchronous inference requests of all executors created on one backend.
+// Every owner (an executor) has its own FIFO queue, the owners with pending requests are served in turn and at most one
+// request of an owner runs at a time. So an executor submitting many requests neither occupies all workers with
+// requests waiting on its own run lock nor delays the requests of the other executors.
+class AsyncRunPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit AsyncRunPool(size_t workerNum);
+    ~AsyncRunPool();
+
+    OH_NN_ReturnCode Submit(const void* owner, Task&& task);
+
+    static std::shared_ptr<AsyncRunPool> GetPool(size_t backendID);
+
+private:
+    AsyncRunPool(const AsyncRunPool&) = delete;
+    AsyncRunPool& operator=(const AsyncRunPool&) = delete;
+
+    void WorkerLoop();
+
+private:
+    struct OwnerQueue {
+        std::deque<Task> tasks;
+        bool isRunning {false};
+    };
+
+    bool m_isStopped {false};
+    std::unordered_map<const void*, OwnerQueue> m_ownerQueues;
+    // Owners which have pending tasks and no running one, in the order they are served
+    std::deque<const void*> m_readyOwners;
+    size_t m_pendingTaskNum {0};
+    std::vector<std::thread> m_workers;
+    std::mutex m_mtx;
+    std::condition_variable m_taskCond;
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_RUNTIME_ASYNC_RUN_POOL_H
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "const_tensor_packer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "securec.h"
+#include "common/log.h"
+#include "transform.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace {
+constexpr size_t PARALLEL_PACK_MIN_SIZE = 16 * 1024 * 1024; // 16MB
+constexpr size_t MAX_PACK_THREAD_NUM = 4;
+
+bool IsValidAlignment(size_t alignment)
+{
+    return (alignment != 0) && ((alignment & (alignment - 1)) == 0) && (alignment <= MAX_CONST_TENSOR_ALIGNMENT);
+}
+}
+
+ConstTensorPacker::ConstTensorPacker(const mindspore::lite::LiteGraph* liteGraph, size_t alignment)
+    : m_liteGraph(liteGraph)
+{
+    if (alignment != 0) {
+        if (IsValidAlignment(alignment)) {
+            m_alignment = alignment;
+        } else {
+            LOGW("[ConstTensorPacker] Alignment %{public}zu is invalid, use %{public}zu instead.",
+                 alignment, DEFAULT_CONST_TENSOR_ALIGNMENT);
+        }
+    }
+
+    if (m_liteGraph != nullptr) {
+        m_constTensorSize = mindspore::lite::MindIR_LiteGraph_GetConstTensorSize(m_liteGraph);
+    }
+    m_isPlanned = PlanLayouts();
+}
+
+bool ConstTensorPacker::PlanLayouts()
+{
+    if (m_liteGraph == nullptr) {
+        return false;
+    }
+
+    // Only the tensors which are neither inputs of the graph nor outputs of a node can hold constant data.
+    size_t tensorNum = m_liteGraph->all_tensors_.size();
+    std::vector<bool> isComputed(tensorNum, false);
+    for (uint32_t index : m_liteGraph->input_indices_) {
+        if (index < tensorNum) {
+            isComputed[index] = true;
+        }
+    }
+    for (auto node : m_liteGraph->all_nodes_) {
+        if (node == nullptr) {
+            return false;
+        }
+        for (uint32_t index : node->output_indices_) {
+            if (index < tensorNum) {
+                isComputed[index] = true;
+            }
+        }
+    }
+
+    m_plannedLayouts.assign(tensorNum, ConstTensorLayout());
+    size_t offset = 0;
+    for (size_t i = 0; i < tensorNum; ++i) {
+        auto tensor = m_liteGraph->all_tensors_[i];
+        if (isComputed[i]) {
+            continue;
+        }
+        if (tensor == nullptr) {
+            return false;
+        }
+
+        size_t dataSize = GetTypeSize(MSToNN::TransformDataType(mindspore::lite::MindIR_Tensor_GetDataType(tensor)));
+        if (dataSize == 0) {
+            LOGI("[ConstTensorPacker] Tensor %{public}zu has no fixed-size data type, constants are not aligned.", i);
+            return false;
+        }
+        for (int32_t dim : mindspore::lite::MindIR_Tensor_GetDims(tensor)) {
+            if ((dim < 0) || ((dim > 0) && (dataSize > SIZE_MAX / static_cast<size_t>(dim)))) {
+                return false;
+            }
+            dataSize *= static_cast<size_t>(dim);
+        }
+        if (dataSize == 0) {
+            continue;
+        }
+
+        offset = (offset + m_alignment - 1) & ~(m_alignment - 1);
+        m_plannedLayouts[i].offset = offset;
+        m_plannedLayouts[i].dataSize = dataSize;
+        offset += dataSize;
+    }
+
+    // A plan smaller than all constants cannot hold them, which is known before reading any data.
+    m_plannedSize = offset;
+    return m_plannedSize >= m_constTensorSize;
+}
+
+size_t ConstTensorPacker::GetBufferSize() const
+{
+    return m_isPlanned ? std::max(m_plannedSize, m_constTensorSize) : m_constTensorSize;
+}
+
+OH_NN_ReturnCode ConstTensorPacker::Pack(uint8_t* buffer, size_t bufferSize,
+                                         std::vector<ConstTensorLayout>& layouts) const
+{
+    if ((m_liteGraph == nullptr) || (buffer == nullptr)) {
+        LOGE("[ConstTensorPacker] Pack failed, liteGraph or buffer is nullptr.");
+        return OH_NN_NULL_PTR;
+    }
+
+    if (m_isPlanned && (m_plannedSize <= bufferSize)) {
+        OH_NN_ReturnCode ret = PackPlanned(buffer, layouts);
+        if (ret == OH_NN_SUCCESS) {
+            return OH_NN_SUCCESS;
+        }
+        LOGW("[ConstTensorPacker] Constants do not match the planned layout, pack them sequentially.");
+    }
+    return PackSequentially(buffer, bufferSize, layouts);
+}
+
+OH_NN_ReturnCode ConstTensorPacker::PackPlanned(uint8_t* buffer, std::vector<ConstTensorLayout>& layouts) const
+{
+    size_t tensorNum = m_plannedLayouts.size();
+    layouts.assign(tensorNum, ConstTensorLayout());
+
+    size_t threadNum = 1;
+    if (m_plannedSize >= PARALLEL_PACK_MIN_SIZE) {
+        threadNum = std::min<size_t>(std::max<unsigned int>(std::thread::hardware_concurrency(), 1),
+                                     MAX_PACK_THREAD_NUM);
+    }
+
+    // Every thread copies a contiguous range of tensors holding about the same number of bytes.
+    std::vector<size_t> bounds {0};
+    size_t rangeSize = m_plannedSize / threadNum + 1;
+    size_t accumulatedSize = 0;
+    for (size_t i = 0; (i < tensorNum) && (bounds.size() < threadNum); ++i) {
+        accumulatedSize += m_plannedLayouts[i].dataSize;
+        if (accumulatedSize >= rangeSize * bounds.size()) {
+            bounds.emplace_back(i + 1);
+        }
+    }
+    bounds.emplace_back(tensorNum);
+
+    std::atomic<bool> isSuccess {true};
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+        workers.emplace_back([this, buffer, &bounds, &layouts, &isSuccess, i]() {
+            if (!CopyTensors(buffer, bounds[i], bounds[i + 1], layouts)) {
+                isSuccess = false;
+            }
+        });
+    }
+    if (!CopyTensors(buffer, bounds[0], bounds[1], layouts)) {
+        isSuccess = false;
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (!isSuccess) {
+        return OH_NN_FAILED;
+    }
+
+    // Data found in tensors which were not planned would be lost, which the total size tells.
+    size_t packedSize = 0;
+    for (const auto& layout : layouts) {
+        packedSize += layout.dataSize;
+    }
+    return (packedSize == m_constTensorSize) ? OH_NN_SUCCESS : OH_NN_FAILED;
+}
+
+bool ConstTensorPacker::CopyTensors(uint8_t* buffer, size_t begin, size_t end,
+                                    std::vector<ConstTensorLayout>& layouts) const
+{
+    for (size_t i = begin; i < end; ++i) {
+        const ConstTensorLayout& slot = m_plannedLayouts[i];
+        if (slot.dataSize == 0) {
+            continue;
+        }
+
+        std::vector<uint8_t> data = mindspore::lite::MindIR_Tensor_GetData(m_liteGraph->all_tensors_[i]);
+        if (data.empty()) {
+            continue;
+        }
+        if ((data.size() > slot.dataSize) ||
+            (memcpy_s(buffer + slot.offset, slot.dataSize, data.data(), data.size()) != EOK)) {
+            return false;
+        }
+        layouts[i].offset = slot.offset;
+        layouts[i].dataSize = data.size();
+    }
+    return true;
+}
+
+OH_NN_ReturnCode ConstTensorPacker::PackSequentially(uint8_t* buffer, size_t bufferSize,
+                                                     std::vector<ConstTensorLayout>& layouts) const
+{
+    size_t tensorNum = m_liteGraph->all_tensors_.size();
+    layouts.assign(tensorNum, ConstTensorLayout());
+
+    size_t offset = 0;
+    for (size_t i = 0; i < tensorNum; ++i) {
+        auto tensor = m_liteGraph->all_tensors_[i];
+        if (tensor == nullptr) {
+            continue;
+        }
+        std::vector<uint8_t> data = mindspore::lite::MindIR_Tensor_GetData(tensor);
+        if (data.empty()) {
+            continue;
+        }
+        if ((data.size() > bufferSize - offset) ||
+            (memcpy_s(buffer + offset, bufferSize - offset, data.data(), data.size()) != EOK)) {
+            LOGE("[ConstTensorPacker] PackSequentially failed, buffer is not enough for tensor %{public}zu.", i);
+            return OH_NN_FAILED;
+        }
+        layouts[i].offset = offset;
+        layouts[i].dataSize = data.size();
+        offset += data.size();
+    }
+    return OH_NN_SUCCESS;
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_RUNTIME_CONST_TENSOR_PACKER_H
+#define NEURAL_NETWORK_RUNTIME_CONST_TENSOR_PACKER_H
+
+#include <vector>
+
+#include "mindir.h"
+#include "interfaces/kits/c/neural_network_runtime/neural_network_runtime_type.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+const size_t DEFAULT_CONST_TENSOR_ALIGNMENT = 64;
+const size_t MAX_CONST_TENSOR_ALIGNMENT = 4096;
+
+struct ConstTensorLayout {
+    size_t offset {0};
+    size_t dataSize {0};
+};
+
+// Packs the data of the constant tensors of a LiteGraph into the shared buffer sent to the device, with every tensor
+// starting at an aligned offset. The layout is planned up front from the tensor metadata, so that the tensors of a
+// large model are copied by several threads at once. Graphs whose constants cannot be planned, e.g. of an unknown
+// data type, are packed one after another without alignment as before.
+class ConstTensorPacker {
+public:
+    // alignment must be a power of two which is not larger than MAX_CONST_TENSOR_ALIGNMENT, 0 means the default.
+    ConstTensorPacker(const mindspore::lite::LiteGraph* liteGraph, size_t alignment);
+    ~ConstTensorPacker() = default;
+
+    // Size of the buffer which holds all constants, whichever layout they are packed in.
+    size_t GetBufferSize() const;
+    // layouts gets the place of every tensor of the graph in the buffer, dataSize is 0 for tensors without data.
+    OH_NN_ReturnCode Pack(uint8_t* buffer, size_t bufferSize, std::vector<ConstTensorLayout>& layouts) const;
+
+private:
+    ConstTensorPacker(const ConstTensorPacker&) = delete;
+    ConstTensorPacker& operator=(const ConstTensorPacker&) = delete;
+
+    bool PlanLayouts();
+    OH_NN_ReturnCode PackPlanned(uint8_t* buffer, std::vector<ConstTensorLayout>& layouts) const;
+    bool CopyTensors(uint8_t* buffer, size_t begin, size_t end, std::vector<ConstTensorLayout>& layouts) const;
+    OH_NN_ReturnCode PackSequentially(uint8_t* buffer, size_t bufferSize,
+                                      std::vector<ConstTensorLayout>& layouts) const;
+
+private:
+    const mindspore::lite::LiteGraph* m_liteGraph {nullptr};
+    size_t m_alignment {DEFAULT_CONST_TENSOR_ALIGNMENT};
+    size_t m_constTensorSize {0};
+    bool m_isPlanned {false};
+    // Planned slot of each tensor, the slot size is 0 for the tensors computed by the graph.
+    std::vector<ConstTensorLayout> m_plannedLayouts;
+    size_t m_plannedSize {0};
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_RUNTIME_CONST_TENSOR_PACKER_H
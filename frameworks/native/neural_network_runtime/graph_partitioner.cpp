@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph_partitioner.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <string>
+
+#include "backend_manager.h"
+#include "common/log.h"
+#include "common/utils.h"
+#include "nnbackend.h"
+#include "transform.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace {
+const char PARTITION_SUBGRAPH_NAME[] = "NNRt_SubGraph";
+
+// Nodes supported by several backends go to the device type of the smallest rank.
+int GetDeviceTypeRank(OH_NN_DeviceType deviceType)
+{
+    switch (deviceType) {
+        case OH_NN_ACCELERATOR:
+            return 0;
+        case OH_NN_GPU:
+            return 1;
+        case OH_NN_CPU:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+struct PartitionGraphDeleter {
+    // The partition owns its nodes and subgraphs only, the tensors and primitives belong to the partitioned graph.
+    std::shared_ptr<mindspore::lite::LiteGraph> liteGraph {nullptr};
+
+    void operator()(mindspore::lite::LiteGraph* partitionGraph) const
+    {
+        for (auto node : partitionGraph->all_nodes_) {
+            delete node;
+        }
+        for (auto subGraph : partitionGraph->sub_graphs_) {
+            delete subGraph;
+        }
+        partitionGraph->all_nodes_.clear();
+        partitionGraph->sub_graphs_.clear();
+        partitionGraph->all_tensors_.clear();
+        delete partitionGraph;
+    }
+};
+
+std::shared_ptr<TensorDesc> CreateTensorDesc(const mindspore::lite::TensorPtr tensor)
+{
+    std::shared_ptr<TensorDesc> tensorDesc = CreateSharedPtr<TensorDesc>();
+    if (tensorDesc == nullptr) {
+        LOGE("[GraphPartitioner] Failed to create tensor desc.");
+        return nullptr;
+    }
+
+    std::string name = mindspore::lite::MindIR_Tensor_GetName(tensor);
+    std::vector<int32_t> dims = mindspore::lite::MindIR_Tensor_GetDims(tensor);
+    tensorDesc->SetDataType(MSToNN::TransformDataType(mindspore::lite::MindIR_Tensor_GetDataType(tensor)));
+    tensorDesc->SetFormat(MSToNN::TransformFormat(mindspore::lite::MindIR_Tensor_GetFormat(tensor)));
+    tensorDesc->SetName(name.c_str());
+    if (!dims.empty()) {
+        tensorDesc->SetShape(dims.data(), dims.size());
+    }
+    return tensorDesc;
+}
+
+bool IsStaticShape(const mindspore::lite::TensorPtr tensor)
+{
+    std::vector<int32_t> dims = mindspore::lite::MindIR_Tensor_GetDims(tensor);
+    return !dims.empty() && std::all_of(dims.begin(), dims.end(), [](int32_t dim) { return dim > 0; });
+}
+}
+
+GraphPartitioner::GraphPartitioner(const std::shared_ptr<mindspore::lite::LiteGraph>& liteGraph,
+    size_t preferredBackendID)
+    : m_liteGraph(liteGraph),
+    m_preferredBackendID(preferredBackendID) {}
+
+OH_NN_ReturnCode GraphPartitioner::Partition(std::vector<GraphPartition>& partitions) const
+{
+    OH_NN_ReturnCode ret = CheckGraph();
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[GraphPartitioner] Partition failed, the graph is invalid.");
+        return ret;
+    }
+
+    std::vector<size_t> nodeBackendIDs;
+    ret = AssignNodes(nodeBackendIDs);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[GraphPartitioner] Partition failed, failed to assign the nodes to backends.");
+        return ret;
+    }
+
+    std::vector<TensorUsage> usages;
+    GetTensorUsages(usages);
+
+    partitions.clear();
+    size_t nodeNum = m_liteGraph->all_nodes_.size();
+    size_t beginNode = 0;
+    for (size_t i = 1; i <= nodeNum; ++i) {
+        if ((i < nodeNum) && (nodeBackendIDs[i] == nodeBackendIDs[beginNode])) {
+            continue;
+        }
+
+        GraphPartition partition;
+        partition.backendID = nodeBackendIDs[beginNode];
+        ret = CreatePartition(beginNode, i, usages, partition);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("[GraphPartitioner] Partition failed, failed to create the partition of nodes [%{public}zu, "
+                 "%{public}zu).", beginNode, i);
+            partitions.clear();
+            return ret;
+        }
+        partitions.emplace_back(std::move(partition));
+        beginNode = i;
+    }
+
+    LOGI("[GraphPartitioner] Split the graph of %{public}zu nodes into %{public}zu partitions.", nodeNum,
+         partitions.size());
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode GraphPartitioner::CheckGraph() const
+{
+    if ((m_liteGraph == nullptr) || m_liteGraph->all_nodes_.empty()) {
+        LOGE("[GraphPartitioner] The graph is nullptr or has no node.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    size_t tensorNum = m_liteGraph->all_tensors_.size();
+    auto isValidIndex = [tensorNum](uint32_t index) { return index < tensorNum; };
+    for (const auto node : m_liteGraph->all_nodes_) {
+        if ((node == nullptr) || (node->primitive_ == nullptr)) {
+            LOGE("[GraphPartitioner] Node or its primitive is nullptr.");
+            return OH_NN_NULL_PTR;
+        }
+        if (!std::all_of(node->input_indices_.begin(), node->input_indices_.end(), isValidIndex) ||
+            !std::all_of(node->output_indices_.begin(), node->output_indices_.end(), isValidIndex)) {
+            LOGE("[GraphPartitioner] Tensor index of node %{public}s exceeds the tensor number.", node->name_.c_str());
+            return OH_NN_INVALID_PARAMETER;
+        }
+    }
+
+    if (!std::all_of(m_liteGraph->input_indices_.begin(), m_liteGraph->input_indices_.end(), isValidIndex) ||
+        !std::all_of(m_liteGraph->output_indices_.begin(), m_liteGraph->output_indices_.end(), isValidIndex)) {
+        LOGE("[GraphPartitioner] Input or output index of the graph exceeds the tensor number.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    return OH_NN_SUCCESS;
+}
+
+void GraphPartitioner::GetBackendsByPriority(std::vector<size_t>& backendIDs) const
+{
+    BackendManager& backendManager = BackendManager::GetInstance();
+    std::vector<std::pair<int, size_t>> rankedBackendIDs;
+    for (size_t backendID : backendManager.GetAllBackendsID()) {
+        std::shared_ptr<Backend> backend = backendManager.GetBackend(backendID);
+        if ((backendID == m_preferredBackendID) || (backend == nullptr)) {
+            continue;
+        }
+
+        DeviceStatus status {UNKNOWN};
+        OH_NN_DeviceType deviceType {OH_NN_OTHERS};
+        if ((backend->GetBackendStatus(status) != OH_NN_SUCCESS) || (status != AVAILABLE) ||
+            (backend->GetBackendType(deviceType) != OH_NN_SUCCESS)) {
+            LOGW("[GraphPartitioner] Backend %{public}zu is not available, it is not used.", backendID);
+            continue;
+        }
+        rankedBackendIDs.emplace_back(GetDeviceTypeRank(deviceType), backendID);
+    }
+
+    std::stable_sort(rankedBackendIDs.begin(), rankedBackendIDs.end(),
+        [](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) { return a.first < b.first; });
+
+    backendIDs.clear();
+    backendIDs.emplace_back(m_preferredBackendID);
+    for (const auto& rankedBackendID : rankedBackendIDs) {
+        backendIDs.emplace_back(rankedBackendID.second);
+    }
+}
+
+OH_NN_ReturnCode GraphPartitioner::AssignNodes(std::vector<size_t>& nodeBackendIDs) const
+{
+    std::vector<size_t> backendIDs;
+    GetBackendsByPriority(backendIDs);
+
+    size_t nodeNum = m_liteGraph->all_nodes_.size();
+    std::vector<bool> isAssigned(nodeNum, false);
+    size_t assignedNum = 0;
+    nodeBackendIDs.assign(nodeNum, m_preferredBackendID);
+    BackendManager& backendManager = BackendManager::GetInstance();
+    for (size_t backendID : backendIDs) {
+        if (assignedNum == nodeNum) {
+            break;
+        }
+
+        std::shared_ptr<Backend> backend = backendManager.GetBackend(backendID);
+        if (backend == nullptr) {
+            LOGW("[GraphPartitioner] Failed to get backend %{public}zu, it is not used.", backendID);
+            continue;
+        }
+
+        std::shared_ptr<NNBackend> nnBackend = std::reinterpret_pointer_cast<NNBackend>(backend);
+        std::vector<bool> supportedList;
+        OH_NN_ReturnCode ret = nnBackend->GetSupportedOperation(m_liteGraph, supportedList);
+        if ((ret != OH_NN_SUCCESS) || (supportedList.size() != nodeNum)) {
+            LOGW("[GraphPartitioner] Failed to get the supported operations of backend %{public}zu, it is not used.",
+                 backendID);
+            continue;
+        }
+
+        for (size_t i = 0; i < nodeNum; ++i) {
+            if (!isAssigned[i] && supportedList[i]) {
+                nodeBackendIDs[i] = backendID;
+                isAssigned[i] = true;
+                ++assignedNum;
+            }
+        }
+    }
+
+    auto unassignedIter = std::find(isAssigned.begin(), isAssigned.end(), false);
+    if (unassignedIter != isAssigned.end()) {
+        size_t nodeIndex = static_cast<size_t>(unassignedIter - isAssigned.begin());
+        LOGE("[GraphPartitioner] Node %{public}s is not supported by any backend.",
+             m_liteGraph->all_nodes_[nodeIndex]->name_.c_str());
+        return OH_NN_FAILED;
+    }
+    return OH_NN_SUCCESS;
+}
+
+void GraphPartitioner::GetTensorUsages(std::vector<TensorUsage>& usages) const
+{
+    usages.assign(m_liteGraph->all_tensors_.size(), TensorUsage());
+    for (uint32_t index : m_liteGraph->input_indices_) {
+        usages[index].isGraphInput = true;
+    }
+    for (uint32_t index : m_liteGraph->output_indices_) {
+        usages[index].isGraphOutput = true;
+    }
+
+    for (size_t i = 0; i < m_liteGraph->all_nodes_.size(); ++i) {
+        const auto node = m_liteGraph->all_nodes_[i];
+        for (uint32_t index : node->input_indices_) {
+            usages[index].hasConsumer = true;
+            usages[index].lastConsumer = i;
+        }
+        for (uint32_t index : node->output_indices_) {
+            usages[index].hasProducer = true;
+            usages[index].producer = i;
+        }
+    }
+}
+
+OH_NN_ReturnCode GraphPartitioner::CreatePartition(size_t beginNode, size_t endNode,
+    const std::vector<TensorUsage>& usages, GraphPartition& partition) const
+{
+    mindspore::lite::LiteGraph* partitionGraph = new (std::nothrow) mindspore::lite::LiteGraph();
+    if (partitionGraph == nullptr) {
+        LOGE("[GraphPartitioner] Failed to create the graph of the partition.");
+        return OH_NN_MEMORY_ERROR;
+    }
+    std::shared_ptr<mindspore::lite::LiteGraph> liteGraph(partitionGraph, PartitionGraphDeleter {m_liteGraph});
+    liteGraph->name_ = m_liteGraph->name_ + ":" + std::to_string(beginNode);
+
+    // Index of every tensor of the partition in all_tensors_ of the partitioned graph and of the partition
+    std::map<uint32_t, uint32_t> tensorIndices;
+    auto getPartitionIndex = [this, &liteGraph, &tensorIndices](uint32_t index) {
+        auto iter = tensorIndices.find(index);
+        if (iter != tensorIndices.end()) {
+            return iter->second;
+        }
+        uint32_t partitionIndex = static_cast<uint32_t>(liteGraph->all_tensors_.size());
+        liteGraph->all_tensors_.emplace_back(m_liteGraph->all_tensors_[index]);
+        tensorIndices.emplace(index, partitionIndex);
+        return partitionIndex;
+    };
+    auto addUniqueIndex = [](std::vector<uint32_t>& indices, uint32_t index) {
+        if (std::find(indices.begin(), indices.end(), index) == indices.end()) {
+            indices.emplace_back(index);
+        }
+    };
+
+    for (size_t i = beginNode; i < endNode; ++i) {
+        const auto origin = m_liteGraph->all_nodes_[i];
+        // Tensors neither produced by a node nor fed as graph inputs are constants, copied into the partition.
+        for (uint32_t index : origin->input_indices_) {
+            const TensorUsage& usage = usages[index];
+            if (usage.hasProducer && (usage.producer >= endNode)) {
+                LOGE("[GraphPartitioner] Node %{public}s consumes a tensor produced by a later node, the nodes are not "
+                     "in topological order.", origin->name_.c_str());
+                return OH_NN_INVALID_PARAMETER;
+            }
+            if (usage.isGraphInput || (usage.hasProducer && (usage.producer < beginNode))) {
+                addUniqueIndex(partition.inputIndices, index);
+            }
+        }
+        for (uint32_t index : origin->output_indices_) {
+            const TensorUsage& usage = usages[index];
+            if (usage.isGraphOutput || (usage.hasConsumer && (usage.lastConsumer >= endNode))) {
+                addUniqueIndex(partition.outputIndices, index);
+            }
+        }
+
+        mindspore::lite::LiteGraph::Node* node = new (std::nothrow) mindspore::lite::LiteGraph::Node(*origin);
+        if (node == nullptr) {
+            LOGE("[GraphPartitioner] Failed to create the node of the partition.");
+            return OH_NN_MEMORY_ERROR;
+        }
+        liteGraph->all_nodes_.emplace_back(node);
+        std::transform(node->input_indices_.begin(), node->input_indices_.end(), node->input_indices_.begin(),
+            getPartitionIndex);
+        std::transform(node->output_indices_.begin(), node->output_indices_.end(), node->output_indices_.begin(),
+            getPartitionIndex);
+    }
+
+    std::transform(partition.inputIndices.begin(), partition.inputIndices.end(),
+        std::back_inserter(liteGraph->input_indices_), getPartitionIndex);
+    std::transform(partition.outputIndices.begin(), partition.outputIndices.end(),
+        std::back_inserter(liteGraph->output_indices_), getPartitionIndex);
+
+    mindspore::lite::LiteGraph::SubGraph* subGraph = new (std::nothrow) mindspore::lite::LiteGraph::SubGraph();
+    if (subGraph == nullptr) {
+        LOGE("[GraphPartitioner] Failed to create the subgraph of the partition.");
+        return OH_NN_MEMORY_ERROR;
+    }
+    liteGraph->sub_graphs_.emplace_back(subGraph);
+    subGraph->name_ = PARTITION_SUBGRAPH_NAME;
+    subGraph->input_indices_ = liteGraph->input_indices_;
+    subGraph->output_indices_ = liteGraph->output_indices_;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(liteGraph->all_nodes_.size()); ++i) {
+        subGraph->node_indices_.emplace_back(i);
+    }
+
+    for (size_t i = 0; i < partition.inputIndices.size() + partition.outputIndices.size(); ++i) {
+        bool isInput = i < partition.inputIndices.size();
+        uint32_t index = isInput ? partition.inputIndices[i] :
+            partition.outputIndices[i - partition.inputIndices.size()];
+        const mindspore::lite::TensorPtr tensor = m_liteGraph->all_tensors_[index];
+        // Tensors passed between partitions are allocated before the run, so their sizes must be known.
+        if (!usages[index].isGraphInput && !usages[index].isGraphOutput && !IsStaticShape(tensor)) {
+            LOGE("[GraphPartitioner] Tensor %{public}s passed between partitions has a dynamic shape.",
+                 mindspore::lite::MindIR_Tensor_GetName(tensor).c_str());
+            return OH_NN_OPERATION_FORBIDDEN;
+        }
+
+        std::shared_ptr<TensorDesc> tensorDesc = CreateTensorDesc(tensor);
+        if (tensorDesc == nullptr) {
+            return OH_NN_MEMORY_ERROR;
+        }
+        auto& tensorDescs = isInput ? partition.inputTensorDescs : partition.outputTensorDescs;
+        tensorDescs.emplace_back(tensorDesc, OH_NN_TENSOR);
+    }
+
+    partition.liteGraph = liteGraph;
+    return OH_NN_SUCCESS;
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_RUNTIME_GRAPH_PARTITIONER_H
+#define NEURAL_NETWORK_RUNTIME_GRAPH_PARTITIONER_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "mindir.h"
+#include "tensor_desc.h"
+#include "interfaces/kits/c/neural_network_runtime/neural_network_runtime_type.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+struct GraphPartition {
+    size_t backendID {0};
+    // Shares the tensors and primitives of the partitioned graph, which it keeps alive.
+    std::shared_ptr<mindspore::lite::LiteGraph> liteGraph {nullptr};
+    // Indices of the inputs and outputs of the partition in all_tensors_ of the partitioned graph
+    std::vector<uint32_t> inputIndices;
+    std::vector<uint32_t> outputIndices;
+    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> inputTensorDescs;
+    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> outputTensorDescs;
+};
+
+// Splits a LiteGraph into the maximal runs of consecutive nodes supported by the same backend. Every node goes to the
+// first backend supporting it, the preferred backend first, then accelerators, GPUs, other devices and CPUs. The
+// nodes of the graph must be in topological order, and the tensors passed between partitions must have static shapes.
+class GraphPartitioner {
+public:
+    GraphPartitioner(const std::shared_ptr<mindspore::lite::LiteGraph>& liteGraph, size_t preferredBackendID);
+    ~GraphPartitioner() = default;
+
+    OH_NN_ReturnCode Partition(std::vector<GraphPartition>& partitions) const;
+
+private:
+    struct TensorUsage {
+        bool isGraphInput {false};
+        bool isGraphOutput {false};
+        bool hasProducer {false};
+        size_t producer {0};
+        bool hasConsumer {false};
+        size_t lastConsumer {0};
+    };
+
+    OH_NN_ReturnCode CheckGraph() const;
+    void GetBackendsByPriority(std::vector<size_t>& backendIDs) const;
+    OH_NN_ReturnCode AssignNodes(std::vector<size_t>& nodeBackendIDs) const;
+    void GetTensorUsages(std::vector<TensorUsage>& usages) const;
+    OH_NN_ReturnCode CreatePartition(size_t beginNode,
+                                     size_t endNode,
+                                     const std::vector<TensorUsage>& usages,
+                                     GraphPartition& partition) const;
+
+private:
+    std::shared_ptr<mindspore::lite::LiteGraph> m_liteGraph {nullptr};
+    size_t m_preferredBackendID {0};
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_RUNTIME_GRAPH_PARTITIONER_H
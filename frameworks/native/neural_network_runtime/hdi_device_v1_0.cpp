@@ -154,32 +154,16 @@ OH_NN_ReturnCode HDIDeviceV1_0::GetSupportedOperation(std::shared_ptr<const mind
         return OH_NN_NULL_PTR;
     }
 
-    OHOS::HDI::Nnrt::V1_0::SharedBuffer tensorBuffer {INVALID_FD, 0, 0, 0};
-    size_t tensorSize = mindspore::lite::MindIR_LiteGraph_GetConstTensorSize(model.get());
-    int32_t hdiRet {0};
-    if (tensorSize > 0) {
-        hdiRet = m_iDevice->AllocateBuffer(tensorSize, tensorBuffer);
-        if (hdiRet != HDF_SUCCESS || tensorBuffer.fd == INVALID_FD) {
-            LOGE("Allocate tensor buffer error when get supported operation. ErrorCode: %d", hdiRet);
-            return OH_NN_FAILED;
-        }
-    }
-
-    auto iModel = V1::LiteGraph_To_HDIModel(model.get(), tensorBuffer);
+    // The device only checks the nodes, so the weights are neither allocated on the device nor copied.
+    auto iModel = V1::LiteGraph_To_HDITopologyModel(model.get());
     if (iModel == nullptr) {
         LOGE("Parse litegraph to hdi model failed.");
-        ReleaseSharedBuffer(tensorBuffer);
         return OH_NN_FAILED;
     }
 
-    hdiRet = m_iDevice->GetSupportedOperation(*iModel, ops);
+    int32_t hdiRet = m_iDevice->GetSupportedOperation(*iModel, ops);
 
     V1::HDIModel_Destroy(&iModel);
-    auto ret = ReleaseSharedBuffer(tensorBuffer);
-    if (ret != OH_NN_SUCCESS) {
-        LOGE("Release tensorBuffer failed.");
-        return OH_NN_FAILED;
-    }
     if (hdiRet != HDF_SUCCESS) {
         LOGE("Get supported operation failed. ErrorCode=%d", hdiRet);
         return OH_NN_UNAVAILABLE_DEVICE;
@@ -306,8 +290,17 @@ OH_NN_ReturnCode HDIDeviceV1_0::PrepareModelFromModelCache(const std::vector<Buf
     auto memManager = MemoryManager::GetInstance();
     Memory memory;
     OH_NN_ReturnCode ret;
+    bool isFileShared {false};
     size_t modelCacheSize = modelCache.size();
     for (size_t i = 0; i < modelCacheSize; i++) {
+        // The cache is mapped from a file, share the file region with the device instead of copying it.
+        if (modelCache[i].fd != INVALID_FD) {
+            isFileShared = true;
+            iBuffers.emplace_back(V1_0::SharedBuffer {modelCache[i].fd, modelCache[i].offset + modelCache[i].length,
+                modelCache[i].offset, modelCache[i].length});
+            continue;
+        }
+
         ret = memManager->GetMemory(modelCache[i].data, memory);
         if (ret != OH_NN_SUCCESS) {
             LOGE("The %zuth model cache is invalid. Please put valid model cache.", i + 1);
@@ -323,6 +316,11 @@ OH_NN_ReturnCode HDIDeviceV1_0::PrepareModelFromModelCache(const std::vector<Buf
 
     OHOS::sptr<V1_0::IPreparedModel> iPreparedModel;
     auto hdiRet = m_iDevice->PrepareModelFromModelCache(iBuffers, iModelConfig, iPreparedModel);
+    if (isFileShared && (hdiRet == HDF_ERR_INVALID_PARAM)) {
+        // Let the caller copy the caches into device memory and try again.
+        LOGW("Prepare model from cache failed, the device cannot map the cache file.");
+        return OH_NN_UNSUPPORTED;
+    }
     if (hdiRet != HDF_SUCCESS) {
         LOGE("Prepare model from cache failed. ErrorCode=%d", hdiRet);
         return OH_NN_UNAVAILABLE_DEVICE;
@@ -21,6 +21,7 @@
 
 #include "hdi_prepared_model_v2_1.h"
 #include "lite_graph_to_hdi_model_v2_1.h"
+#include "const_tensor_packer.h"
 #include "hdi_returncode_utils_v2_1.h"
 #include "memory_manager.h"
 #include "transform.h"
@@ -200,31 +201,16 @@ OH_NN_ReturnCode HDIDeviceV2_1::GetSupportedOperation(std::shared_ptr<const mind
         return OH_NN_SUCCESS;
     }
 
-    OHOS::HDI::Nnrt::V2_1::SharedBuffer tensorBuffer {INVALID_FD, 0, 0, 0};
-    size_t tensorSize = mindspore::lite::MindIR_LiteGraph_GetConstTensorSize(model.get());
-    int32_t ret {0};
-    if (tensorSize > 0) {
-        ret = m_iDevice->AllocateBuffer(tensorSize, tensorBuffer);
-        if (ret != V2_1::NNRT_ReturnCode::NNRT_SUCCESS || tensorBuffer.fd == INVALID_FD) {
-            return CheckReturnCode_V2_1(ret, OH_NN_FAILED, "Allocate tensor buffer error when get supported operation");
-        }
-    }
-
-    auto iModel = NNRt_V2_1::LiteGraph_To_HDIModel(model.get(), tensorBuffer);
+    // The device only checks the nodes, so the weights are neither allocated on the device nor copied.
+    auto iModel = NNRt_V2_1::LiteGraph_To_HDITopologyModel(model);
     if (iModel == nullptr) {
         LOGE("Parse litegraph to hdi model failed.");
-        ReleaseSharedBuffer(tensorBuffer);
         return OH_NN_FAILED;
     }
 
-    ret = m_iDevice->GetSupportedOperation(*iModel, ops);
+    int32_t ret = m_iDevice->GetSupportedOperation(*iModel, ops);
 
     NNRt_V2_1::HDIModel_Destroy(&iModel);
-    innerRet = ReleaseSharedBuffer(tensorBuffer);
-    if (innerRet != OH_NN_SUCCESS) {
-        LOGE("Release tensorBuffer failed.");
-        return OH_NN_FAILED;
-    }
     if (ret != V2_1::NNRT_ReturnCode::NNRT_SUCCESS) {
         return CheckReturnCode_V2_1(ret, OH_NN_UNAVAILABLE_DEVICE, "Get supported operation failed");
     }
@@ -284,8 +270,9 @@ OH_NN_ReturnCode HDIDeviceV2_1::PrepareModel(std::shared_ptr<const mindspore::li
         return OH_NN_INVALID_PARAMETER;
     }
 
+    // The buffer leaves room for aligning every constant tensor, the layout is planned again by the conversion.
     OHOS::HDI::Nnrt::V2_1::SharedBuffer tensorBuffer {INVALID_FD, 0, 0, 0};
-    size_t tensorSize = mindspore::lite::MindIR_LiteGraph_GetConstTensorSize(model.get());
+    size_t tensorSize = ConstTensorPacker(model.get(), config.constTensorAlignment).GetBufferSize();
     int32_t ret {0};
     if (tensorSize > 0) {
         ret = m_iDevice->AllocateBuffer(tensorSize, tensorBuffer);
@@ -294,7 +281,7 @@ OH_NN_ReturnCode HDIDeviceV2_1::PrepareModel(std::shared_ptr<const mindspore::li
         }
     }
 
-    V2_1::Model* iModel = NNRt_V2_1::LiteGraph_To_HDIModel(model.get(), tensorBuffer);
+    V2_1::Model* iModel = NNRt_V2_1::LiteGraph_To_HDIModel(model, tensorBuffer, config.constTensorAlignment);
     if (iModel == nullptr) {
         LOGE("Parse litegraph to hdi model failed.");
         ReleaseSharedBuffer(tensorBuffer);
@@ -305,6 +292,7 @@ OH_NN_ReturnCode HDIDeviceV2_1::PrepareModel(std::shared_ptr<const mindspore::li
     iModelConfig.enableFloat16 = config.enableFloat16;
     iModelConfig.mode = TransPerformanceMode(config.mode);
     iModelConfig.priority = TransPriority(config.priority);
+    iModelConfig.extensions = config.extensions;
     OHOS::sptr<V2_1::IPreparedModel> iPreparedModel;
 
     ret = m_iDevice->PrepareModel(*iModel, iModelConfig, iPreparedModel);
@@ -343,8 +331,17 @@ OH_NN_ReturnCode HDIDeviceV2_1::PrepareModelFromModelCache(const std::vector<Buf
     auto memManager = MemoryManager::GetInstance();
     Memory memory;
     OH_NN_ReturnCode ret;
+    bool isFileShared {false};
     size_t modelCacheSize = modelCache.size();
     for (size_t i = 0; i < modelCacheSize; i++) {
+        // The cache is mapped from a file, share the file region with the device instead of copying it.
+        if (modelCache[i].fd != INVALID_FD) {
+            isFileShared = true;
+            iBuffers.emplace_back(V2_1::SharedBuffer {modelCache[i].fd, modelCache[i].offset + modelCache[i].length,
+                modelCache[i].offset, modelCache[i].length});
+            continue;
+        }
+
         ret = memManager->GetMemory(modelCache[i].data, memory);
         if (ret != OH_NN_SUCCESS) {
             LOGE("The %{public}zuth model cache is invalid. Please put valid model cache.", i + 1);
@@ -357,9 +354,15 @@ OH_NN_ReturnCode HDIDeviceV2_1::PrepareModelFromModelCache(const std::vector<Buf
     iModelConfig.enableFloat16 = config.enableFloat16;
     iModelConfig.mode = TransPerformanceMode(config.mode);
     iModelConfig.priority = TransPriority(config.priority);
+    iModelConfig.extensions = config.extensions;
 
     OHOS::sptr<V2_1::IPreparedModel> iPreparedModel;
     auto nnrtRet = m_iDevice->PrepareModelFromModelCache(iBuffers, iModelConfig, iPreparedModel);
+    if (isFileShared && (nnrtRet == V2_1::NNRT_ReturnCode::NNRT_INVALID_BUFFER)) {
+        // Let the caller copy the caches into device memory and try again.
+        LOGW("Prepare model from cache failed, the device cannot map the cache file.");
+        return OH_NN_UNSUPPORTED;
+    }
     if (nnrtRet != V2_1::NNRT_ReturnCode::NNRT_SUCCESS) {
         return CheckReturnCode_V2_1(nnrtRet, OH_NN_FAILED, "Prepare model from cache failed");
     }
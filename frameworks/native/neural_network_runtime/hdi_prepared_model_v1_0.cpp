@@ -152,7 +152,9 @@ OH_NN_ReturnCode TransIOTensor(const NN_Tensor* tensor, V1_0::IOTensor& ioTensor
         LOGE("TransIOTensor failed, failed to check tensor data.");
         return OH_NN_INVALID_PARAMETER;
     }
-    V1_0::SharedBuffer iBuffer {nnTensor->GetFd(), nnTensor->GetSize(), nnTensor->GetOffset(), nnTensor->GetSize()};
+    size_t slabOffset = nnTensor->GetSlabOffset();
+    V1_0::SharedBuffer iBuffer {nnTensor->GetFd(), slabOffset + nnTensor->GetSize(), slabOffset + nnTensor->GetOffset(),
+        nnTensor->GetDataSize()};
     ioTensor.data = iBuffer;
 
     return OH_NN_SUCCESS;
@@ -218,6 +220,8 @@ OH_NN_ReturnCode HDIPreparedModelV1_0::Run(const std::vector<IOTensor>& inputs,
         iOutputTensors.emplace_back(iTensor);
     }
 
+    outputsDims.clear();
+    isOutputBufferEnough.clear();
     auto ret = m_hdiPreparedModel->Run(iInputTensors, iOutputTensors, outputsDims, isOutputBufferEnough);
     if (ret != HDF_SUCCESS || outputsDims.empty()) {
         LOGE("Run model failed. ErrorCode=%d", ret);
@@ -260,6 +264,8 @@ OH_NN_ReturnCode HDIPreparedModelV1_0::Run(const std::vector<NN_Tensor*>& inputs
         iOutputTensors.emplace_back(iTensor);
     }
 
+    outputsDims.clear();
+    isOutputBufferEnough.clear();
     auto ret = m_hdiPreparedModel->Run(iInputTensors, iOutputTensors, outputsDims, isOutputBufferEnough);
     if (ret != HDF_SUCCESS || outputsDims.empty()) {
         LOGE("Run model failed. ErrorCode=%d", ret);
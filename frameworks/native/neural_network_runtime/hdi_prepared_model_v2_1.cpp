@@ -15,6 +15,8 @@
 
 #include "hdi_prepared_model_v2_1.h"
 
+#include <algorithm>
+
 #include "common/log.h"
 #include "hdi_returncode_utils_v2_1.h"
 #include "memory_manager.h"
@@ -153,11 +155,53 @@ OH_NN_ReturnCode TransIOTensor(const NN_Tensor* tensor, V2_1::IOTensor& ioTensor
         LOGE("TransIOTensor failed, failed to check tensor data.");
         return OH_NN_INVALID_PARAMETER;
     }
-    V2_1::SharedBuffer iBuffer {nnTensor->GetFd(), nnTensor->GetSize(), nnTensor->GetOffset(), nnTensor->GetSize()};
+    size_t slabOffset = nnTensor->GetSlabOffset();
+    V2_1::SharedBuffer iBuffer {nnTensor->GetFd(), slabOffset + nnTensor->GetSize(), slabOffset + nnTensor->GetOffset(),
+        nnTensor->GetDataSize()};
     ioTensor.data = iBuffer;
 
     return OH_NN_SUCCESS;
 }
+
+OH_NN_ReturnCode TransIOTensors(const std::vector<NN_Tensor*>& tensors, std::vector<V2_1::IOTensor>& iTensors)
+{
+    iTensors.clear();
+    V2_1::IOTensor iTensor;
+    for (const auto& tensor : tensors) {
+        auto ret = TransIOTensor(tensor, iTensor);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("TransIOTensors failed, failed to transform to ioTensor.");
+            return ret;
+        }
+        if (iTensor.data.fd == INVALID_FD) {
+            LOGE("TransIOTensors failed, cannot find data file descriptor.");
+            return OH_NN_INVALID_PARAMETER;
+        }
+        iTensors.emplace_back(iTensor);
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode UpdateIOTensorShape(const NN_Tensor* tensor, V2_1::IOTensor& ioTensor)
+{
+    TensorDesc* nnTensorDesc = reinterpret_cast<const NNTensor2_0*>(tensor)->GetTensorDesc();
+    if (nnTensorDesc == nullptr) {
+        LOGE("UpdateIOTensorShape failed, failed to get desc from tensor.");
+        return OH_NN_NULL_PTR;
+    }
+
+    int32_t* shape = nullptr;
+    size_t shapeNum = 0;
+    OH_NN_ReturnCode ret = nnTensorDesc->GetShape(&shape, &shapeNum);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("UpdateIOTensorShape failed, failed to get shape from desc.");
+        return ret;
+    }
+    if (shapeNum != ioTensor.dimensions.size() || !std::equal(shape, shape + shapeNum, ioTensor.dimensions.begin())) {
+        ioTensor.dimensions.assign(shape, shape + shapeNum);
+    }
+    return OH_NN_SUCCESS;
+}
 } // unamed namespace
 
 HDIPreparedModelV2_1::HDIPreparedModelV2_1(OHOS::sptr<V2_1::IPreparedModel> hdiPreparedModel)
@@ -218,6 +262,7 @@ OH_NN_ReturnCode HDIPreparedModelV2_1::Run(const std::vector<IOTensor>& inputs,
         iOutputTensors.emplace_back(iTensor);
     }
 
+    outputsDims.clear();
     auto ret = m_hdiPreparedModel->Run(iInputTensors, iOutputTensors, outputsDims);
     if (ret != V2_1::NNRT_ReturnCode::NNRT_SUCCESS) {
         return CheckReturnCode_V2_1(ret, OH_NN_UNAVAILABLE_DEVICE, "Run model failed");
@@ -234,6 +279,7 @@ OH_NN_ReturnCode HDIPreparedModelV2_1::Run(const std::vector<NN_Tensor*>& inputs
     const std::vector<NN_Tensor*>& outputs, std::vector<std::vector<int32_t>>& outputsDims,
     std::vector<bool>& isOutputBufferEnough)
 {
+    isOutputBufferEnough.clear();
     V2_1::IOTensor iTensor;
     std::vector<V2_1::IOTensor> iInputTensors;
     for (const auto& input: inputs) {
@@ -263,7 +309,12 @@ OH_NN_ReturnCode HDIPreparedModelV2_1::Run(const std::vector<NN_Tensor*>& inputs
         iOutputTensors.emplace_back(iTensor);
     }
 
+    outputsDims.clear();
     auto ret = m_hdiPreparedModel->Run(iInputTensors, iOutputTensors, outputsDims);
+    if (ret == V2_1::NNRT_ReturnCode::NNRT_INSUFFICIENT_BUFFER) {
+        // Every output is reported as not large enough, the dims of the outputs are kept if the device returns them.
+        isOutputBufferEnough.assign(outputs.size(), false);
+    }
     if (ret != V2_1::NNRT_ReturnCode::NNRT_SUCCESS) {
         return CheckReturnCode_V2_1(ret, OH_NN_UNAVAILABLE_DEVICE, "Run model failed");
     }
@@ -285,5 +336,102 @@ OH_NN_ReturnCode HDIPreparedModelV2_1::GetInputDimRanges(std::vector<std::vector
 
     return OH_NN_SUCCESS;
 }
+
+OH_NN_ReturnCode HDIPreparedModelV2_1::BindIOTensors(const std::vector<NN_Tensor*>& inputs,
+    const std::vector<NN_Tensor*>& outputs, size_t& bindingId)
+{
+    auto binding = std::make_shared<IOBinding>();
+    binding->inputs = inputs;
+    binding->outputs = outputs;
+    auto ret = TransIOTensors(inputs, binding->iInputTensors);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("BindIOTensors failed, failed to transform inputs.");
+        return ret;
+    }
+    ret = TransIOTensors(outputs, binding->iOutputTensors);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("BindIOTensors failed, failed to transform outputs.");
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> lock(m_bindingMtx);
+    bindingId = m_nextBindingId++;
+    m_ioBindings.emplace(bindingId, binding);
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode HDIPreparedModelV2_1::RunWithBinding(size_t bindingId,
+    std::vector<std::vector<int32_t>>& outputsDims, std::vector<bool>& isOutputBufferEnough)
+{
+    isOutputBufferEnough.clear();
+    std::shared_ptr<IOBinding> binding {nullptr};
+    {
+        std::lock_guard<std::mutex> lock(m_bindingMtx);
+        auto iter = m_ioBindings.find(bindingId);
+        if (iter == m_ioBindings.end()) {
+            LOGE("RunWithBinding failed, binding %{public}zu does not exist.", bindingId);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        binding = iter->second;
+    }
+
+    // Only the shapes may change between runs, the buffers are converted again only by RebindOutputs.
+    for (size_t i = 0; i < binding->inputs.size(); ++i) {
+        auto ret = UpdateIOTensorShape(binding->inputs[i], binding->iInputTensors[i]);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("RunWithBinding failed, failed to update input %{public}zu.", i);
+            return ret;
+        }
+    }
+    for (size_t i = 0; i < binding->outputs.size(); ++i) {
+        auto ret = UpdateIOTensorShape(binding->outputs[i], binding->iOutputTensors[i]);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("RunWithBinding failed, failed to update output %{public}zu.", i);
+            return ret;
+        }
+    }
+
+    outputsDims.clear();
+    auto ret = m_hdiPreparedModel->Run(binding->iInputTensors, binding->iOutputTensors, outputsDims);
+    if (ret == V2_1::NNRT_ReturnCode::NNRT_INSUFFICIENT_BUFFER) {
+        isOutputBufferEnough.assign(binding->outputs.size(), false);
+    }
+    if (ret != V2_1::NNRT_ReturnCode::NNRT_SUCCESS) {
+        return CheckReturnCode_V2_0(ret, OH_NN_UNAVAILABLE_DEVICE, "Run model failed");
+    }
+    if (outputsDims.empty()) {
+        LOGE("RunWithBinding failed, outputsDims is empty.");
+        return OH_NN_UNAVAILABLE_DEVICE;
+    }
+
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode HDIPreparedModelV2_1::RebindOutputs(size_t bindingId)
+{
+    std::lock_guard<std::mutex> lock(m_bindingMtx);
+    auto iter = m_ioBindings.find(bindingId);
+    if (iter == m_ioBindings.end()) {
+        LOGE("RebindOutputs failed, binding %{public}zu does not exist.", bindingId);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    auto ret = TransIOTensors(iter->second->outputs, iter->second->iOutputTensors);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("RebindOutputs failed, failed to transform outputs.");
+        return ret;
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode HDIPreparedModelV2_1::UnbindIOTensors(size_t bindingId)
+{
+    std::lock_guard<std::mutex> lock(m_bindingMtx);
+    if (m_ioBindings.erase(bindingId) == 0) {
+        LOGE("UnbindIOTensors failed, binding %{public}zu does not exist.", bindingId);
+        return OH_NN_INVALID_PARAMETER;
+    }
+    return OH_NN_SUCCESS;
+}
 } // namespace NeuralNetworkRuntime
 } // OHOS
@@ -17,6 +17,9 @@
 #ifndef NEURAL_NETWORK_RUNTIME_HDI_PREPARED_MODEL_V2_1_H
 #define NEURAL_NETWORK_RUNTIME_HDI_PREPARED_MODEL_V2_1_H
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <v2_1/innrt_device.h>
@@ -50,10 +53,28 @@ public:
     OH_NN_ReturnCode GetInputDimRanges(std::vector<std::vector<uint32_t>>& minInputDims,
                                        std::vector<std::vector<uint32_t>>& maxInputDims) override;
 
+    OH_NN_ReturnCode BindIOTensors(const std::vector<NN_Tensor*>& inputs,
+                                   const std::vector<NN_Tensor*>& outputs,
+                                   size_t& bindingId) override;
+    OH_NN_ReturnCode RunWithBinding(size_t bindingId, std::vector<std::vector<int32_t>>& outputsDims,
+                                    std::vector<bool>& isOutputBufferEnough) override;
+    OH_NN_ReturnCode RebindOutputs(size_t bindingId) override;
+    OH_NN_ReturnCode UnbindIOTensors(size_t bindingId) override;
+
 private:
+    struct IOBinding {
+        std::vector<NN_Tensor*> inputs;
+        std::vector<NN_Tensor*> outputs;
+        std::vector<V2_1::IOTensor> iInputTensors;
+        std::vector<V2_1::IOTensor> iOutputTensors;
+    };
+
     // first: major version, second: minor version
     std::pair<uint32_t, uint32_t> m_hdiVersion;
     OHOS::sptr<V2_1::IPreparedModel> m_hdiPreparedModel {nullptr};
+    std::unordered_map<size_t, std::shared_ptr<IOBinding>> m_ioBindings;
+    size_t m_nextBindingId {0};
+    std::mutex m_bindingMtx;
 };
 } // namespace NeuralNetworkRuntime
 } // OHOS
@@ -18,6 +18,8 @@
 #include <new>
 #include <unordered_map>
 #include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "securec.h"
 
@@ -270,8 +272,7 @@ OH_NN_ReturnCode InnerModel::SetTensorQuantParam(uint32_t index, const NN_QuantP
     return returnCode;
 }
 
-// DOTO: 圈复杂度待优化
-OH_NN_ReturnCode InnerModel::SetTensorValue(uint32_t index, const void* buffer, size_t length)
+OH_NN_ReturnCode InnerModel::ValidateTensorValue(uint32_t index, size_t length) const
 {
     if (IsBuild()) {
         LOGE("SetTensorValue failed, SetTensorValue is forbidden after model has been built.");
@@ -289,11 +290,6 @@ OH_NN_ReturnCode InnerModel::SetTensorValue(uint32_t index, const void* buffer,
         return OH_NN_INVALID_PARAMETER;
     }
 
-    if (buffer == nullptr) {
-        LOGW("SetTensorValue passed empty buffer, which makes no effect.");
-        return OH_NN_SUCCESS;
-    }
-
     if (tensor->IsDynamicShape()) {
         LOGE("SetTensorValue failed, cannot set value to tensor with dynamic shape.");
         return OH_NN_OPERATION_FORBIDDEN;
@@ -305,6 +301,21 @@ OH_NN_ReturnCode InnerModel::SetTensorValue(uint32_t index, const void* buffer,
         return OH_NN_INVALID_PARAMETER;
     }
 
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode InnerModel::SetTensorValue(uint32_t index, const void* buffer, size_t length)
+{
+    OH_NN_ReturnCode ret = ValidateTensorValue(index, length);
+    if (ret != OH_NN_SUCCESS) {
+        return ret;
+    }
+
+    if (buffer == nullptr) {
+        LOGW("SetTensorValue passed empty buffer, which makes no effect.");
+        return OH_NN_SUCCESS;
+    }
+
     // Data will be released inside NNTensor if it is set inside NNTensor using SetBuffer().
     void* data = new (std::nothrow) char[length];
     if (data == nullptr) {
@@ -312,14 +323,72 @@ OH_NN_ReturnCode InnerModel::SetTensorValue(uint32_t index, const void* buffer,
         return OH_NN_MEMORY_ERROR;
     }
 
-    errno_t ret = memcpy_s(data, length, buffer, length);
-    if (ret != EOK) {
-        LOGE("SetTensorValue failed, please the information of error number %d from memcpy_s.", ret);
+    errno_t memRet = memcpy_s(data, length, buffer, length);
+    if (memRet != EOK) {
+        LOGE("SetTensorValue failed, please the information of error number %d from memcpy_s.", memRet);
         delete [] reinterpret_cast<char*>(data);
         return OH_NN_FAILED;
     }
 
-    tensor->SetBuffer(data, length);
+    m_allTensors[index]->SetBuffer(data, length);
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode InnerModel::SetTensorValueByReference(uint32_t index, const void* buffer, size_t length)
+{
+    if (buffer == nullptr) {
+        LOGE("SetTensorValueByReference failed, passed nullptr to buffer.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    OH_NN_ReturnCode ret = ValidateTensorValue(index, length);
+    if (ret != OH_NN_SUCCESS) {
+        return ret;
+    }
+
+    // The caller keeps the buffer alive until the model is destroyed, the tensor never releases it.
+    std::shared_ptr<const void> holder(buffer, [](const void*) {});
+    m_allTensors[index]->SetExternalBuffer(buffer, length, holder);
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode InnerModel::SetTensorValueFromFd(uint32_t index, int fd, size_t offset, size_t length)
+{
+    if (fd < 0) {
+        LOGE("SetTensorValueFromFd failed, passed invalid fd %d.", fd);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    OH_NN_ReturnCode ret = ValidateTensorValue(index, length);
+    if (ret != OH_NN_SUCCESS) {
+        return ret;
+    }
+
+    // mmap requires a page aligned offset, map from the page containing offset and skip the leading bytes.
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize <= 0) {
+        LOGE("SetTensorValueFromFd failed, get page size failed.");
+        return OH_NN_FAILED;
+    }
+    size_t alignedOffset = offset - offset % static_cast<size_t>(pageSize);
+    size_t mapLength = length + (offset - alignedOffset);
+    if (mapLength < length) {
+        LOGE("SetTensorValueFromFd failed, offset %zu with length %zu overflows.", offset, length);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    // Map the weights read-only and shared, so that they stay in the page cache instead of private memory.
+    void* mapAddr = mmap(nullptr, mapLength, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(alignedOffset));
+    if (mapAddr == MAP_FAILED) {
+        LOGE("SetTensorValueFromFd failed, mmap fd %d at offset %zu failed.", fd, offset);
+        return OH_NN_MEMORY_ERROR;
+    }
+
+    std::shared_ptr<const void> holder(mapAddr, [mapLength](const void* addr) {
+        munmap(const_cast<void*>(addr), mapLength);
+    });
+    const void* data = static_cast<const char*>(mapAddr) + (offset - alignedOffset);
+    m_allTensors[index]->SetExternalBuffer(data, length, holder);
     return OH_NN_SUCCESS;
 }
 
@@ -437,6 +506,12 @@ OH_NN_ReturnCode InnerModel::AddOperation(OH_NN_OperationType opType, const OH_N
     }
 
     m_ops.emplace_back(std::move(opsBuilder));
+
+    // The parameters are consumed by the ops builder, so the operation is hashed when it is added.
+    m_opsHash = GetXXHash64(&opType, sizeof(opType), m_opsHash);
+    m_opsHash = GetXXHash64(parameters.data(), parameters.size() * sizeof(uint32_t), m_opsHash);
+    m_opsHash = GetXXHash64(inputs.data(), inputs.size() * sizeof(uint32_t), m_opsHash);
+    m_opsHash = GetXXHash64(outputs.data(), outputs.size() * sizeof(uint32_t), m_opsHash);
     return OH_NN_SUCCESS;
 }
 
@@ -610,9 +685,46 @@ OH_NN_ReturnCode InnerModel::Build()
     }
     m_liteGraph->sub_graphs_.emplace_back(subGraph);
 
+    m_constantSize = 0;
+    for (const auto& tensor : m_allTensors) {
+        if (tensor->GetBuffer() != nullptr) {
+            m_constantSize += tensor->GetDataLength();
+        }
+    }
+    m_isHashable = true;
     return OH_NN_SUCCESS;
 }
 
+uint64_t InnerModel::CalculateContentHash() const
+{
+    uint64_t hash = m_opsHash;
+    for (const auto& tensor : m_allTensors) {
+        OH_NN_DataType dataType = tensor->GetDataType();
+        OH_NN_TensorType tensorType = tensor->GetType();
+        OH_NN_Format format = tensor->GetFormat();
+        std::vector<int32_t> dimensions = tensor->GetDimensions();
+        hash = GetXXHash64(&dataType, sizeof(dataType), hash);
+        hash = GetXXHash64(&tensorType, sizeof(tensorType), hash);
+        hash = GetXXHash64(&format, sizeof(format), hash);
+        hash = GetXXHash64(dimensions.data(), dimensions.size() * sizeof(int32_t), hash);
+
+        // Hash the fields one by one, the padding bytes of QuantParam are undefined.
+        for (const auto& quantParam : tensor->GetQuantParam()) {
+            hash = GetXXHash64(&quantParam.numBits, sizeof(quantParam.numBits), hash);
+            hash = GetXXHash64(&quantParam.scale, sizeof(quantParam.scale), hash);
+            hash = GetXXHash64(&quantParam.zeroPoint, sizeof(quantParam.zeroPoint), hash);
+        }
+
+        if (tensor->GetBuffer() != nullptr) {
+            hash = GetXXHash64(tensor->GetBuffer(), tensor->GetDataLength(), hash);
+        }
+    }
+
+    hash = GetXXHash64(m_inputIndices.data(), m_inputIndices.size() * sizeof(uint32_t), hash);
+    hash = GetXXHash64(m_outputIndices.data(), m_outputIndices.size() * sizeof(uint32_t), hash);
+    return hash;
+}
+
 void InnerModel::AddTensorsToLiteGraph(std::unordered_map<uint32_t, uint32_t>& modelIDToGraphID)
 {
     uint32_t graphID = 0;
@@ -774,5 +886,25 @@ std::map<std::string, std::string> InnerModel::GetOpLayouts() const
 {
     return m_opLayouts;
 }
+
+uint64_t InnerModel::GetContentHash() const
+{
+    if (!m_isHashable) {
+        return 0;
+    }
+
+    // Compilations of the model may be built at the same time.
+    std::lock_guard<std::mutex> lock(m_contentHashMtx);
+    if (!m_isContentHashValid) {
+        m_contentHash = CalculateContentHash();
+        m_isContentHashValid = true;
+    }
+    return m_contentHash;
+}
+
+size_t InnerModel::GetConstantSize() const
+{
+    return m_constantSize;
+}
 }  // namespace NeuralNetworkRuntime
 }  // namespace OHOS
\ No newline at end of file
@@ -17,6 +17,7 @@
 #define NEURAL_NETWORK_RUNTIME_INNER_MODEL_H
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "mindir.h"
@@ -41,6 +42,8 @@ public:
     OH_NN_ReturnCode SetTensorQuantParam(uint32_t index, const NN_QuantParam* quantParam);
     OH_NN_ReturnCode SetTensorType(uint32_t index, OH_NN_TensorType tensorType);
     OH_NN_ReturnCode SetTensorValue(uint32_t index, const void* buffer, size_t length);
+    OH_NN_ReturnCode SetTensorValueByReference(uint32_t index, const void* buffer, size_t length);
+    OH_NN_ReturnCode SetTensorValueFromFd(uint32_t index, int fd, size_t offset, size_t length);
     OH_NN_ReturnCode AddOperation(OH_NN_OperationType opType,
                                   const OH_NN_UInt32Array& paramIndices,
                                   const OH_NN_UInt32Array& inputIndices,
@@ -61,6 +64,10 @@ public:
     std::string GetModelName() const;
     std::string GetProfiling() const;
     std::map<std::string, std::string> GetOpLayouts() const;
+    // Hash of the tensors and operations added by AddTensor and AddOperation, 0 if the model is not built by them.
+    // It is calculated on the first call, since the weights are hashed.
+    uint64_t GetContentHash() const;
+    size_t GetConstantSize() const;
 
 private:
     void AddTensorsToLiteGraph(std::unordered_map<uint32_t, uint32_t>& modelIDToGraphID);
@@ -69,6 +76,8 @@ private:
         const OH_NN_UInt32Array& inputIndices, const OH_NN_UInt32Array& outputIndices) const;
     OH_NN_ReturnCode ValidateTensorArray(const OH_NN_UInt32Array& indices) const;
     OH_NN_ReturnCode CheckParameters() const;
+    OH_NN_ReturnCode ValidateTensorValue(uint32_t index, size_t length) const;
+    uint64_t CalculateContentHash() const;
 
 private:
     std::vector<char> m_supportedOperations; // std::vector<bool> not support data(), use std::vector<char> instead.
@@ -84,6 +93,12 @@ private:
     std::string m_modelName;
     std::string m_isProfiling;
     std::map<std::string, std::string> m_opLayouts;
+    uint64_t m_opsHash {0};
+    bool m_isHashable {false};
+    mutable bool m_isContentHashValid {false};
+    mutable uint64_t m_contentHash {0};
+    mutable std::mutex m_contentHashMtx;
+    size_t m_constantSize {0};
 };
 }  // namespace NeuralNetworkRuntime
 }  // namespace OHOS
@@ -1143,7 +1143,11 @@ OHOS::HDI::Nnrt::V1_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteG
         tmp.dataType = static_cast<DataType>(mindspore::lite::MindIR_Tensor_GetDataType(tensor));
         tmp.dims = mindspore::lite::MindIR_Tensor_GetDims(tensor);
         tmp.format = static_cast<Format>(mindspore::lite::MindIR_Tensor_GetFormat(tensor));
-        tmp.data = Copy_MindIR_Tensor_Data_To_HDIBuffer(tensor, buffer, mmap_ptr, tensor_buffer_offset); // todo 实现
+        if (buffer.fd != -1) {
+            tmp.data = Copy_MindIR_Tensor_Data_To_HDIBuffer(tensor, buffer, mmap_ptr, tensor_buffer_offset);
+        } else {
+            tmp.data = {-1, 0, 0, 0};
+        }
         tmp.quantParams = MindIR_Tensor_GetQuantParams_OHOS(tensor);
         allTensors.emplace_back(tmp);
         tensor_buffer_offset = tmp.data.offset + tmp.data.dataSize;
@@ -1180,6 +1184,13 @@ OHOS::HDI::Nnrt::V1_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteG
     return ret_model;
 }
 
+OHOS::HDI::Nnrt::V1_0::Model *LiteGraph_To_HDITopologyModel(const mindspore::lite::LiteGraph *lite_graph)
+{
+    // Without a buffer the data of constant tensors is not read, only the nodes and the tensor metadata are converted.
+    OHOS::HDI::Nnrt::V1_0::SharedBuffer emptyBuffer {-1, 0, 0, 0};
+    return LiteGraph_To_HDIModel(lite_graph, emptyBuffer);
+}
+
 } // V1
 } // NeuralNetworkRuntime
 } // OHOS
\ No newline at end of file
@@ -25,6 +25,8 @@ namespace V1 {
 void HDIModel_Destroy(OHOS::HDI::Nnrt::V1_0::Model **model);
 OHOS::HDI::Nnrt::V1_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteGraph *lite_graph,
     const OHOS::HDI::Nnrt::V1_0::SharedBuffer &buffer);
+// Converts the graph without the data of constant tensors, which is enough for the queries on the node types.
+OHOS::HDI::Nnrt::V1_0::Model *LiteGraph_To_HDITopologyModel(const mindspore::lite::LiteGraph *lite_graph);
 } // V1
 } // NeuralNetworkRuntime
 } // OHOS
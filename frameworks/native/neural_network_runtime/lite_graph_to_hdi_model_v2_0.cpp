@@ -18,9 +18,11 @@
 #include <algorithm>
 #include <sys/mman.h>
 #include "common/log.h"
+#include "const_tensor_packer.h"
 #include "message_parcel.h"
 #include "nnrt/v2_0/nnrt_types.h"
 #include "nnrt/v2_0/node_attr_types.h"
+#include "node_attr_cache.h"
 #include "securec.h"
 
 using namespace OHOS::HDI::Nnrt::V2_0;
@@ -1058,41 +1060,15 @@ void HDIModel_Destroy(OHOS::HDI::Nnrt::V2_0::Model **model)
     }
 }
 
-OHOS::HDI::Nnrt::V2_0::SharedBuffer Copy_MindIR_Tensor_Data_To_HDIBuffer(const TensorPtr tensor,
-    const OHOS::HDI::Nnrt::V2_0::SharedBuffer &buffer_templete, uint8_t *mmap_ptr, unsigned int offset)
+std::vector<int8_t> ConvertNodeAttr(const mindspore::lite::LiteGraph::Node *node)
 {
-    if (tensor == nullptr) {
-        LOGE("");
-        return {-1, 0, offset, 0};
-    }
-    if (mmap_ptr == nullptr) {
-        LOGE("Tensor GetData failed, mmap pointer should not be nullptr");
-        return {-1, 0, offset, 0};
-    }
-
-    OHOS::HDI::Nnrt::V2_0::SharedBuffer result{};
-    std::vector<uint8_t> data = mindspore::lite::MindIR_Tensor_GetData(tensor);
-    if (data.empty()) {
-        result.fd = -1;
-        result.bufferSize = buffer_templete.bufferSize;
-        result.offset = offset;
-        result.dataSize = 0;
-        return result;
-    }
-    result.fd = buffer_templete.fd;
-    result.bufferSize = buffer_templete.bufferSize;
-    auto ret = memcpy_s(mmap_ptr + offset, data.size(), data.data(), data.size());
-    if (ret != EOK) {
-        LOGE("Tensor memcpy failed.");
-        return {-1, 0, offset, 0};
-    }
-    result.offset = offset;
-    result.dataSize = data.size();
-    return result;
+    auto node_type = static_cast<OHOS::HDI::Nnrt::V2_0::NodeType>(
+        mindspore::lite::MindIR_Primitive_GetType(node->primitive_));
+    return Convert(node_type, node->primitive_);
 }
 
-OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteGraph *lite_graph,
-    const OHOS::HDI::Nnrt::V2_0::SharedBuffer &buffer)
+OHOS::HDI::Nnrt::V2_0::Model *ConvertLiteGraph(const mindspore::lite::LiteGraph *lite_graph,
+    const OHOS::HDI::Nnrt::V2_0::SharedBuffer &buffer, size_t alignment, const NodeAttrs *node_attrs)
 {
     if (lite_graph == nullptr) {
         LOGE("MindIR_LiteGraph_To_Model v2 failed, lite graph is nullptr.");
@@ -1108,7 +1084,12 @@ OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteG
     std::vector<OHOS::HDI::Nnrt::V2_0::SubGraph> subGraph;
 
     // nodes
-    for (auto node : lite_graph->all_nodes_) {
+    if (node_attrs == nullptr || node_attrs->size() != lite_graph->all_nodes_.size()) {
+        LOGE("MindIR_LiteGraph_To_Model v2 failed, convert node attributes failed.");
+        return nullptr;
+    }
+    for (size_t i = 0; i < lite_graph->all_nodes_.size(); ++i) {
+        auto node = lite_graph->all_nodes_[i];
         if (node == nullptr) {
             LOGE("MindIR_LiteGraph_To_Model v2 failed, node is nullptr.");
             return nullptr;
@@ -1120,7 +1101,7 @@ OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteG
             return nullptr;
         }
         tmp.nodeType = static_cast<NodeType>(mindspore::lite::MindIR_Primitive_GetType(node->primitive_));
-        tmp.nodeAttr = Convert(tmp.nodeType, node->primitive_);
+        tmp.nodeAttr = (*node_attrs)[i];
         tmp.inputIndex = node->input_indices_;
         tmp.outputIndex = node->output_indices_;
         tmp.quantType = static_cast<QuantType>(node->quant_type_);
@@ -1128,33 +1109,37 @@ OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteG
     }
 
     // Tensor
-    unsigned int tensor_buffer_offset = 0;
-    uint8_t *mmap_ptr = nullptr;
+    std::vector<ConstTensorLayout> layouts;
     if (buffer.fd != -1) {
-        mmap_ptr =
+        auto mmap_ptr =
           static_cast<uint8_t *>(mmap(nullptr, buffer.bufferSize, PROT_READ | PROT_WRITE, MAP_SHARED, buffer.fd, 0));
         if (mmap_ptr == MAP_FAILED) {
             LOGE("MindIR_LiteGraph_To_Model v2 failed, mmap failed.");
             return nullptr;
         }
+        ConstTensorPacker packer(lite_graph, alignment);
+        auto pack_res = packer.Pack(mmap_ptr, buffer.bufferSize, layouts);
+        auto munmap_res = munmap(mmap_ptr, buffer.bufferSize);
+        if (pack_res != OH_NN_SUCCESS || munmap_res != 0) {
+            LOGE("MindIR_LiteGraph_To_Model v2 failed, pack constant tensors failed.");
+            return nullptr;
+        }
     }
-    for (auto tensor : lite_graph->all_tensors_) {
+    for (size_t i = 0; i < lite_graph->all_tensors_.size(); ++i) {
+        auto tensor = lite_graph->all_tensors_[i];
         OHOS::HDI::Nnrt::V2_0::Tensor tmp;
         tmp.name = mindspore::lite::MindIR_Tensor_GetName(tensor);
         tmp.dataType = static_cast<DataType>(mindspore::lite::MindIR_Tensor_GetDataType(tensor));
         tmp.dims = mindspore::lite::MindIR_Tensor_GetDims(tensor);
         tmp.format = static_cast<Format>(mindspore::lite::MindIR_Tensor_GetFormat(tensor));
-        tmp.data = Copy_MindIR_Tensor_Data_To_HDIBuffer(tensor, buffer, mmap_ptr, tensor_buffer_offset); // todo 实现
+        if (i < layouts.size() && layouts[i].dataSize > 0) {
+            tmp.data = {buffer.fd, buffer.bufferSize, static_cast<uint32_t>(layouts[i].offset),
+                static_cast<uint32_t>(layouts[i].dataSize)};
+        } else {
+            tmp.data = {-1, 0, 0, 0};
+        }
         tmp.quantParams = MindIR_Tensor_GetQuantParams_OHOS(tensor);
         allTensors.emplace_back(tmp);
-        tensor_buffer_offset = tmp.data.offset + tmp.data.dataSize;
-    }
-    if (buffer.fd != -1) {
-        auto munmap_res = munmap(mmap_ptr, buffer.bufferSize);
-        if (munmap_res != 0) {
-            LOGE("MindIR_LiteGraph_To_Model v2 failed, unmap failed.");
-            return nullptr;
-        }
     }
 
     // SubGraph
@@ -1181,6 +1166,34 @@ OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteG
     return ret_model;
 }
 
+OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDITopologyModel(const mindspore::lite::LiteGraph *lite_graph)
+{
+    // Without a buffer the data of constant tensors is not read, only the nodes and the tensor metadata are converted.
+    OHOS::HDI::Nnrt::V2_0::SharedBuffer emptyBuffer {-1, 0, 0, 0};
+    return LiteGraph_To_HDIModel(lite_graph, emptyBuffer);
+}
+
+OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteGraph *lite_graph,
+    const OHOS::HDI::Nnrt::V2_0::SharedBuffer &buffer, size_t alignment)
+{
+    auto node_attrs = NodeAttrCache::ConvertNodeAttrs(lite_graph, ConvertNodeAttr);
+    return ConvertLiteGraph(lite_graph, buffer, alignment, node_attrs.get());
+}
+
+OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDIModel(const std::shared_ptr<const mindspore::lite::LiteGraph> &lite_graph,
+    const OHOS::HDI::Nnrt::V2_0::SharedBuffer &buffer, size_t alignment)
+{
+    auto node_attrs = NodeAttrCache::GetInstance().GetNodeAttrs(lite_graph, "v2_0", ConvertNodeAttr);
+    return ConvertLiteGraph(lite_graph.get(), buffer, alignment, node_attrs.get());
+}
+
+OHOS::HDI::Nnrt::V2_0::Model *LiteGraph_To_HDITopologyModel(
+    const std::shared_ptr<const mindspore::lite::LiteGraph> &lite_graph)
+{
+    OHOS::HDI::Nnrt::V2_0::SharedBuffer emptyBuffer {-1, 0, 0, 0};
+    return LiteGraph_To_HDIModel(lite_graph, emptyBuffer);
+}
+
 } // V2
 } // NeuralNetworkRuntime
 } // OHOS
\ No newline at end of file
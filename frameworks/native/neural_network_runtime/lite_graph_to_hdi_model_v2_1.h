@@ -16,6 +16,8 @@
 #ifndef NEURAL_NETWORK_RUNTIME_LITEGRAPH_TO_HDIMODEL_V2_1_H
 #define NEURAL_NETWORK_RUNTIME_LITEGRAPH_TO_HDIMODEL_V2_1_H
 
+#include <memory>
+
 #include "mindir.h"
 #include "nnrt/v2_1/model_types.h"
 
@@ -23,8 +25,17 @@ namespace OHOS {
 namespace NeuralNetworkRuntime {
 namespace NNRt_V2_1 {
 void HDIModel_Destroy(OHOS::HDI::Nnrt::V2_1::Model **model);
+// The constant tensors are packed into buffer with every tensor aligned to alignment, 0 means the default.
 OHOS::HDI::Nnrt::V2_1::Model *LiteGraph_To_HDIModel(const mindspore::lite::LiteGraph *lite_graph,
-    const OHOS::HDI::Nnrt::V2_1::SharedBuffer &buffer);
+    const OHOS::HDI::Nnrt::V2_1::SharedBuffer &buffer, size_t alignment = 0);
+// The serialized node attributes of a shared graph are kept until the graph is destroyed, so that its
+// conversions for querying the supported operations and for preparing the model marshal them once.
+OHOS::HDI::Nnrt::V2_1::Model *LiteGraph_To_HDIModel(const std::shared_ptr<const mindspore::lite::LiteGraph> &lite_graph,
+    const OHOS::HDI::Nnrt::V2_1::SharedBuffer &buffer, size_t alignment = 0);
+// Converts the graph without the data of constant tensors, which is enough for the queries on the node types.
+OHOS::HDI::Nnrt::V2_1::Model *LiteGraph_To_HDITopologyModel(const mindspore::lite::LiteGraph *lite_graph);
+OHOS::HDI::Nnrt::V2_1::Model *LiteGraph_To_HDITopologyModel(
+    const std::shared_ptr<const mindspore::lite::LiteGraph> &lite_graph);
 } // NNRt_V2_1
 } // NeuralNetworkRuntime
 } // OHOS
@@ -98,5 +98,28 @@ OH_NN_ReturnCode MemoryManager::GetMemory(const void* buffer, Memory& memory) co
 
     return OH_NN_SUCCESS;
 }
+
+OH_NN_ReturnCode MemoryManager::GetMemoryContaining(const void* buffer, size_t length, Memory& memory, size_t& offset)
+{
+    if (buffer == nullptr) {
+        LOGE("Memory is nullptr.");
+        return OH_NN_NULL_PTR;
+    }
+
+    // The buffer may be a region inside a mapped memory, e.g. a cache section exported into shared memory.
+    std::lock_guard<std::mutex> lock(m_mtx);
+    const char* address = static_cast<const char*>(buffer);
+    for (const auto& item : m_memorys) {
+        const char* begin = static_cast<const char*>(item.second.data);
+        if ((address >= begin) && (address < begin + item.second.length) &&
+            (length <= item.second.length - static_cast<size_t>(address - begin))) {
+            memory = item.second;
+            offset = static_cast<size_t>(address - begin);
+            return OH_NN_SUCCESS;
+        }
+    }
+
+    return OH_NN_INVALID_PARAMETER;
+}
 } // NeuralNetworkRuntime
 } // OHOS
\ No newline at end of file
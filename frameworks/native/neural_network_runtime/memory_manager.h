@@ -38,6 +38,7 @@ public:
     void* MapMemory(int fd, size_t length);
     OH_NN_ReturnCode UnMapMemory(const void* buffer);
     OH_NN_ReturnCode GetMemory(const void* buffer, Memory& memory) const;
+    OH_NN_ReturnCode GetMemoryContaining(const void* buffer, size_t length, Memory& memory, size_t& offset);
 
     static MemoryManager* GetInstance()
     {
@@ -260,6 +260,55 @@ NNRT_API OH_NN_ReturnCode OH_NNModel_SetTensorData(OH_NNModel *model,
     return innerModel->SetTensorValue(index, dataBuffer, length);
 }
 
+NNRT_API OH_NN_ReturnCode OH_NNModel_SetTensorDataByReference(OH_NNModel *model,
+                                                              uint32_t index,
+                                                              const void *dataBuffer,
+                                                              size_t length)
+{
+    if (model == nullptr) {
+        LOGE("OH_NNModel_SetTensorDataByReference failed, passed nullptr to model.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (dataBuffer == nullptr) {
+        LOGE("OH_NNModel_SetTensorDataByReference failed, passed nullptr to dataBuffer, which has no effect.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (length == 0) {
+        LOGE("OH_NNModel_SetTensorDataByReference failed, passed dataBuffer with length 0, which has no effect.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    InnerModel *innerModel = reinterpret_cast<InnerModel*>(model);
+    return innerModel->SetTensorValueByReference(index, dataBuffer, length);
+}
+
+NNRT_API OH_NN_ReturnCode OH_NNModel_SetTensorDataFromFd(OH_NNModel *model,
+                                                         uint32_t index,
+                                                         int fd,
+                                                         size_t offset,
+                                                         size_t length)
+{
+    if (model == nullptr) {
+        LOGE("OH_NNModel_SetTensorDataFromFd failed, passed nullptr to model.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (fd < 0) {
+        LOGE("OH_NNModel_SetTensorDataFromFd failed, passed invalid fd %{public}d.", fd);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (length == 0) {
+        LOGE("OH_NNModel_SetTensorDataFromFd failed, passed length 0, which has no effect.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    InnerModel *innerModel = reinterpret_cast<InnerModel*>(model);
+    return innerModel->SetTensorValueFromFd(index, fd, offset, length);
+}
+
 NNRT_API OH_NN_ReturnCode OH_NNModel_SpecifyInputsAndOutputs(OH_NNModel *model,
                                                              const OH_NN_UInt32Array *inputIndices,
                                                              const OH_NN_UInt32Array *outputIndices)
@@ -26,6 +26,17 @@ using namespace OHOS::NeuralNetworkRuntime;
 
 #define NNRT_API __attribute__((visibility("default")))
 
+namespace {
+NNExecutor* CastToNNExecutor(OH_NNExecutor *executor)
+{
+    Executor *executorImpl = reinterpret_cast<Executor *>(executor);
+    if (!executorImpl->IsCompatibleWithOldAPIs()) {
+        return nullptr;
+    }
+    return reinterpret_cast<NNExecutor *>(executorImpl);
+}
+}
+
 NNRT_API OH_NN_ReturnCode OH_NNModel_AddTensor(OH_NNModel *model, const OH_NN_Tensor *tensor)
 {
     if (model == nullptr) {
@@ -62,7 +73,11 @@ NNRT_API OH_NN_ReturnCode OH_NNExecutor_SetInput(OH_NNExecutor *executor,
         return OH_NN_INVALID_PARAMETER;
     }
 
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor *>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_SetInput failed, the executor does not support the APIs of older versions.");
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
     return executorImpl->SetInput(inputIndex, *tensor, dataBuffer, length);
 }
 
@@ -82,7 +97,11 @@ NNRT_API OH_NN_ReturnCode OH_NNExecutor_SetOutput(OH_NNExecutor *executor,
         return OH_NN_INVALID_PARAMETER;
     }
 
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor *>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_SetOutput failed, the executor does not support the APIs of older versions.");
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
     return executorImpl->SetOutput(outputIndex, dataBuffer, length);
 }
 
@@ -93,7 +112,11 @@ NNRT_API OH_NN_ReturnCode OH_NNExecutor_Run(OH_NNExecutor *executor)
         return OH_NN_INVALID_PARAMETER;
     }
 
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor *>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_Run failed, the executor does not support the APIs of older versions.");
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
     return executorImpl->Run();
 }
 
@@ -109,7 +132,11 @@ NNRT_API OH_NN_Memory *OH_NNExecutor_AllocateInputMemory(OH_NNExecutor *executor
     }
 
     OH_NN_Memory *nnMemory = nullptr;
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor *>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_AllocateInputMemory failed, the executor does not support the APIs of older versions.");
+        return nullptr;
+    }
     OH_NN_ReturnCode ret = executorImpl->CreateInputMemory(inputIndex, length, &nnMemory);
     if (ret != OH_NN_SUCCESS) {
         LOGE("OH_NNExecutor_AllocateInputMemory failed, error happened when creating input memory in executor.");
@@ -131,7 +158,11 @@ NNRT_API OH_NN_Memory *OH_NNExecutor_AllocateOutputMemory(OH_NNExecutor *executo
     }
 
     OH_NN_Memory *nnMemory = nullptr;
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor *>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_AllocateOutputMemory failed, the executor does not support the APIs of older versions.");
+        return nullptr;
+    }
     OH_NN_ReturnCode ret = executorImpl->CreateOutputMemory(outputIndex, length, &nnMemory);
     if (ret != OH_NN_SUCCESS) {
         LOGE("OH_NNExecutor_AllocateOutputMemory failed, error happened when creating output memory in executor.");
@@ -156,7 +187,11 @@ NNRT_API void OH_NNExecutor_DestroyInputMemory(OH_NNExecutor *executor, uint32_t
         return;
     }
 
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor *>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_DestroyInputMemory failed, the executor does not support the APIs of older versions.");
+        return;
+    }
     OH_NN_ReturnCode ret = executorImpl->DestroyInputMemory(inputIndex, memory);
     if (ret != OH_NN_SUCCESS) {
         LOGE("OH_NNExecutor_DestroyInputMemory failed, error happened when destroying input memory.");
@@ -181,7 +216,11 @@ NNRT_API void OH_NNExecutor_DestroyOutputMemory(OH_NNExecutor *executor, uint32_
         return;
     }
 
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor*>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_DestroyOutputMemory failed, the executor does not support the APIs of older versions.");
+        return;
+    }
     OH_NN_ReturnCode ret = executorImpl->DestroyOutputMemory(outputIndex, memory);
     if (ret != OH_NN_SUCCESS) {
         LOGE("OH_NNExecutor_DestroyOutputMemory failed, error happened when destroying output memory.");
@@ -207,7 +246,11 @@ NNRT_API OH_NN_ReturnCode OH_NNExecutor_SetInputWithMemory(OH_NNExecutor *execut
         return OH_NN_INVALID_PARAMETER;
     }
 
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor *>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_SetInputWithMemory failed, the executor does not support the APIs of older versions.");
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
     return executorImpl->SetInputFromMemory(inputIndex, *tensor, *memory);
 }
 
@@ -223,6 +266,10 @@ NNRT_API OH_NN_ReturnCode OH_NNExecutor_SetOutputWithMemory(OH_NNExecutor *execu
         return OH_NN_INVALID_PARAMETER;
     }
 
-    NNExecutor *executorImpl = reinterpret_cast<NNExecutor *>(executor);
+    NNExecutor *executorImpl = CastToNNExecutor(executor);
+    if (executorImpl == nullptr) {
+        LOGE("OH_NNExecutor_SetOutputWithMemory failed, the executor does not support the APIs of older versions.");
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
     return executorImpl->SetOutputFromMemory(outputIndex, *memory);
 }
\ No newline at end of file
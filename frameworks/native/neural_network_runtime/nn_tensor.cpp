@@ -36,9 +36,16 @@ void DestroyLiteGraphTensor(void* tensor)
 
 NNTensor::~NNTensor()
 {
-    if (m_buffer != nullptr) {
+    ReleaseOwnedBuffer();
+}
+
+void NNTensor::ReleaseOwnedBuffer()
+{
+    if ((m_buffer != nullptr) && (m_externalBuffer == nullptr)) {
         delete [] reinterpret_cast<char*>(m_buffer);
     }
+    m_buffer = nullptr;
+    m_externalBuffer.reset();
 }
 
 NNTensor::NNTensor(NNTensor&& tensor) noexcept
@@ -61,8 +68,10 @@ NNTensor& NNTensor::operator=(NNTensor&& tensor) noexcept
     m_elementCount = tensor.m_elementCount;
     m_isDynamicShape = tensor.m_isDynamicShape;
     m_isOpParameter = tensor.m_isOpParameter;
+    ReleaseOwnedBuffer();
     m_buffer = tensor.m_buffer;
     m_bufferLength = tensor.m_bufferLength;
+    m_externalBuffer = std::move(tensor.m_externalBuffer);
     m_dataLength = tensor.m_dataLength;
 
     tensor.m_buffer = nullptr;
@@ -341,11 +350,24 @@ void NNTensor::SetName(const std::string& name)
 // Buffer set inside NNTensor will be released during deconstruction, make sure the buffer won't be released twice.
 void NNTensor::SetBuffer(const void* buffer, size_t length)
 {
+    if (buffer != nullptr) {
+        ReleaseOwnedBuffer();
+    }
+    m_externalBuffer.reset();
+
     // copy pointer instead of memory copying
     m_buffer = const_cast<void*>(buffer);
     m_bufferLength = length;
 }
 
+void NNTensor::SetExternalBuffer(const void* buffer, size_t length, std::shared_ptr<const void> holder)
+{
+    ReleaseOwnedBuffer();
+    m_buffer = const_cast<void*>(buffer);
+    m_bufferLength = length;
+    m_externalBuffer = std::move(holder);
+}
+
 void NNTensor::SetFormat(const OH_NN_Format& format)
 {
     m_format = format;
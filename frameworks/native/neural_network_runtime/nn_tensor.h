@@ -16,6 +16,7 @@
 #ifndef NEURAL_NETWORK_RUNTIME_NN_TENSOR_H
 #define NEURAL_NETWORK_RUNTIME_NN_TENSOR_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -51,7 +52,12 @@ public:
     void IdentifyOpParameter();
 
     void SetName(const std::string& name);
+    // The tensor owns buffer and releases the buffer it owned before. Passing nullptr detaches the current buffer
+    // without releasing it, for buffers the caller manages by itself.
     void SetBuffer(const void* buffer, size_t length);
+    // The buffer is referenced instead of owned, holder keeps it alive until the tensor is destroyed or given another
+    // buffer. The buffer owned before is released.
+    void SetExternalBuffer(const void* buffer, size_t length, std::shared_ptr<const void> holder);
     void SetFormat(const OH_NN_Format& format);
     OH_NN_ReturnCode SetDimensions(const std::vector<int32_t>& dimensions);
     OH_NN_ReturnCode SetQuantParam(const NN_QuantParam* quantParam);
@@ -80,6 +86,7 @@ public:
     bool CompareAttribute(const NNTensor& tensor) const;
 
 private:
+    void ReleaseOwnedBuffer();
     OH_NN_ReturnCode ParseQuantParams(const OH_NN_QuantParam* quantParams);
     OH_NN_ReturnCode ParseDimensions(const int32_t* dimensions, uint32_t dimensionCount);
     OH_NN_ReturnCode ValidateQuantParams(const std::vector<QuantParam>& quantParams);
@@ -97,6 +104,7 @@ private:
     bool m_isOpParameter {false};
     void* m_buffer {nullptr};
     size_t m_bufferLength {0};
+    std::shared_ptr<const void> m_externalBuffer {nullptr};
     size_t m_dataLength {0};
 };
 }  // namespace NeuralNetworkRuntime
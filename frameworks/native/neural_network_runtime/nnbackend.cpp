@@ -29,7 +29,8 @@ namespace OHOS {
 namespace NeuralNetworkRuntime {
 NNBackend::NNBackend(const std::shared_ptr<Device>& device, size_t backendID)
     : m_device(device),
-    m_backendID(backendID) {}
+    m_backendID(backendID),
+    m_tensorAllocator(CreateSharedPtr<TensorAllocator>(device)) {}
 
 NNBackend::~NNBackend()
 {
@@ -160,13 +161,13 @@ Executor* NNBackend::CreateExecutor(Compilation* compilation)
     }
 
     NNCompiler* nnCompiler = reinterpret_cast<NNCompiler*>(compilation->compiler);
-    NNExecutor* nnExecutor = nnCompiler->CreateExecutor();
-    if (nnExecutor == nullptr) {
+    Executor* executor = nnCompiler->CreateExecutor();
+    if (executor == nullptr) {
         LOGE("[NNBackend] CreateExecutor failed, fail to create NN Executor.");
         return nullptr;
     }
 
-    return reinterpret_cast<Executor*>(nnExecutor);
+    return executor;
 }
 
 OH_NN_ReturnCode NNBackend::DestroyExecutor(Executor* executor)
@@ -222,6 +223,11 @@ std::shared_ptr<Device> NNBackend::GetDevice() const
     return m_device;
 }
 
+std::shared_ptr<TensorAllocator> NNBackend::GetTensorAllocator() const
+{
+    return m_tensorAllocator;
+}
+
 OH_NN_ReturnCode NNBackend::GetSupportedOperation(std::shared_ptr<const mindspore::lite::LiteGraph> model,
                                                   std::vector<bool>& ops)
 {
@@ -23,6 +23,7 @@
 #include "tensor_desc.h"
 #include "device.h"
 #include "nncompiler.h"
+#include "tensor_allocator.h"
 
 namespace OHOS {
 namespace NeuralNetworkRuntime {
@@ -51,12 +52,15 @@ public:
 
     // external methods
     std::shared_ptr<Device> GetDevice() const;
+    std::shared_ptr<TensorAllocator> GetTensorAllocator() const;
     OH_NN_ReturnCode GetSupportedOperation(std::shared_ptr<const mindspore::lite::LiteGraph> model,
                                            std::vector<bool>& ops);
 
 private:
     std::shared_ptr<Device> m_device;
     size_t m_backendID;
+    // Shared by the tensors created on the backend, each tensor holding a block keeps it alive.
+    std::shared_ptr<TensorAllocator> m_tensorAllocator {nullptr};
 };
 } // NeuralNetworkRuntime
 } // OHOS
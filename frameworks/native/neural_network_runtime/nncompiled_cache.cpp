@@ -15,9 +15,18 @@
 
 #include "nncompiled_cache.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <securec.h>
 
 #include "common/utils.h"
 #include "backend_manager.h"
@@ -30,6 +39,84 @@ constexpr int NULL_PTR_LENGTH = 0;
 constexpr int NUMBER_CACHE_INFO_MEMBERS = 3;
 constexpr int HEX_UNIT = 16;
 
+namespace {
+constexpr uint64_t CACHE_CONTAINER_MAGIC = 0x454843414354524E; // "NRTCACHE"
+constexpr uint32_t CACHE_CONTAINER_FORMAT = 2; // Format 2 records the checksum algorithm in the header.
+constexpr size_t DEFAULT_PAGE_SIZE = 4096;
+constexpr size_t CACHE_BUFFER_ALIGNMENT = 64;
+constexpr mode_t CACHE_FILE_MODE = 0644;
+
+size_t GetPageSize()
+{
+    long pageSize = sysconf(_SC_PAGESIZE);
+    return (pageSize > 0) ? static_cast<size_t>(pageSize) : DEFAULT_PAGE_SIZE;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Runs task(0), ..., task(taskNum - 1) on at most workerNum threads, the calling thread is one of them.
+// No new task is started after the first failure, whose return code is returned.
+OH_NN_ReturnCode RunTasksInParallel(size_t taskNum,
+                                    size_t workerNum,
+                                    const std::function<OH_NN_ReturnCode(size_t)>& task)
+{
+    std::atomic<size_t> nextTask {0};
+    std::atomic<bool> isFailed {false};
+    std::mutex retMtx;
+    OH_NN_ReturnCode firstRet {OH_NN_SUCCESS};
+    auto worker = [&]() {
+        while (!isFailed.load()) {
+            size_t index = nextTask.fetch_add(1);
+            if (index >= taskNum) {
+                return;
+            }
+
+            OH_NN_ReturnCode ret = task(index);
+            if (ret != OH_NN_SUCCESS) {
+                std::lock_guard<std::mutex> lock(retMtx);
+                if (!isFailed.exchange(true)) {
+                    firstRet = ret;
+                }
+            }
+        }
+    };
+
+    size_t threadNum = std::min(std::max(workerNum, static_cast<size_t>(1)), taskNum);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadNum; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return firstRet;
+}
+
+OH_NN_ReturnCode WriteToFile(int fd, const char* data, size_t length, uint64_t offset)
+{
+    while (length > 0) {
+        ssize_t written = pwrite(fd, data, length, static_cast<off_t>(offset));
+        if (written <= 0) {
+            return OH_NN_SAVE_CACHE_EXCEPTION;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return OH_NN_SUCCESS;
+}
+
+} // namespace
+
+NNCompiledCache::~NNCompiledCache()
+{
+    UnmapCacheContainer();
+}
+
 OH_NN_ReturnCode NNCompiledCache::Save(const std::vector<OHOS::NeuralNetworkRuntime::Buffer>& caches,
                                        const std::string& cacheDir,
                                        uint32_t version)
@@ -44,9 +131,9 @@ OH_NN_ReturnCode NNCompiledCache::Save(const std::vector<OHOS::NeuralNetworkRunt
         return OH_NN_INVALID_PARAMETER;
     }
 
-    OH_NN_ReturnCode ret = GenerateCacheFiles(caches, cacheDir, version);
+    OH_NN_ReturnCode ret = GenerateCacheContainer(caches, cacheDir, version);
     if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiledCache] Save failed, error happened when calling GenerateCacheFiles.");
+        LOGE("[NNCompiledCache] Save failed, error happened when calling GenerateCacheContainer.");
         return ret;
     }
 
@@ -73,6 +160,12 @@ OH_NN_ReturnCode NNCompiledCache::Restore(const std::string& cacheDir,
         return OH_NN_INVALID_PARAMETER;
     }
 
+    std::string containerPath = GetContainerPath(cacheDir);
+    if (access(containerPath.c_str(), F_OK) == 0) {
+        return RestoreCacheContainer(containerPath, version, caches);
+    }
+
+    // Caches generated by earlier versions are saved as one file per buffer.
     std::string cacheInfoPath = cacheDir + "/" + m_modelName + "cache_info.nncache";
     char path[PATH_MAX];
     if (realpath(cacheInfoPath.c_str(), path) == nullptr) {
@@ -91,47 +184,105 @@ OH_NN_ReturnCode NNCompiledCache::Restore(const std::string& cacheDir,
         return ret;
     }
 
-    if (static_cast<uint64_t>(version) > cacheInfo.version) {
-        LOGE("[NNCompiledCache] Restore failed, version is not match. The current version is %{public}u, "
-             "but the cache files version is %{public}zu.",
-             version,
-             static_cast<size_t>(cacheInfo.version));
-        return OH_NN_INVALID_PARAMETER;
-    }
-
-    if (static_cast<uint64_t>(version) < cacheInfo.version) {
-        LOGE("[NNCompiledCache] Restore failed, the current version is lower than the cache files, "
-             "please set a higher version.");
-        return OH_NN_OPERATION_FORBIDDEN;
+    ret = CheckCacheVersion(cacheInfo.version, version);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] Restore failed, error happened when checking cache version.");
+        return ret;
     }
 
-    for (uint32_t i = 0; i < cacheInfo.fileNumber; ++i) {
+    std::vector<Buffer> modelBuffers(cacheInfo.fileNumber, Buffer {nullptr, 0});
+    ret = RunTasksInParallel(modelBuffers.size(), m_workerNum, [&](size_t i) {
         std::string cacheModelPath = cacheDir + "/" + m_modelName + std::to_string(i) + ".nncache";
         if (access(cacheModelPath.c_str(), 0) != 0) {
             LOGE("[NNCompiledCache] Restore failed, %{public}s is not exist.", cacheModelPath.c_str());
             return OH_NN_INVALID_PARAMETER;
         }
 
-        OHOS::NeuralNetworkRuntime::Buffer modelBuffer;
-        ret = ReadCacheModelFile(cacheModelPath, modelBuffer);
-        if (ret != OH_NN_SUCCESS) {
+        OH_NN_ReturnCode readRet = ReadCacheModelFile(cacheModelPath, modelBuffers[i]);
+        if (readRet != OH_NN_SUCCESS) {
             LOGE("[NNCompiledCache] Restore failed, error happened when calling ReadCacheModelFile.");
-            return ret;
+            return readRet;
         }
 
-        if (GetCrc16(static_cast<char*>(modelBuffer.data), modelBuffer.length) !=
-            cacheInfo.modelCheckSum[i]) {
+        uint64_t checkSum {0};
+        readRet = GetCheckSum(cacheInfo.checkSumType, static_cast<char*>(modelBuffers[i].data),
+                              modelBuffers[i].length, checkSum);
+        if ((readRet != OH_NN_SUCCESS) || (checkSum != static_cast<uint64_t>(cacheInfo.modelCheckSum[i]))) {
             LOGE("[NNCompiledCache] Restore failed, the cache model file %{public}s has been changed.",
                  cacheModelPath.c_str());
             return OH_NN_INVALID_FILE;
         }
+        return OH_NN_SUCCESS;
+    });
 
-        caches.emplace_back(std::move(modelBuffer));
+    // Buffers read before a failure are still handed out, so that the caller releases them.
+    for (auto& modelBuffer : modelBuffers) {
+        if (modelBuffer.data != nullptr) {
+            caches.emplace_back(std::move(modelBuffer));
+        }
     }
 
     return ret;
 }
 
+OH_NN_ReturnCode NNCompiledCache::GetCacheContentHash(const std::string& cacheDir, uint64_t& hash) const
+{
+    std::ifstream containerStream(GetContainerPath(cacheDir), std::ios::in | std::ios::binary);
+    if (!containerStream) {
+        LOGI("[NNCompiledCache] GetCacheContentHash, cache container does not exist.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    containerStream.seekg(0, std::ios::end);
+    std::streamoff fileSize = containerStream.tellg();
+    containerStream.seekg(0, std::ios::beg);
+    size_t headSize = sizeof(CacheContainerHeader);
+    if ((fileSize < static_cast<std::streamoff>(headSize)) || !containerStream.good()) {
+        LOGE("[NNCompiledCache] GetCacheContentHash failed, cache container is truncated.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    CacheContainerHeader header;
+    containerStream.read(reinterpret_cast<char*>(&header), sizeof(CacheContainerHeader));
+    if (!containerStream.good() ||
+        ((static_cast<size_t>(fileSize) - headSize) / sizeof(CacheSectionEntry) < header.sectionNumber)) {
+        LOGE("[NNCompiledCache] GetCacheContentHash failed, fail to read cache container header.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    std::vector<char> head(headSize + header.sectionNumber * sizeof(CacheSectionEntry));
+    if (memcpy_s(head.data(), head.size(), &header, sizeof(CacheContainerHeader)) != EOK) {
+        LOGE("[NNCompiledCache] GetCacheContentHash failed, fail to copy cache container header.");
+        return OH_NN_MEMORY_ERROR;
+    }
+
+    containerStream.read(head.data() + headSize, head.size() - headSize);
+    if (!containerStream.good()) {
+        LOGE("[NNCompiledCache] GetCacheContentHash failed, fail to read section entries.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    return GetCacheContentHash(head.data(), head.size(), hash);
+}
+
+OH_NN_ReturnCode NNCompiledCache::GetCacheContentHash(const void* buffer, size_t length, uint64_t& hash) const
+{
+    if ((buffer == nullptr) || (length < sizeof(CacheContainerHeader))) {
+        LOGE("[NNCompiledCache] GetCacheContentHash failed, cache is truncated.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    const CacheContainerHeader* header = static_cast<const CacheContainerHeader*>(buffer);
+    if ((header->magic != CACHE_CONTAINER_MAGIC) || (header->format != CACHE_CONTAINER_FORMAT) ||
+        ((length - sizeof(CacheContainerHeader)) / sizeof(CacheSectionEntry) < header->sectionNumber)) {
+        LOGE("[NNCompiledCache] GetCacheContentHash failed, unknown cache format.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    hash = GetXXHash64(buffer, sizeof(CacheContainerHeader) + header->sectionNumber * sizeof(CacheSectionEntry));
+    return OH_NN_SUCCESS;
+}
+
 OH_NN_ReturnCode NNCompiledCache::SetBackend(size_t backendID)
 {
     const BackendManager& backendManager = BackendManager::GetInstance();
@@ -157,88 +308,14 @@ void NNCompiledCache::SetModelName(const std::string& modelName)
     m_modelName = modelName;
 }
 
-OH_NN_ReturnCode NNCompiledCache::GenerateCacheFiles(const std::vector<OHOS::NeuralNetworkRuntime::Buffer>& caches,
-                                                     const std::string& cacheDir,
-                                                     uint32_t version) const
+void NNCompiledCache::SetCheckSumType(CacheCheckSumType checkSumType)
 {
-    const size_t cacheNumber = caches.size();
-    uint32_t cacheSize = NUMBER_CACHE_INFO_MEMBERS + cacheNumber;
-    std::unique_ptr<uint64_t[]> cacheInfo = CreateUniquePtr<uint64_t[]>(cacheSize);
-    if (cacheInfo == nullptr) {
-        LOGE("[NNCompiledCache] GenerateCacheFiles failed, fail to create cacheInfo instance.");
-        return OH_NN_MEMORY_ERROR;
-    }
-
-    OH_NN_ReturnCode ret = GenerateCacheModel(caches, cacheInfo, cacheDir, version);
-    if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiledCache] GenerateCacheFiles failed, error happened when calling GenerateCacheModel.");
-        return ret;
-    }
-
-    uint32_t infoCharNumber = cacheSize * sizeof(uint64_t);
-    ret = WriteCacheInfo(infoCharNumber, cacheInfo, cacheDir);
-    if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiledCache] GenerateCacheFiles failed, error happened when calling WriteCacheInfo.");
-        return ret;
-    }
-
-    return OH_NN_SUCCESS;
+    m_checkSumType = checkSumType;
 }
 
-OH_NN_ReturnCode NNCompiledCache::GenerateCacheModel(const std::vector<OHOS::NeuralNetworkRuntime::Buffer>& caches,
-                                                     std::unique_ptr<uint64_t[]>& cacheInfo,
-                                                     const std::string& cacheDir,
-                                                     uint32_t version) const
+void NNCompiledCache::SetWorkerNum(size_t workerNum)
 {
-    size_t cacheNumber = caches.size();
-
-    auto cacheInfoPtr = cacheInfo.get();
-    *cacheInfoPtr++ = static_cast<uint64_t>(cacheNumber);
-    *cacheInfoPtr++ = static_cast<uint64_t>(version);
-    *cacheInfoPtr++ = static_cast<uint64_t>(m_backendID); // Should call SetBackend first.
-
-    for (size_t i = 0; i < cacheNumber; ++i) {
-        std::string cacheModelFile = cacheDir + "/" + m_modelName + std::to_string(i) + ".nncache";
-        std::ofstream cacheModelStream(cacheModelFile, std::ios::binary | std::ios::out | std::ios::trunc);
-        if (cacheModelStream.fail()) {
-            LOGE("[NNCompiledCache] GenerateCacheModel failed, model cache file is invalid.");
-            return OH_NN_INVALID_PARAMETER;
-        }
-
-        uint64_t checkSum =
-            static_cast<uint64_t>(GetCrc16(static_cast<char*>(caches[i].data), caches[i].length));
-        *cacheInfoPtr++ = checkSum;
-        if (!cacheModelStream.write(static_cast<const char*>(caches[i].data), caches[i].length)) {
-            LOGE("[NNCompiledCache] GenerateCacheModel failed, fail to write cache model.");
-            cacheModelStream.close();
-            return OH_NN_SAVE_CACHE_EXCEPTION;
-        };
-
-        cacheModelStream.close();
-    }
-
-    return OH_NN_SUCCESS;
-}
-
-OH_NN_ReturnCode NNCompiledCache::WriteCacheInfo(uint32_t cacheSize,
-                                                 std::unique_ptr<uint64_t[]>& cacheInfo,
-                                                 const std::string& cacheDir) const
-{
-    std::string cacheInfoPath = cacheDir + "/" + m_modelName + "cache_info.nncache";
-    std::ofstream cacheInfoStream(cacheInfoPath, std::ios::binary | std::ios::out | std::ios::trunc);
-    if (cacheInfoStream.fail()) {
-        LOGE("[NNCompiledCache] WriteCacheInfo failed, model cache info file is invalid.");
-        return OH_NN_INVALID_FILE;
-    }
-
-    if (!cacheInfoStream.write(reinterpret_cast<const char*>(cacheInfo.get()), cacheSize)) {
-        LOGE("[NNCompiledCache] WriteCacheInfo failed, fail to write cache info.");
-        cacheInfoStream.close();
-        return OH_NN_SAVE_CACHE_EXCEPTION;
-    }
-
-    cacheInfoStream.close();
-    return OH_NN_SUCCESS;
+    m_workerNum = std::min(std::max(workerNum, static_cast<size_t>(1)), MAX_CACHE_WORKER_NUM);
 }
 
 OH_NN_ReturnCode NNCompiledCache::CheckCacheInfo(NNCompiledCacheInfo& modelCacheInfo,
@@ -355,6 +432,25 @@ unsigned short NNCompiledCache::GetCrc16(char* buffer, size_t length) const
     return static_cast<unsigned short>(~sum);
 }
 
+OH_NN_ReturnCode NNCompiledCache::GetCheckSum(CacheCheckSumType checkSumType,
+                                              char* buffer,
+                                              size_t length,
+                                              uint64_t& checkSum) const
+{
+    switch (checkSumType) {
+        case CacheCheckSumType::CRC16:
+            checkSum = static_cast<uint64_t>(GetCrc16(buffer, length));
+            return OH_NN_SUCCESS;
+        case CacheCheckSumType::XXHASH64:
+            checkSum = GetXXHash64(buffer, length);
+            return OH_NN_SUCCESS;
+        default:
+            LOGE("[NNCompiledCache] GetCheckSum failed, unknown checksum type %{public}u.",
+                 static_cast<uint32_t>(checkSumType));
+            return OH_NN_INVALID_FILE;
+    }
+}
+
 OH_NN_ReturnCode NNCompiledCache::GetCacheFileLength(std::ifstream& ifs, int& fileSize) const
 {
     ifs.seekg(0, std::ios::end);
@@ -380,5 +476,359 @@ OH_NN_ReturnCode NNCompiledCache::GetCacheFileLength(std::ifstream& ifs, int& fi
     fileSize = handleValue;
     return OH_NN_SUCCESS;
 }
+OH_NN_ReturnCode NNCompiledCache::CheckCacheVersion(uint64_t cacheVersion, uint32_t version) const
+{
+    if (static_cast<uint64_t>(version) > cacheVersion) {
+        LOGE("[NNCompiledCache] CheckCacheVersion failed, version is not match. The current version is %{public}u, "
+             "but the cache files version is %{public}zu.",
+             version,
+             static_cast<size_t>(cacheVersion));
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (static_cast<uint64_t>(version) < cacheVersion) {
+        LOGE("[NNCompiledCache] CheckCacheVersion failed, the current version is lower than the cache files, "
+             "please set a higher version.");
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    return OH_NN_SUCCESS;
+}
+
+std::string NNCompiledCache::GetContainerPath(const std::string& cacheDir) const
+{
+    return cacheDir + "/" + m_modelName + "cache_container.nncache";
+}
+
+OH_NN_ReturnCode NNCompiledCache::GenerateCacheSections(const std::vector<Buffer>& caches,
+                                                        uint32_t version,
+                                                        size_t alignment,
+                                                        CacheContainerHeader& header,
+                                                        std::vector<CacheSectionEntry>& entries,
+                                                        size_t& totalSize) const
+{
+    header.magic = CACHE_CONTAINER_MAGIC;
+    header.format = CACHE_CONTAINER_FORMAT;
+    header.sectionNumber = static_cast<uint32_t>(caches.size());
+    header.version = static_cast<uint64_t>(version);
+    header.deviceId = static_cast<uint64_t>(m_backendID); // Should call SetBackend first.
+    header.checkSumType = static_cast<uint32_t>(m_checkSumType);
+
+    entries.clear();
+    uint64_t offset = AlignUp(sizeof(CacheContainerHeader) + caches.size() * sizeof(CacheSectionEntry), alignment);
+    for (const auto& cache : caches) {
+        if ((cache.data == nullptr) || (cache.length == 0)) {
+            LOGE("[NNCompiledCache] GenerateCacheSections failed, cache buffer is empty.");
+            return OH_NN_INVALID_PARAMETER;
+        }
+
+        CacheSectionEntry entry;
+        entry.offset = offset;
+        entry.length = static_cast<uint64_t>(cache.length);
+        entries.emplace_back(entry);
+        offset = AlignUp(offset + entry.length, alignment);
+    }
+
+    OH_NN_ReturnCode ret = RunTasksInParallel(caches.size(), m_workerNum, [&](size_t i) {
+        return GetCheckSum(m_checkSumType, static_cast<char*>(caches[i].data), caches[i].length, entries[i].checkSum);
+    });
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] GenerateCacheSections failed, fail to calculate checksum.");
+        return ret;
+    }
+
+    totalSize = (entries.empty()) ? static_cast<size_t>(offset) :
+        static_cast<size_t>(entries.back().offset + entries.back().length);
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNCompiledCache::ParseCacheSections(const void* buffer,
+                                                     size_t length,
+                                                     uint32_t version,
+                                                     std::vector<Buffer>& caches) const
+{
+    const char* base = static_cast<const char*>(buffer);
+    if (length < sizeof(CacheContainerHeader)) {
+        LOGE("[NNCompiledCache] ParseCacheSections failed, cache is truncated.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    const CacheContainerHeader* header = reinterpret_cast<const CacheContainerHeader*>(base);
+    if ((header->magic != CACHE_CONTAINER_MAGIC) || (header->format != CACHE_CONTAINER_FORMAT)) {
+        LOGE("[NNCompiledCache] ParseCacheSections failed, unknown cache format.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    size_t deviceId = static_cast<size_t>(header->deviceId);
+    if (deviceId != m_backendID) {
+        LOGE("[NNCompiledCache] ParseCacheSections failed. The deviceId=%{public}zu in the cache "
+             "is different from current deviceId=%{public}zu,"
+             "please change the cache or current deviceId.",
+             deviceId,
+             m_backendID);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    OH_NN_ReturnCode ret = CheckCacheVersion(header->version, version);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] ParseCacheSections failed, error happened when checking cache version.");
+        return ret;
+    }
+
+    size_t sectionNumber = static_cast<size_t>(header->sectionNumber);
+    if ((length - sizeof(CacheContainerHeader)) / sizeof(CacheSectionEntry) < sectionNumber) {
+        LOGE("[NNCompiledCache] ParseCacheSections failed, section entries are truncated.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    const CacheSectionEntry* entries = reinterpret_cast<const CacheSectionEntry*>(base + sizeof(CacheContainerHeader));
+    for (size_t i = 0; i < sectionNumber; ++i) {
+        const CacheSectionEntry& entry = entries[i];
+        if ((entry.length == 0) || (entry.offset > length) || (entry.length > length - entry.offset)) {
+            LOGE("[NNCompiledCache] ParseCacheSections failed, section %{public}zu is out of range.", i);
+            return OH_NN_INVALID_FILE;
+        }
+    }
+
+    CacheCheckSumType checkSumType = static_cast<CacheCheckSumType>(header->checkSumType);
+    ret = RunTasksInParallel(sectionNumber, m_workerNum, [&](size_t i) {
+        uint64_t checkSum {0};
+        char* data = const_cast<char*>(base) + entries[i].offset;
+        OH_NN_ReturnCode checkRet = GetCheckSum(checkSumType, data, static_cast<size_t>(entries[i].length), checkSum);
+        if (checkRet != OH_NN_SUCCESS) {
+            LOGE("[NNCompiledCache] ParseCacheSections failed, fail to calculate checksum of section %{public}zu.", i);
+            return checkRet;
+        }
+        if (checkSum != entries[i].checkSum) {
+            LOGE("[NNCompiledCache] ParseCacheSections failed, section %{public}zu has been changed.", i);
+            return OH_NN_INVALID_FILE;
+        }
+        return OH_NN_SUCCESS;
+    });
+    if (ret != OH_NN_SUCCESS) {
+        return ret;
+    }
+
+    for (size_t i = 0; i < sectionNumber; ++i) {
+        Buffer cache {const_cast<char*>(base) + entries[i].offset, static_cast<size_t>(entries[i].length)};
+        cache.offset = static_cast<size_t>(entries[i].offset);
+        caches.emplace_back(cache);
+    }
+
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNCompiledCache::GenerateCacheContainer(const std::vector<Buffer>& caches,
+                                                         const std::string& cacheDir,
+                                                         uint32_t version) const
+{
+    const size_t pageSize = GetPageSize();
+    CacheContainerHeader header;
+    std::vector<CacheSectionEntry> entries;
+    size_t totalSize {0};
+    OH_NN_ReturnCode ret = GenerateCacheSections(caches, version, pageSize, header, entries, totalSize);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] GenerateCacheContainer failed, error happened when generating cache sections.");
+        return ret;
+    }
+
+    // Write to a temporary file first, so that an interrupted save never leaves a broken container behind.
+    std::string containerPath = GetContainerPath(cacheDir);
+    std::string tmpPath = containerPath + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, CACHE_FILE_MODE);
+    if (fd < 0) {
+        LOGE("[NNCompiledCache] GenerateCacheContainer failed, model cache file is invalid.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    // The padding between sections is left as holes, which read as zero.
+    if (ftruncate(fd, static_cast<off_t>(totalSize)) != 0) {
+        LOGE("[NNCompiledCache] GenerateCacheContainer failed, fail to resize cache container.");
+        close(fd);
+        unlink(tmpPath.c_str());
+        return OH_NN_SAVE_CACHE_EXCEPTION;
+    }
+
+    ret = WriteToFile(fd, reinterpret_cast<const char*>(&header), sizeof(CacheContainerHeader), 0);
+    if (ret == OH_NN_SUCCESS) {
+        ret = WriteToFile(fd, reinterpret_cast<const char*>(entries.data()),
+                          entries.size() * sizeof(CacheSectionEntry), sizeof(CacheContainerHeader));
+    }
+    if (ret == OH_NN_SUCCESS) {
+        ret = RunTasksInParallel(caches.size(), m_workerNum, [&](size_t i) {
+            return WriteToFile(fd, static_cast<const char*>(caches[i].data), caches[i].length, entries[i].offset);
+        });
+    }
+    close(fd);
+
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] GenerateCacheContainer failed, fail to write cache container.");
+        unlink(tmpPath.c_str());
+        return ret;
+    }
+
+    if (rename(tmpPath.c_str(), containerPath.c_str()) != 0) {
+        LOGE("[NNCompiledCache] GenerateCacheContainer failed, fail to rename cache container.");
+        unlink(tmpPath.c_str());
+        return OH_NN_SAVE_CACHE_EXCEPTION;
+    }
+
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNCompiledCache::MapCacheContainer(const std::string& containerPath)
+{
+    char path[PATH_MAX];
+    if (realpath(containerPath.c_str(), path) == nullptr) {
+        LOGE("[NNCompiledCache] MapCacheContainer failed, fail to get the real path of cache container.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    // The file is shared read-only with the device service, so that the device cannot change the saved cache.
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        LOGE("[NNCompiledCache] MapCacheContainer failed, fail to open cache container.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0)) {
+        LOGE("[NNCompiledCache] MapCacheContainer failed, fail to get size of cache container.");
+        close(fd);
+        return OH_NN_INVALID_FILE;
+    }
+
+    size_t fileSize = static_cast<size_t>(fileStat.st_size);
+    void* addr = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        LOGE("[NNCompiledCache] MapCacheContainer failed, fail to map cache container.");
+        close(fd);
+        return OH_NN_MEMORY_ERROR;
+    }
+
+    m_containerFd = fd;
+    m_containerAddr = addr;
+    m_containerSize = fileSize;
+    return OH_NN_SUCCESS;
+}
+
+void NNCompiledCache::UnmapCacheContainer()
+{
+    if (m_containerAddr != nullptr) {
+        munmap(m_containerAddr, m_containerSize);
+        m_containerAddr = nullptr;
+        m_containerSize = 0;
+    }
+
+    if (m_containerFd >= 0) {
+        close(m_containerFd);
+        m_containerFd = -1;
+    }
+}
+
+OH_NN_ReturnCode NNCompiledCache::RestoreCacheContainer(const std::string& containerPath,
+                                                        uint32_t version,
+                                                        std::vector<Buffer>& caches)
+{
+    UnmapCacheContainer();
+    OH_NN_ReturnCode ret = MapCacheContainer(containerPath);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] RestoreCacheContainer failed, error happened when mapping cache container.");
+        return ret;
+    }
+
+    ret = ParseCacheSections(m_containerAddr, m_containerSize, version, caches);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] RestoreCacheContainer failed, cache container is invalid.");
+        UnmapCacheContainer();
+        return ret;
+    }
+
+    // The buffers are valid until this NNCompiledCache instance is destroyed.
+    for (auto& cache : caches) {
+        cache.fd = m_containerFd;
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNCompiledCache::SaveToBuffer(const std::vector<Buffer>& caches,
+                                               uint32_t version,
+                                               void* buffer,
+                                               size_t length,
+                                               size_t* cacheSize) const
+{
+    if (caches.empty()) {
+        LOGE("[NNCompiledCache] SaveToBuffer failed, caches is empty.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if ((buffer == nullptr) || (cacheSize == nullptr)) {
+        LOGE("[NNCompiledCache] SaveToBuffer failed, buffer or cacheSize is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    CacheContainerHeader header;
+    std::vector<CacheSectionEntry> entries;
+    size_t totalSize {0};
+    OH_NN_ReturnCode ret = GenerateCacheSections(caches, version, CACHE_BUFFER_ALIGNMENT, header, entries, totalSize);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] SaveToBuffer failed, error happened when generating cache sections.");
+        return ret;
+    }
+
+    // Report the required size, so that the caller can retry with a large enough buffer.
+    *cacheSize = totalSize;
+    if (length < totalSize) {
+        LOGE("[NNCompiledCache] SaveToBuffer failed, buffer length %{public}zu is less than cache size %{public}zu.",
+             length, totalSize);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    char* base = static_cast<char*>(buffer);
+    size_t headSize = sizeof(CacheContainerHeader) + entries.size() * sizeof(CacheSectionEntry);
+    if ((memset_s(base, totalSize, 0, totalSize) != EOK) ||
+        (memcpy_s(base, totalSize, &header, sizeof(CacheContainerHeader)) != EOK) ||
+        (memcpy_s(base + sizeof(CacheContainerHeader), totalSize - sizeof(CacheContainerHeader),
+                  entries.data(), headSize - sizeof(CacheContainerHeader)) != EOK)) {
+        LOGE("[NNCompiledCache] SaveToBuffer failed, fail to write cache header.");
+        return OH_NN_MEMORY_ERROR;
+    }
+
+    for (size_t i = 0; i < caches.size(); ++i) {
+        if (memcpy_s(base + entries[i].offset, totalSize - entries[i].offset,
+                     caches[i].data, caches[i].length) != EOK) {
+            LOGE("[NNCompiledCache] SaveToBuffer failed, fail to write cache section %{public}zu.", i);
+            return OH_NN_MEMORY_ERROR;
+        }
+    }
+
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNCompiledCache::RestoreFromBuffer(const void* buffer,
+                                                    size_t length,
+                                                    uint32_t version,
+                                                    std::vector<Buffer>& caches) const
+{
+    if ((buffer == nullptr) || (length == 0)) {
+        LOGE("[NNCompiledCache] RestoreFromBuffer failed, buffer is empty.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (!caches.empty()) {
+        LOGE("[NNCompiledCache] RestoreFromBuffer failed, caches is not empty.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    // The returned buffers point into the given buffer, nothing is copied here.
+    OH_NN_ReturnCode ret = ParseCacheSections(buffer, length, version, caches);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiledCache] RestoreFromBuffer failed, cache buffer is invalid.");
+        return ret;
+    }
+
+    return OH_NN_SUCCESS;
+}
+
 } // namespace NeuralNetworkRuntime
 } // namespace OHOS
@@ -27,18 +27,46 @@
 namespace OHOS {
 namespace NeuralNetworkRuntime {
 const uint32_t INVALID_CAHCE_VERSION = UINT32_MAX; // UINT32_MAX is reserved for invalid cache version.
+const size_t DEFAULT_CACHE_WORKER_NUM = 4;
+const size_t MAX_CACHE_WORKER_NUM = 16;
+
+enum class CacheCheckSumType : uint32_t {
+    CRC16 = 0,      // 16 bits ones' complement sum, used by caches generated by earlier versions.
+    XXHASH64 = 1,   // 64 bits xxHash, consumes 32 bytes per iteration.
+};
 
 struct NNCompiledCacheInfo {
     uint64_t fileNumber{0};
     uint64_t version{0};
     uint64_t deviceId{0};
     std::vector<unsigned short> modelCheckSum;
+    // Not stored in the cache info file, cache files of one file per buffer are always checked by CRC16.
+    CacheCheckSumType checkSumType {CacheCheckSumType::CRC16};
+};
+
+// Layout of the cache container, used by both the cache file and the cache buffer:
+// | header | section entries | padding | section 0 | padding | section 1 | ... |
+// Sections of the cache file start at page aligned offsets, so that they can be shared with the device by fd.
+struct CacheContainerHeader {
+    uint64_t magic {0};
+    uint32_t format {0};
+    uint32_t sectionNumber {0};
+    uint64_t version {0};
+    uint64_t deviceId {0};
+    uint32_t checkSumType {0};
+    uint32_t reserved {0};
+};
+
+struct CacheSectionEntry {
+    uint64_t offset {0};
+    uint64_t length {0};
+    uint64_t checkSum {0};
 };
 
 class NNCompiledCache {
 public:
     NNCompiledCache() = default;
-    ~NNCompiledCache() = default;
+    ~NNCompiledCache();
 
     OH_NN_ReturnCode Save(const std::vector<Buffer>& caches,
                           const std::string& cacheDir,
@@ -46,30 +74,70 @@ public:
     OH_NN_ReturnCode Restore(const std::string& cacheDir,
                              uint32_t version,
                              std::vector<Buffer>& caches);
+    OH_NN_ReturnCode SaveToBuffer(const std::vector<Buffer>& caches,
+                                  uint32_t version,
+                                  void* buffer,
+                                  size_t length,
+                                  size_t* cacheSize) const;
+    OH_NN_ReturnCode RestoreFromBuffer(const void* buffer,
+                                       size_t length,
+                                       uint32_t version,
+                                       std::vector<Buffer>& caches) const;
+
+    // Hash of the cache header, which covers the checksums of all sections. Used to identify the compiled model
+    // without restoring it.
+    OH_NN_ReturnCode GetCacheContentHash(const std::string& cacheDir, uint64_t& hash) const;
+    OH_NN_ReturnCode GetCacheContentHash(const void* buffer, size_t length, uint64_t& hash) const;
 
     OH_NN_ReturnCode SetBackend(size_t backendID);
     void SetModelName(const std::string& modelName);
+    void SetCheckSumType(CacheCheckSumType checkSumType);
+    // Number of threads which read, write and checksum the cache buffers concurrently.
+    void SetWorkerNum(size_t workerNum);
 
 private:
-    OH_NN_ReturnCode GenerateCacheFiles(const std::vector<Buffer>& caches,
-                                        const std::string& cacheDir,
-                                        uint32_t version) const;
-    OH_NN_ReturnCode GenerateCacheModel(const std::vector<Buffer>& caches,
-                                        std::unique_ptr<uint64_t[]>& cacheInfo,
-                                        const std::string& cacheDir,
-                                        uint32_t version) const;
-    OH_NN_ReturnCode WriteCacheInfo(uint32_t cacheSize,
-                                    std::unique_ptr<uint64_t[]>& cacheInfo,
-                                    const std::string& cacheDir) const;
     OH_NN_ReturnCode CheckCacheInfo(NNCompiledCacheInfo& modelCacheInfo, const std::string& cacheInfoPath) const;
     OH_NN_ReturnCode ReadCacheModelFile(const std::string& file, Buffer& cache) const;
     unsigned short GetCrc16(char* buffer, size_t length) const;
+    OH_NN_ReturnCode GetCheckSum(CacheCheckSumType checkSumType,
+                                 char* buffer,
+                                 size_t length,
+                                 uint64_t& checkSum) const;
     OH_NN_ReturnCode GetCacheFileLength(std::ifstream& ifs, int& fileSize) const;
+    OH_NN_ReturnCode CheckCacheVersion(uint64_t cacheVersion, uint32_t version) const;
+
+    OH_NN_ReturnCode GenerateCacheSections(const std::vector<Buffer>& caches,
+                                           uint32_t version,
+                                           size_t alignment,
+                                           CacheContainerHeader& header,
+                                           std::vector<CacheSectionEntry>& entries,
+                                           size_t& totalSize) const;
+    OH_NN_ReturnCode ParseCacheSections(const void* buffer,
+                                        size_t length,
+                                        uint32_t version,
+                                        std::vector<Buffer>& caches) const;
+
+    // Single file container, the sections are page aligned and restored by mmap without copying.
+    std::string GetContainerPath(const std::string& cacheDir) const;
+    OH_NN_ReturnCode GenerateCacheContainer(const std::vector<Buffer>& caches,
+                                            const std::string& cacheDir,
+                                            uint32_t version) const;
+    OH_NN_ReturnCode RestoreCacheContainer(const std::string& containerPath,
+                                           uint32_t version,
+                                           std::vector<Buffer>& caches);
+    OH_NN_ReturnCode MapCacheContainer(const std::string& containerPath);
+    void UnmapCacheContainer();
 
 private:
     size_t m_backendID {0};
     std::string m_modelName;
     std::shared_ptr<Device> m_device {nullptr};
+    CacheCheckSumType m_checkSumType {CacheCheckSumType::XXHASH64};
+    size_t m_workerNum {DEFAULT_CACHE_WORKER_NUM};
+
+    int m_containerFd {-1};
+    void* m_containerAddr {nullptr};
+    size_t m_containerSize {0};
 };
 
 } // namespace NeuralNetworkRuntime
@@ -21,7 +21,11 @@
 #include <securec.h>
 
 #include "validation.h"
+#include "backend_manager.h"
+#include "nnbackend.h"
 #include "nncompiled_cache.h"
+#include "memory_manager.h"
+#include "request_batcher.h"
 #include "common/utils.h"
 
 namespace OHOS {
@@ -29,6 +33,14 @@ namespace NeuralNetworkRuntime {
 namespace {
 const int CACHE_INPUT_TENSORDESC_OFFSET = 2;
 const int CACHE_OUTPUT_TENSORDESC_OFFSET = 1;
+const char EXTENSION_KEY_CACHE_WORKER_NUM[] = "CacheWorkerNum";
+const char EXTENSION_KEY_CONST_TENSOR_ALIGNMENT[] = "ConstTensorAlignment";
+const char EXTENSION_KEY_HETEROGENEOUS_PARTITION[] = "HeterogeneousPartition";
+const char EXTENSION_KEY_PREPARED_MODEL_MEMORY_LIMIT[] = "PreparedModelMemoryLimit";
+const char PROFILING_ENABLED[] = "true";
+const size_t MAX_CACHE_WORKER_NUM_DIGITS = 4;
+const size_t MAX_CONST_TENSOR_ALIGNMENT_DIGITS = 4;
+const size_t MAX_PREPARED_MODEL_MEMORY_LIMIT_DIGITS = 12;
 
 struct SerializedTensorDesc {
 public:
@@ -132,6 +144,15 @@ NNCompiler::NNCompiler(const void* model, std::shared_ptr<Device> device, size_t
     m_opLayouts = m_innerModel->GetOpLayouts();
 }
 
+NNCompiler::NNCompiler(const GraphPartition& partition, std::shared_ptr<Device> device)
+    : m_device(device),
+    m_backendID(partition.backendID)
+{
+    m_liteGraph = partition.liteGraph;
+    m_inputTensorDescs = partition.inputTensorDescs;
+    m_outputTensorDescs = partition.outputTensorDescs;
+}
+
 NNCompiler::~NNCompiler()
 {
     if (m_preparedModel != nullptr) {
@@ -366,6 +387,10 @@ OH_NN_ReturnCode NNCompiler::NormalBuild()
     // 判断是否支持模型
     bool isSupportedModel = true;
     OH_NN_ReturnCode ret = IsSupportedModel(m_liteGraph, isSupportedModel);
+    if (!isSupportedModel && m_isPartitionEnabled && (m_liteGraph != nullptr)) {
+        LOGI("[NNCompiler] The model is partially supported by the device, split it across backends.");
+        return PartitionBuild();
+    }
     if (ret != OH_NN_SUCCESS) {
         LOGE("[NNCompiler] Build failed, error happened when judge if support the model.");
         return ret;
@@ -375,7 +400,8 @@ OH_NN_ReturnCode NNCompiler::NormalBuild()
     }
 
     ModelConfig config {m_enableFp16, static_cast<OH_NN_PerformanceMode>(m_performance),
-        static_cast<OH_NN_Priority>(m_priority), m_isProfiling, m_cachePath, m_opLayouts};
+        static_cast<OH_NN_Priority>(m_priority), m_isProfiling, m_cachePath, m_opLayouts, m_extensions,
+        m_constTensorAlignment};
     if (m_liteGraph != nullptr) {
         ret = m_device->PrepareModel(m_liteGraph, config, m_preparedModel);
     }
@@ -386,10 +412,13 @@ OH_NN_ReturnCode NNCompiler::NormalBuild()
         LOGE("[NNCompiler] Build failed, fail to prepare model when normally building.");
         return ret;
     }
+    m_preparedModelSize = (m_innerModel != nullptr) ? m_innerModel->GetConstantSize() : 0;
     m_isBuild = true;
 
     // 保存cache
-    if (!m_cachePath.empty()) {
+    if (!m_cachePath.empty() && m_isCacheSaveDeferred) {
+        m_isCacheSavePending = true;
+    } else if (!m_cachePath.empty()) {
         ret = SaveToCacheFile();
         if (ret != OH_NN_SUCCESS) {
             LOGE("[NNCompiler] Build success, but fail to save cache to file.");
@@ -437,6 +466,15 @@ OH_NN_ReturnCode NNCompiler::Build()
         return OH_NN_SUCCESS;
     }
 
+    // The same model has been prepared by another compilation of the process, share its prepared model.
+    PreparedModelKey preparedModelKey;
+    bool isShareable = GetPreparedModelKey(preparedModelKey);
+    if (isShareable && RestoreFromPreparedModelCache(preparedModelKey)) {
+        LOGI("[NNCompiler] Build success, share the prepared model of another compilation.");
+        m_isBuild = true;
+        return OH_NN_SUCCESS;
+    }
+
     // cache存在，从cache直接复原prepareModel、input/output TensorDesc
     ret = RestoreFromCacheFile();
     if (ret == OH_NN_OPERATION_FORBIDDEN) {
@@ -446,11 +484,17 @@ OH_NN_ReturnCode NNCompiler::Build()
     if (ret == OH_NN_SUCCESS) {
         LOGI("[NNCompiler] Build success, restore from cache file.");
         m_isBuild = true;
+        if (isShareable) {
+            AddToPreparedModelCache(preparedModelKey);
+        }
         return OH_NN_SUCCESS;
     }
 
     // cache不存在或cache restore失败，走在线构图
     ret = NormalBuild();
+    if (isShareable && m_isBuild && m_partitionCompilers.empty()) {
+        AddToPreparedModelCache(preparedModelKey);
+    }
     if (ret != OH_NN_SUCCESS) {
         LOGE("[NNCompiler] Build failed, fail to build model online.");
         return ret;
@@ -459,6 +503,215 @@ OH_NN_ReturnCode NNCompiler::Build()
     return OH_NN_SUCCESS;
 }
 
+OH_NN_ReturnCode NNCompiler::PartitionBuild()
+{
+    std::vector<GraphPartition> partitions;
+    OH_NN_ReturnCode ret = GraphPartitioner(m_liteGraph, m_backendID).Partition(partitions);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] Build failed, fail to split the model across backends.");
+        return ret;
+    }
+
+    std::vector<PipelineStage> stages;
+    std::vector<std::shared_ptr<TensorDesc>> intermediateTensorDescs;
+    ret = CreatePipelineStages(partitions, stages, intermediateTensorDescs);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] Build failed, fail to connect the partitions of the model.");
+        return ret;
+    }
+
+    std::vector<std::unique_ptr<NNCompiler>> partitionCompilers;
+    for (size_t i = 0; i < partitions.size(); ++i) {
+        std::unique_ptr<NNCompiler> compiler;
+        ret = BuildPartition(partitions[i], compiler);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("[NNCompiler] Build failed, fail to build partition %{public}zu on backend %{public}zu.", i,
+                 partitions[i].backendID);
+            return ret;
+        }
+        partitionCompilers.emplace_back(std::move(compiler));
+    }
+
+    m_partitionCompilers = std::move(partitionCompilers);
+    m_pipelineStages = std::move(stages);
+    m_intermediateTensorDescs = std::move(intermediateTensorDescs);
+    m_isBuild = true;
+    if (!m_cachePath.empty()) {
+        LOGW("[NNCompiler] Build success, but the model split across backends is not saved to cache.");
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNCompiler::BuildPartition(const GraphPartition& partition,
+                                            std::unique_ptr<NNCompiler>& compiler) const
+{
+    std::shared_ptr<Backend> backend = BackendManager::GetInstance().GetBackend(partition.backendID);
+    if (backend == nullptr) {
+        LOGE("[NNCompiler] BuildPartition failed, fail to get backend %{public}zu.", partition.backendID);
+        return OH_NN_NULL_PTR;
+    }
+
+    std::shared_ptr<Device> device = std::reinterpret_pointer_cast<NNBackend>(backend)->GetDevice();
+    compiler.reset(new (std::nothrow) NNCompiler(partition, device));
+    if (compiler == nullptr) {
+        LOGE("[NNCompiler] BuildPartition failed, error happend when allocating NN Compiler.");
+        return OH_NN_MEMORY_ERROR;
+    }
+
+    // The settings not supported by the device of a partition are left to its defaults.
+    if ((compiler->SetEnableFp16(m_enableFp16) != OH_NN_SUCCESS) ||
+        (compiler->SetPerformance(m_performance) != OH_NN_SUCCESS) ||
+        (compiler->SetPriority(m_priority) != OH_NN_SUCCESS)) {
+        LOGW("[NNCompiler] Backend %{public}zu does not support all settings of the compilation.",
+             partition.backendID);
+    }
+    compiler->m_constTensorAlignment = m_constTensorAlignment;
+    return compiler->NormalBuild();
+}
+
+OH_NN_ReturnCode NNCompiler::CreatePipelineStages(const std::vector<GraphPartition>& partitions,
+    std::vector<PipelineStage>& stages, std::vector<std::shared_ptr<TensorDesc>>& intermediateTensorDescs) const
+{
+    // Where every tensor passed to or between partitions lives in the pipeline
+    std::map<uint32_t, PipelineTensorRef> tensorRefs;
+    for (size_t i = 0; i < m_liteGraph->input_indices_.size(); ++i) {
+        tensorRefs.emplace(m_liteGraph->input_indices_[i], PipelineTensorRef {PipelineTensorKind::PIPELINE_INPUT, i});
+    }
+    for (size_t i = 0; i < m_liteGraph->output_indices_.size(); ++i) {
+        tensorRefs.emplace(m_liteGraph->output_indices_[i],
+            PipelineTensorRef {PipelineTensorKind::PIPELINE_OUTPUT, i});
+    }
+
+    std::vector<bool> isOutputProduced(m_liteGraph->output_indices_.size(), false);
+    for (const auto& partition : partitions) {
+        PipelineStage stage;
+        stage.backendID = partition.backendID;
+        for (uint32_t index : partition.inputIndices) {
+            auto iter = tensorRefs.find(index);
+            if (iter == tensorRefs.end()) {
+                LOGE("[NNCompiler] Input tensor %{public}u of a partition is not produced by the former partitions.",
+                     index);
+                return OH_NN_INVALID_PARAMETER;
+            }
+            stage.inputs.emplace_back(iter->second);
+        }
+
+        for (size_t i = 0; i < partition.outputIndices.size(); ++i) {
+            auto iter = tensorRefs.find(partition.outputIndices[i]);
+            if (iter == tensorRefs.end()) {
+                // Executors rewrite the shapes of their output descs, so the pipeline owns a copy.
+                std::shared_ptr<TensorDesc> tensorDesc =
+                    CreateSharedPtr<TensorDesc>(*(partition.outputTensorDescs[i].first));
+                if (tensorDesc == nullptr) {
+                    LOGE("[NNCompiler] Fail to copy the tensor desc of an intermediate tensor.");
+                    return OH_NN_MEMORY_ERROR;
+                }
+                PipelineTensorRef ref {PipelineTensorKind::INTERMEDIATE, intermediateTensorDescs.size()};
+                iter = tensorRefs.emplace(partition.outputIndices[i], ref).first;
+                intermediateTensorDescs.emplace_back(tensorDesc);
+            } else if (iter->second.kind == PipelineTensorKind::PIPELINE_INPUT) {
+                LOGE("[NNCompiler] Input tensor %{public}u of the model is produced by a node.",
+                     partition.outputIndices[i]);
+                return OH_NN_INVALID_PARAMETER;
+            } else if (iter->second.kind == PipelineTensorKind::PIPELINE_OUTPUT) {
+                isOutputProduced[iter->second.index] = true;
+            }
+            stage.outputs.emplace_back(iter->second);
+        }
+        stages.emplace_back(std::move(stage));
+    }
+
+    auto iter = std::find(isOutputProduced.begin(), isOutputProduced.end(), false);
+    if (iter != isOutputProduced.end()) {
+        LOGE("[NNCompiler] Output %{public}zu of the model is not produced by any node.",
+             static_cast<size_t>(iter - isOutputProduced.begin()));
+        return OH_NN_INVALID_PARAMETER;
+    }
+    return OH_NN_SUCCESS;
+}
+
+bool NNCompiler::GetPreparedModelKey(PreparedModelKey& key) const
+{
+    // Profiling results belong to a single compilation, so the prepared model is not shared in that case.
+    if (m_isProfiling == PROFILING_ENABLED) {
+        return false;
+    }
+
+    // The weights are hashed only if the model can be shared.
+    size_t constantSize = (m_innerModel != nullptr) ? m_innerModel->GetConstantSize() : 0;
+    if (!PreparedModelCache::GetInstance().IsShareable(constantSize)) {
+        return false;
+    }
+
+    uint64_t modelHash = (m_innerModel != nullptr) ? m_innerModel->GetContentHash() : 0;
+    if ((modelHash == 0) && !m_cachePath.empty()) {
+        NNCompiledCache compiledCache;
+        compiledCache.SetModelName(m_modelName);
+        if (compiledCache.GetCacheContentHash(m_cachePath, modelHash) != OH_NN_SUCCESS) {
+            modelHash = 0;
+        }
+    }
+    if (modelHash == 0) {
+        return false;
+    }
+
+    for (const auto& opLayout : m_opLayouts) {
+        modelHash = GetXXHash64(opLayout.first.data(), opLayout.first.size(), modelHash);
+        modelHash = GetXXHash64(opLayout.second.data(), opLayout.second.size(), modelHash);
+    }
+    for (const auto& extension : m_extensions) {
+        modelHash = GetXXHash64(extension.first.data(), extension.first.size(), modelHash);
+        modelHash = GetXXHash64(extension.second.data(), extension.second.size(), modelHash);
+    }
+
+    key.modelHash = modelHash;
+    key.backendID = m_backendID;
+    key.enableFp16 = m_enableFp16;
+    key.performance = m_performance;
+    key.priority = m_priority;
+    return true;
+}
+
+bool NNCompiler::RestoreFromPreparedModelCache(const PreparedModelKey& key)
+{
+    PreparedModelEntry entry;
+    if (!PreparedModelCache::GetInstance().Find(key, entry)) {
+        return false;
+    }
+
+    // Executors rewrite the output shapes of dynamic models, so every compilation owns its tensor descs.
+    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> inputTensorDescs;
+    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> outputTensorDescs;
+    for (size_t i = 0; i < entry.inputTensorDescs.size() + entry.outputTensorDescs.size(); ++i) {
+        bool isInput = i < entry.inputTensorDescs.size();
+        const auto& tensorDesc = isInput ? entry.inputTensorDescs[i] :
+            entry.outputTensorDescs[i - entry.inputTensorDescs.size()];
+        std::shared_ptr<TensorDesc> copiedTensorDesc = CreateSharedPtr<TensorDesc>(*(tensorDesc.first));
+        if (copiedTensorDesc == nullptr) {
+            LOGE("[NNCompiler] RestoreFromPreparedModelCache failed, fail to copy tensor desc.");
+            return false;
+        }
+        auto& tensorDescs = isInput ? inputTensorDescs : outputTensorDescs;
+        tensorDescs.emplace_back(copiedTensorDesc, tensorDesc.second);
+    }
+
+    m_preparedModel = entry.preparedModel;
+    m_inputTensorDescs = inputTensorDescs;
+    m_outputTensorDescs = outputTensorDescs;
+    m_preparedModelSize = entry.memorySize;
+    return true;
+}
+
+void NNCompiler::AddToPreparedModelCache(const PreparedModelKey& key) const
+{
+    PreparedModelEntry entry;
+    entry.preparedModel = m_preparedModel;
+    entry.inputTensorDescs = m_inputTensorDescs;
+    entry.outputTensorDescs = m_outputTensorDescs;
+    entry.memorySize = m_preparedModelSize;
+    PreparedModelCache::GetInstance().Add(key, entry);
+}
+
 void NNCompiler::ReleaseBuffer(std::vector<Buffer>& buffers) const
 {
     for (size_t i = 0; i < buffers.size(); ++i) {
@@ -471,14 +724,94 @@ void NNCompiler::ReleaseBuffer(std::vector<Buffer>& buffers) const
 void NNCompiler::ReleaseBufferByDevice(std::vector<Buffer>& buffers) const
 {
     for (size_t i = 0; i < buffers.size(); ++i) {
+        // Buffers mapped from the cache container are owned by NNCompiledCache.
+        if (buffers[i].fd != INVALID_FD) {
+            continue;
+        }
         // release cache buffer which is allocated by idevice.
         m_device->ReleaseBuffer(buffers[i].data);
     }
     buffers.clear();
 }
 
+OH_NN_ReturnCode NNCompiler::GenerateCaches(std::vector<Buffer>& caches, std::vector<Buffer>& tensorBuffers) const
+{
+    OH_NN_ReturnCode ret = m_preparedModel->ExportModelCache(caches);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] GenerateCaches failed, error happened when exporting model cache.");
+        return ret;
+    }
+
+    Buffer inputTensorDescBuffer;
+    ret = SerializeTensorsToBuffer(m_inputTensorDescs, inputTensorDescBuffer);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] GenerateCaches failed, error happened when serializing input tensor desc.");
+        return ret;
+    }
+    caches.emplace_back(inputTensorDescBuffer);
+    tensorBuffers.emplace_back(inputTensorDescBuffer);
+
+    Buffer outputTensorDescBuffer;
+    ret = SerializeTensorsToBuffer(m_outputTensorDescs, outputTensorDescBuffer);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] GenerateCaches failed, error happened when serializing output tensor desc.");
+        ReleaseBuffer(tensorBuffers);
+        return ret;
+    }
+    caches.emplace_back(outputTensorDescBuffer);
+    tensorBuffers.emplace_back(outputTensorDescBuffer);
+
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNCompiler::PrepareFromCaches(const std::vector<Buffer>& caches)
+{
+    if (caches.size() <= static_cast<size_t>(CACHE_INPUT_TENSORDESC_OFFSET)) {
+        LOGE("[NNCompiler] PrepareFromCaches failed, the number of caches is invalid.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    size_t cacheNum = caches.size();
+    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> inputTensorDescs;
+    OH_NN_ReturnCode ret =
+        DeserializedTensorsFromBuffer(caches[cacheNum - CACHE_INPUT_TENSORDESC_OFFSET], inputTensorDescs);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] PrepareFromCaches failed, error happened when deserializing input tensor desc.");
+        return ret;
+    }
+
+    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> outputTensorDescs;
+    ret = DeserializedTensorsFromBuffer(caches[cacheNum - CACHE_OUTPUT_TENSORDESC_OFFSET], outputTensorDescs);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] PrepareFromCaches failed, error happened when deserializing output tensor desc.");
+        return ret;
+    }
+
+    ModelConfig config;
+    config.enableFloat16 = m_enableFp16;
+    config.mode = m_performance;
+    config.priority = m_priority;
+    config.extensions = m_extensions;
+    std::vector<Buffer> modelOnlyCaches(caches.begin(), caches.end() - CACHE_INPUT_TENSORDESC_OFFSET);
+    ret = m_device->PrepareModelFromModelCache(modelOnlyCaches, config, m_preparedModel);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] PrepareFromCaches failed, error happened when preparing model from cache.");
+        return ret;
+    }
+
+    m_inputTensorDescs = inputTensorDescs;
+    m_outputTensorDescs = outputTensorDescs;
+    m_preparedModelSize = 0;
+    for (const Buffer& cache : modelOnlyCaches) {
+        m_preparedModelSize += cache.length;
+    }
+    return OH_NN_SUCCESS;
+}
+
 OH_NN_ReturnCode NNCompiler::SaveToCacheFile() const
 {
+    // The deferred saving is done once it has run, whether the cache is saved or not.
+    m_isCacheSavePending = false;
     if (m_cachePath.empty()) {
         LOGE("[NNCompiler] SaveToCacheFile failed, m_cachePath is empty.");
         return OH_NN_INVALID_PARAMETER;
@@ -494,39 +827,21 @@ OH_NN_ReturnCode NNCompiler::SaveToCacheFile() const
         return OH_NN_FAILED;
     }
 
-    std::vector<Buffer> caches;
-    std::vector<Buffer> tensorBuffers;
-    OH_NN_ReturnCode ret = m_preparedModel->ExportModelCache(caches);
-    if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiler] SaveToCacheFile failed, error happened when exporting model cache.");
-        return ret;
-    }
-
     NNCompiledCache compiledCache;
-    ret = compiledCache.SetBackend(m_backendID);
+    OH_NN_ReturnCode ret = compiledCache.SetBackend(m_backendID);
     if (ret != OH_NN_SUCCESS) {
         LOGE("[NNCompiler] SaveToCacheFile failed, fail to set backend.");
         return ret;
     }
+    compiledCache.SetWorkerNum(m_cacheWorkerNum);
 
-    Buffer inputTensorDescBuffer;
-    ret = SerializeTensorsToBuffer(m_inputTensorDescs, inputTensorDescBuffer);
-    if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiler] SaveToCacheFile failed, error happened when serializing input tensor desc.");
-        return ret;
-    }
-    caches.emplace_back(inputTensorDescBuffer);
-    tensorBuffers.emplace_back(inputTensorDescBuffer);
-
-    Buffer outputTensorDescBuffer;
-    ret = SerializeTensorsToBuffer(m_outputTensorDescs, outputTensorDescBuffer);
+    std::vector<Buffer> caches;
+    std::vector<Buffer> tensorBuffers;
+    ret = GenerateCaches(caches, tensorBuffers);
     if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiler] SaveToCacheFile failed, error happened when serializing output tensor desc.");
-        ReleaseBuffer(tensorBuffers);
+        LOGE("[NNCompiler] SaveToCacheFile failed, error happened when generating caches.");
         return ret;
     }
-    caches.emplace_back(outputTensorDescBuffer);
-    tensorBuffers.emplace_back(outputTensorDescBuffer);
 
     compiledCache.SetModelName(m_modelName);
     ret = compiledCache.Save(caches, m_cachePath, m_cacheVersion);
@@ -564,6 +879,7 @@ OH_NN_ReturnCode NNCompiler::RestoreFromCacheFile()
         LOGE("[NNCompiler] RestoreFromCacheFile failed, fail to set backend.");
         return ret;
     }
+    compiledCache.SetWorkerNum(m_cacheWorkerNum);
 
     std::vector<Buffer> caches;
     compiledCache.SetModelName(m_modelName);
@@ -574,56 +890,233 @@ OH_NN_ReturnCode NNCompiler::RestoreFromCacheFile()
         return ret;
     }
 
-    size_t cacheNum = caches.size();
-    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> inputTensorDescs;
-    ret = DeserializedTensorsFromBuffer(caches[cacheNum - CACHE_INPUT_TENSORDESC_OFFSET], inputTensorDescs);
+    ret = PrepareFromCaches(caches);
+    if ((ret == OH_NN_UNSUPPORTED) && !caches.empty() && (caches[0].fd != INVALID_FD)) {
+        // Devices which cannot map the read-only cache container get a copy of the caches in device memory. Any
+        // other failure, e.g. a corrupted cache or a device error, would fail again, so it is returned directly.
+        LOGW("[NNCompiler] RestoreFromCacheFile, fail to share cache container with device, copy it instead.");
+        std::vector<Buffer> deviceBuffers;
+        ret = ShareCachesWithDevice(caches, deviceBuffers);
+        if (ret == OH_NN_SUCCESS) {
+            ret = PrepareFromCaches(caches);
+        }
+        ReleaseBufferByDevice(deviceBuffers);
+        caches.clear();
+    }
     if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiler] RestoreFromCacheFile failed, error happened when deserializing input tensor desc.");
+        LOGE("[NNCompiler] RestoreFromCacheFile failed, error happened when preparing model from caches.");
         ReleaseBufferByDevice(caches);
         return ret;
     }
+    ReleaseBufferByDevice(caches);
 
-    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> outputTensorDescs;
-    ret = DeserializedTensorsFromBuffer(caches[cacheNum - CACHE_OUTPUT_TENSORDESC_OFFSET], outputTensorDescs);
+    LOGI("[NNCompiler] Restore model cache successfully.");
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNCompiler::SaveToCacheBuffer(const void* buffer, size_t length, size_t* modelSize) const
+{
+    if (m_cacheVersion == INVALID_CAHCE_VERSION) {
+        LOGE("[NNCompiler] SaveToCacheBuffer failed, cache version is invalid. Please set a valid cache version.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (m_preparedModel == nullptr) {
+        LOGE("[NNCompiler] SaveToCacheBuffer failed, m_preparedModel is nullptr. Please construct prepareModel first.");
+        return OH_NN_FAILED;
+    }
+
+    NNCompiledCache compiledCache;
+    OH_NN_ReturnCode ret = compiledCache.SetBackend(m_backendID);
     if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiler] RestoreFromCacheFile failed, error happened when deserializing output tensor desc.");
-        ReleaseBufferByDevice(caches);
+        LOGE("[NNCompiler] SaveToCacheBuffer failed, fail to set backend.");
         return ret;
     }
+    compiledCache.SetWorkerNum(m_cacheWorkerNum);
 
-    ModelConfig config;
-    config.enableFloat16 = m_enableFp16;
-    config.mode = m_performance;
-    config.priority = m_priority;
-    std::vector<Buffer> modelOnlyCaches(caches.begin(), caches.end() - CACHE_INPUT_TENSORDESC_OFFSET);
-    ret = m_device->PrepareModelFromModelCache(modelOnlyCaches, config, m_preparedModel);
+    std::vector<Buffer> caches;
+    std::vector<Buffer> tensorBuffers;
+    ret = GenerateCaches(caches, tensorBuffers);
     if (ret != OH_NN_SUCCESS) {
-        LOGE("[NNCompiler] RestoreFromCacheFile failed, error happened when preparing model from cache.");
-        ReleaseBufferByDevice(caches);
+        LOGE("[NNCompiler] SaveToCacheBuffer failed, error happened when generating caches.");
         return ret;
     }
-    ReleaseBufferByDevice(caches);
 
-    m_inputTensorDescs = inputTensorDescs;
-    m_outputTensorDescs = outputTensorDescs;
-    LOGI("[NNCompiler] Restore model cache successfully.");
+    ret = compiledCache.SaveToBuffer(caches, m_cacheVersion, const_cast<void*>(buffer), length, modelSize);
+    ReleaseBuffer(tensorBuffers);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] SaveToCacheBuffer failed, error happened when saving model cache to buffer.");
+        return ret;
+    }
+
+    LOGI("[NNCompiler] Export model cache to buffer successfully.");
     return OH_NN_SUCCESS;
 }
 
-OH_NN_ReturnCode NNCompiler::SaveToCacheBuffer(const void* buffer, size_t length, size_t* modelSize) const
+OH_NN_ReturnCode NNCompiler::ShareCachesWithDevice(std::vector<Buffer>& caches,
+                                                   std::vector<Buffer>& deviceBuffers) const
 {
-    LOGE("[NNCompiler] SaveToCacheBuffer is not supported currently.");
-    return OH_NN_UNSUPPORTED;
+    if (caches.size() <= static_cast<size_t>(CACHE_INPUT_TENSORDESC_OFFSET)) {
+        LOGE("[NNCompiler] ShareCachesWithDevice failed, the number of caches is invalid.");
+        return OH_NN_INVALID_FILE;
+    }
+
+    auto memManager = MemoryManager::GetInstance();
+    size_t modelCacheNum = caches.size() - CACHE_INPUT_TENSORDESC_OFFSET;
+    for (size_t i = 0; i < modelCacheNum; ++i) {
+        // The buffer is already shared memory, pass the region to the device without copying.
+        Memory memory;
+        size_t offset {0};
+        if (memManager->GetMemoryContaining(caches[i].data, caches[i].length, memory, offset) == OH_NN_SUCCESS) {
+            caches[i].fd = memory.fd;
+            caches[i].offset = offset;
+            continue;
+        }
+
+        void* deviceBuffer = m_device->AllocateBuffer(caches[i].length);
+        if (deviceBuffer == nullptr) {
+            LOGE("[NNCompiler] ShareCachesWithDevice failed, fail to allocate device buffer.");
+            ReleaseBufferByDevice(deviceBuffers);
+            return OH_NN_MEMORY_ERROR;
+        }
+        deviceBuffers.emplace_back(Buffer {deviceBuffer, caches[i].length});
+
+        if (memcpy_s(deviceBuffer, caches[i].length, caches[i].data, caches[i].length) != EOK) {
+            LOGE("[NNCompiler] ShareCachesWithDevice failed, fail to copy model cache to device buffer.");
+            ReleaseBufferByDevice(deviceBuffers);
+            return OH_NN_MEMORY_ERROR;
+        }
+        caches[i] = deviceBuffers.back();
+    }
+
+    return OH_NN_SUCCESS;
 }
 
 OH_NN_ReturnCode NNCompiler::RestoreFromCacheBuffer(const void* buffer, size_t length)
 {
-    LOGE("[NNCompiler] RestoreFromCacheBuffer is not supported currently.");
-    return OH_NN_UNSUPPORTED;
+    if (m_cacheVersion == INVALID_CAHCE_VERSION) {
+        LOGE("[NNCompiler] RestoreFromCacheBuffer failed, cache version is invalid. "
+             "Please set a valid cache version.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (m_preparedModel != nullptr) {
+        LOGE("[NNCompiler] RestoreFromCacheBuffer failed, m_preparedModel is not nullptr.");
+        return OH_NN_FAILED;
+    }
+
+    NNCompiledCache compiledCache;
+    OH_NN_ReturnCode ret = compiledCache.SetBackend(m_backendID);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] RestoreFromCacheBuffer failed, fail to set backend.");
+        return ret;
+    }
+    compiledCache.SetWorkerNum(m_cacheWorkerNum);
+
+    // The caches point into the caller's buffer, which is kept alive until the compilation is destroyed.
+    std::vector<Buffer> caches;
+    ret = compiledCache.RestoreFromBuffer(buffer, length, m_cacheVersion, caches);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] RestoreFromCacheBuffer failed, error happened when restoring model cache.");
+        return ret;
+    }
+
+    // Only a buffer allocated by NNRt is passed as it is, a buffer owned by the caller is copied in full here.
+    std::vector<Buffer> deviceBuffers;
+    ret = ShareCachesWithDevice(caches, deviceBuffers);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] RestoreFromCacheBuffer failed, error happened when sharing caches with device.");
+        return ret;
+    }
+
+    ret = PrepareFromCaches(caches);
+    ReleaseBufferByDevice(deviceBuffers);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[NNCompiler] RestoreFromCacheBuffer failed, error happened when preparing model from caches.");
+        return ret;
+    }
+
+    m_isBuild = true;
+    LOGI("[NNCompiler] Restore model cache from buffer successfully.");
+    return OH_NN_SUCCESS;
 }
 
 OH_NN_ReturnCode NNCompiler::SetExtensionConfig(const std::unordered_map<std::string, std::vector<char>>& configs)
 {
+    auto iter = configs.find(EXTENSION_KEY_CACHE_WORKER_NUM);
+    if (iter != configs.end()) {
+        // The value is a decimal string, e.g. "4".
+        std::string value(iter->second.begin(), iter->second.end());
+        value = value.substr(0, value.find('\0'));
+        if (value.empty() || (value.find_first_not_of("0123456789") != std::string::npos) ||
+            (value.size() > MAX_CACHE_WORKER_NUM_DIGITS)) {
+            LOGE("[NNCompiler] SetExtensionConfig failed, %{public}s should be a positive integer.",
+                 EXTENSION_KEY_CACHE_WORKER_NUM);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        m_cacheWorkerNum = static_cast<size_t>(std::stoul(value));
+    }
+
+    iter = configs.find(EXTENSION_KEY_HETEROGENEOUS_PARTITION);
+    if (iter != configs.end()) {
+        // The value is "true" or "false".
+        std::string value(iter->second.begin(), iter->second.end());
+        value = value.substr(0, value.find('\0'));
+        if ((value != "true") && (value != "false")) {
+            LOGE("[NNCompiler] SetExtensionConfig failed, %{public}s should be true or false.",
+                 EXTENSION_KEY_HETEROGENEOUS_PARTITION);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        m_isPartitionEnabled = (value == "true");
+    }
+
+    iter = configs.find(EXTENSION_KEY_CONST_TENSOR_ALIGNMENT);
+    if (iter != configs.end()) {
+        // The value is a decimal string of a power of two, e.g. "64" or "4096" to align the constants to pages.
+        std::string value(iter->second.begin(), iter->second.end());
+        value = value.substr(0, value.find('\0'));
+        size_t alignment = 0;
+        if (!value.empty() && (value.find_first_not_of("0123456789") == std::string::npos) &&
+            (value.size() <= MAX_CONST_TENSOR_ALIGNMENT_DIGITS)) {
+            alignment = static_cast<size_t>(std::stoul(value));
+        }
+        if ((alignment == 0) || ((alignment & (alignment - 1)) != 0) || (alignment > MAX_CONST_TENSOR_ALIGNMENT)) {
+            LOGE("[NNCompiler] SetExtensionConfig failed, %{public}s should be a power of two not larger than "
+                 "%{public}zu.", EXTENSION_KEY_CONST_TENSOR_ALIGNMENT, MAX_CONST_TENSOR_ALIGNMENT);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        m_constTensorAlignment = alignment;
+    }
+
+    iter = configs.find(EXTENSION_KEY_PREPARED_MODEL_MEMORY_LIMIT);
+    if (iter != configs.end()) {
+        // The value is a decimal string of bytes, e.g. "268435456". It applies to the whole process, "0" disables
+        // sharing the prepared models between compilations.
+        std::string value(iter->second.begin(), iter->second.end());
+        value = value.substr(0, value.find('\0'));
+        if (value.empty() || (value.find_first_not_of("0123456789") != std::string::npos) ||
+            (value.size() > MAX_PREPARED_MODEL_MEMORY_LIMIT_DIGITS)) {
+            LOGE("[NNCompiler] SetExtensionConfig failed, %{public}s should be a non-negative integer.",
+                 EXTENSION_KEY_PREPARED_MODEL_MEMORY_LIMIT);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        PreparedModelCache::GetInstance().SetMemoryLimit(static_cast<size_t>(std::stoull(value)));
+    }
+
+    // The configs not consumed by the runtime are passed to the device, e.g. the input dim ranges of a model. The
+    // dynamic batching configs are consumed by the request batcher of the compilation.
+    m_extensions.clear();
+    for (const auto& config : configs) {
+        if ((config.first != EXTENSION_KEY_CACHE_WORKER_NUM) &&
+            (config.first != EXTENSION_KEY_CONST_TENSOR_ALIGNMENT) &&
+            (config.first != EXTENSION_KEY_HETEROGENEOUS_PARTITION) &&
+            (config.first != EXTENSION_KEY_PREPARED_MODEL_MEMORY_LIMIT) &&
+            (config.first != EXTENSION_KEY_DYNAMIC_BATCH_MAX_SIZE) &&
+            (config.first != EXTENSION_KEY_DYNAMIC_BATCH_TIMEOUT)) {
+            m_extensions.emplace(config.first, std::vector<int8_t>(config.second.begin(), config.second.end()));
+        }
+    }
+
     LOGI("[NNCompiler] SetExtensionConfig successfully.");
     return OH_NN_SUCCESS;
 }
@@ -634,8 +1127,22 @@ OH_NN_ReturnCode NNCompiler::SetOptions(const std::vector<std::shared_ptr<void>>
     return OH_NN_UNSUPPORTED;
 }
 
-NNExecutor* NNCompiler::CreateExecutor()
+void NNCompiler::SetCacheSaveDeferred(bool isDeferred)
+{
+    m_isCacheSaveDeferred = isDeferred;
+}
+
+bool NNCompiler::IsCacheSavePending() const
+{
+    return m_isCacheSavePending;
+}
+
+Executor* NNCompiler::CreateExecutor()
 {
+    if (!m_partitionCompilers.empty()) {
+        return CreatePipelineExecutor();
+    }
+
     if (m_device == nullptr) {
         LOGE("[NNCompiler] CreateExecutor failed, m_device is nullptr");
         return nullptr;
@@ -666,6 +1173,36 @@ NNExecutor* NNCompiler::CreateExecutor()
     return nnExecutor;
 }
 
+Executor* NNCompiler::CreatePipelineExecutor()
+{
+    std::vector<PipelineStage> stages = m_pipelineStages;
+    auto destroyStageExecutors = [&stages]() {
+        for (auto& stage : stages) {
+            delete stage.executor;
+            stage.executor = nullptr;
+        }
+    };
+
+    for (size_t i = 0; i < stages.size(); ++i) {
+        stages[i].executor = m_partitionCompilers[i]->CreateExecutor();
+        if (stages[i].executor == nullptr) {
+            LOGE("[NNCompiler] CreateExecutor failed, fail to create the executor of partition %{public}zu.", i);
+            destroyStageExecutors();
+            return nullptr;
+        }
+    }
+
+    PipelineExecutor* pipelineExecutor = new (std::nothrow) PipelineExecutor(
+        m_backendID, m_inputTensorDescs.size(), m_outputTensorDescs.size(), stages, m_intermediateTensorDescs);
+    if (pipelineExecutor == nullptr) {
+        LOGE("[NNCompiler] CreateExecutor failed, error happend when allocating Pipeline Executor.");
+        destroyStageExecutors();
+        return nullptr;
+    }
+
+    return pipelineExecutor;
+}
+
 OH_NN_ReturnCode NNCompiler::SerializeTensorsToBuffer(
     const std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>>& tensorDescs, Buffer& buffer) const
 {
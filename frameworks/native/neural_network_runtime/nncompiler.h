@@ -23,6 +23,11 @@
 #include "inner_model.h"
 #include "prepared_model.h"
 #include "nnexecutor.h"
+#include "nncompiled_cache.h"
+#include "prepared_model_cache.h"
+#include "const_tensor_packer.h"
+#include "graph_partitioner.h"
+#include "pipeline_executor.h"
 
 namespace OHOS {
 namespace NeuralNetworkRuntime {
@@ -32,6 +37,7 @@ public:
     NNCompiler() = delete;
     NNCompiler(std::shared_ptr<Device> device, size_t backendID);
     NNCompiler(const void* model, std::shared_ptr<Device> device, size_t backendID);
+    NNCompiler(const GraphPartition& partition, std::shared_ptr<Device> device);
     ~NNCompiler() override;
 
     size_t GetBackendID() const override;
@@ -51,12 +57,18 @@ public:
 
     OH_NN_ReturnCode SetExtensionConfig(const std::unordered_map<std::string, std::vector<char>>& configs) override;
     OH_NN_ReturnCode SetOptions(const std::vector<std::shared_ptr<void>>& options) override;
+    void SetCacheSaveDeferred(bool isDeferred) override;
+    bool IsCacheSavePending() const override;
 
-    NNExecutor* CreateExecutor();
+    // Returns a PipelineExecutor running the partitions if the model has been split across backends.
+    Executor* CreateExecutor();
 
 private:
     void ReleaseBuffer(std::vector<Buffer>& buffers) const;
     void ReleaseBufferByDevice(std::vector<Buffer>& buffers) const;
+    OH_NN_ReturnCode GenerateCaches(std::vector<Buffer>& caches, std::vector<Buffer>& tensorBuffers) const;
+    OH_NN_ReturnCode PrepareFromCaches(const std::vector<Buffer>& caches);
+    OH_NN_ReturnCode ShareCachesWithDevice(std::vector<Buffer>& caches, std::vector<Buffer>& deviceBuffers) const;
     OH_NN_ReturnCode SerializeTensorsToBuffer(
         const std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>>& tensorDescs,
         Buffer& buffer) const;
@@ -64,7 +76,16 @@ private:
         const Buffer& buffer, std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>>& tensorDescs);
 
     OH_NN_ReturnCode NormalBuild();
+    OH_NN_ReturnCode PartitionBuild();
+    OH_NN_ReturnCode BuildPartition(const GraphPartition& partition, std::unique_ptr<NNCompiler>& compiler) const;
+    OH_NN_ReturnCode CreatePipelineStages(const std::vector<GraphPartition>& partitions,
+                                          std::vector<PipelineStage>& stages,
+                                          std::vector<std::shared_ptr<TensorDesc>>& intermediateTensorDescs) const;
+    Executor* CreatePipelineExecutor();
     OH_NN_ReturnCode BuildOfflineModel();
+    bool GetPreparedModelKey(PreparedModelKey& key) const;
+    bool RestoreFromPreparedModelCache(const PreparedModelKey& key);
+    void AddToPreparedModelCache(const PreparedModelKey& key) const;
     OH_NN_ReturnCode CheckModelParameter() const;
     OH_NN_ReturnCode IsOfflineModel(bool& isOfflineModel) const;
     OH_NN_ReturnCode IsSupportedModel(const std::shared_ptr<mindspore::lite::LiteGraph>& liteGraph,
@@ -73,22 +94,35 @@ private:
 private:
     bool m_isBuild {false};
     bool m_enableFp16 {false};
+    bool m_isCacheSaveDeferred {false};
+    // Set by a build whose cache saving is deferred, and reset once SaveToCacheFile has run.
+    mutable bool m_isCacheSavePending {false};
     std::string m_cachePath;
     uint32_t m_cacheVersion {0};
+    size_t m_cacheWorkerNum {DEFAULT_CACHE_WORKER_NUM};
+    size_t m_constTensorAlignment {DEFAULT_CONST_TENSOR_ALIGNMENT};
+    bool m_isPartitionEnabled {false};
     std::shared_ptr<Device> m_device {nullptr};
     size_t m_backendID {0};
     OH_NN_Priority m_priority {OH_NN_PRIORITY_NONE};
     OH_NN_PerformanceMode m_performance {OH_NN_PERFORMANCE_NONE};
     std::shared_ptr<PreparedModel> m_preparedModel {nullptr};
+    size_t m_preparedModelSize {0};
     Buffer m_quantBuffer {nullptr, 0};
     std::string m_modelName;
     std::string m_isProfiling;
     std::map<std::string, std::string> m_opLayouts;
+    std::map<std::string, std::vector<int8_t>> m_extensions;
     void* m_metaGraph {nullptr};
     InnerModel* m_innerModel {nullptr};
     std::shared_ptr<mindspore::lite::LiteGraph> m_liteGraph {nullptr};
     std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> m_inputTensorDescs;
     std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> m_outputTensorDescs;
+
+    // Partitions of a model split across backends, one compiler and one pipeline stage per partition
+    std::vector<std::unique_ptr<NNCompiler>> m_partitionCompilers;
+    std::vector<PipelineStage> m_pipelineStages;
+    std::vector<std::shared_ptr<TensorDesc>> m_intermediateTensorDescs;
 };
 } // NeuralNetworkRuntime
 } // OHOS
@@ -15,6 +15,10 @@
 
 
 #include "nnexecutor.h"
+
+#include <algorithm>
+#include <cstdint>
+
 #include "nntensor.h"
 #include "common/log.h"
 #include "cpp_type.h"
@@ -26,6 +30,10 @@
 
 namespace OHOS {
 namespace NeuralNetworkRuntime {
+namespace {
+constexpr size_t OUTPUT_GROWTH_FACTOR = 2;
+}
+
 NNExecutor::NNExecutor(size_t backendID, std::shared_ptr<Device> device, std::shared_ptr<PreparedModel> preparedModel,
     const std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>>& inputTensorDescs,
     const std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>>& outputTensorDescs)
@@ -33,7 +41,21 @@ NNExecutor::NNExecutor(size_t backendID, std::shared_ptr<Device> device, std::sh
     m_device(device),
     m_preparedModel(preparedModel),
     m_inputTensorDescs(inputTensorDescs),
-    m_outputTensorDescs(outputTensorDescs) {}
+    m_outputTensorDescs(outputTensorDescs)
+{
+    // The dim ranges are fixed once the model is prepared, query them from the device only once.
+    if (m_preparedModel != nullptr) {
+        m_dimRangesRet = m_preparedModel->GetInputDimRanges(m_minInputDims, m_maxInputDims);
+    }
+    if (m_dimRangesRet == OH_NN_SUCCESS) {
+        for (size_t i = 0; i < m_minInputDims.size(); ++i) {
+            m_minInputDimRanges.emplace_back(m_minInputDims[i].begin(), m_minInputDims[i].end());
+        }
+        for (size_t i = 0; i < m_maxInputDims.size(); ++i) {
+            m_maxInputDimRanges.emplace_back(m_maxInputDims[i].begin(), m_maxInputDims[i].end());
+        }
+    }
+}
 
 OH_NN_ReturnCode NNExecutor::GetInputDimRange(
     size_t inputIndex, size_t** minInputDims, size_t** maxInputDims, size_t* shapeNum) const
@@ -51,33 +73,31 @@ OH_NN_ReturnCode NNExecutor::GetInputDimRange(
         return OH_NN_INVALID_PARAMETER;
     }
 
-    std::vector<std::vector<uint32_t>> minInputDimsVec;
-    std::vector<std::vector<uint32_t>> maxInputDimsVec;
-    OH_NN_ReturnCode oldRet = m_preparedModel->GetInputDimRanges(minInputDimsVec, maxInputDimsVec);
-    if (oldRet != OH_NN_SUCCESS) {
+    if (m_dimRangesRet != OH_NN_SUCCESS) {
         LOGW("NNExecutor::GetInputDimRange failed, current version don't support get input dim ranges.");
         return OH_NN_OPERATION_FORBIDDEN;
     }
 
-    if (minInputDimsVec.size() != maxInputDimsVec.size()) {
+    if (m_minInputDimRanges.size() != m_maxInputDimRanges.size()) {
         LOGE("NNExecutor::GetInputDimRange failed, size of minInputDimsVec is not equal to maxInputDimsVec.");
         return OH_NN_INVALID_PARAMETER;
     }
-    if (inputIndex >= minInputDimsVec.size()) {
+    if (inputIndex >= m_minInputDimRanges.size()) {
         LOGE("NNExecutor::GetInputDimRange failed, inputIndex[%{public}zu] is out of range.", inputIndex);
         return OH_NN_INVALID_PARAMETER;
     }
 
-    std::vector<uint32_t> minInputDimVec = minInputDimsVec[inputIndex];
-    std::vector<uint32_t> maxInputDimVec = maxInputDimsVec[inputIndex];
+    // The returned arrays are owned by the executor and stay valid until it is destroyed.
+    const std::vector<size_t>& minInputDimVec = m_minInputDimRanges[inputIndex];
+    const std::vector<size_t>& maxInputDimVec = m_maxInputDimRanges[inputIndex];
     if (minInputDimVec.size() != maxInputDimVec.size()) {
         LOGE("NNExecutor::GetInputDimRange failed, size of the min input dims is not equal to the max input"
              " dims of the %{public}zuth input.", inputIndex);
         return OH_NN_INVALID_PARAMETER;
     }
     *shapeNum = minInputDimVec.size();
-    *minInputDims = reinterpret_cast<size_t*>(minInputDimVec.data());
-    *maxInputDims = reinterpret_cast<size_t*>(maxInputDimVec.data());
+    *minInputDims = const_cast<size_t*>(minInputDimVec.data());
+    *maxInputDims = const_cast<size_t*>(maxInputDimVec.data());
     return OH_NN_SUCCESS;
 }
 
@@ -162,14 +182,26 @@ NN_TensorDesc* NNExecutor::CreateOutputTensorDesc(size_t index) const
 
 OH_NN_ReturnCode NNExecutor::SetOnRunDone(NN_OnRunDone onRunDone)
 {
-    LOGE("NNExecutor::SetOnRunDone failed, SetOnRunDone is not supported.");
-    return OH_NN_OPERATION_FORBIDDEN;
+    std::lock_guard<std::mutex> lock(m_asyncMtx);
+    if (m_pendingAsyncRunNum != 0) {
+        LOGE("NNExecutor::SetOnRunDone failed, there are %{public}zu asynchronous executions in flight.",
+            m_pendingAsyncRunNum);
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    m_onRunDone = onRunDone;
+    return OH_NN_SUCCESS;
 }
 
 OH_NN_ReturnCode NNExecutor::SetOnServiceDied(NN_OnServiceDied onServiceDied)
 {
-    LOGE("NNExecutor::SetOnServiceDied failed, SetOnServiceDied is not supported.");
-    return OH_NN_OPERATION_FORBIDDEN;
+    std::lock_guard<std::mutex> lock(m_asyncMtx);
+    if (m_pendingAsyncRunNum != 0) {
+        LOGE("NNExecutor::SetOnServiceDied failed, there are %{public}zu asynchronous executions in flight.",
+            m_pendingAsyncRunNum);
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    m_onServiceDied = onServiceDied;
+    return OH_NN_SUCCESS;
 }
 
 OH_NN_ReturnCode NNExecutor::RunSync(NN_Tensor* inputTensors[], size_t inputSize,
@@ -186,6 +218,14 @@ OH_NN_ReturnCode NNExecutor::RunSync(NN_Tensor* inputTensors[], size_t inputSize
         return OH_NN_INVALID_PARAMETER;
     }
 
+    std::lock_guard<std::mutex> runLock(m_runMtx);
+    return RunSyncLocked(inputTensors, inputSize, outputTensors, outputSize);
+}
+
+OH_NN_ReturnCode NNExecutor::RunSyncLocked(NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize)
+{
+    // Called with m_runMtx locked, the scratch storage and the output descs are shared by all runs of the executor.
     OH_NN_ReturnCode ret {OH_NN_FAILED};
     ret = CheckInputDimRanges(inputTensors, inputSize);
     if (ret != OH_NN_OPERATION_FORBIDDEN && ret != OH_NN_SUCCESS) {
@@ -193,47 +233,285 @@ OH_NN_ReturnCode NNExecutor::RunSync(NN_Tensor* inputTensors[], size_t inputSize
         return ret;
     }
 
-    OHOS::NeuralNetworkRuntime::IOTensor tensor;
-    std::vector<NN_Tensor*> inputTensorsVec;
     for (size_t i = 0; i < inputSize; ++i) {
         if (inputTensors[i] == nullptr) {
             LOGE("NNExecutor::RunSync failed, input[%{public}zu] is nullptr.", i);
             return OH_NN_INVALID_PARAMETER;
         }
-        inputTensorsVec.emplace_back(inputTensors[i]);
     }
-
-    std::vector<NN_Tensor*> outputTensorsVec;
     for (size_t i = 0; i < outputSize; ++i) {
         if (outputTensors[i] == nullptr) {
             LOGE("NNExecutor::RunSync failed, output[%{public}zu] is nullptr.", i);
             return OH_NN_INVALID_PARAMETER;
         }
-        outputTensorsVec.emplace_back(outputTensors[i]);
     }
 
-    std::vector<std::vector<int32_t>> outputsDims;
-    std::vector<bool> isSufficientDataBuffer;
-
-    ret = m_preparedModel->Run(inputTensorsVec, outputTensorsVec, outputsDims, isSufficientDataBuffer);
+    // The scratch vectors keep their capacity between runs, they are cleared before each run.
+    m_runInputTensors.assign(inputTensors, inputTensors + inputSize);
+    m_runOutputTensors.assign(outputTensors, outputTensors + outputSize);
+    ret = RunPreparedModel(m_runInputTensors, m_runOutputTensors);
     if (ret != OH_NN_SUCCESS) {
         LOGE("NNExecutor::RunSync failed, failed to run in prepared model.");
         return ret;
     }
 
+    return UpdateOutputShapes(m_runOutputTensors, m_runOutputsDims);
+}
+
+OH_NN_ReturnCode NNExecutor::SetOutputAutoGrowth(bool enable)
+{
+    // The high water marks are read and grown by the runs in progress.
+    std::lock_guard<std::mutex> runLock(m_runMtx);
+    m_isOutputAutoGrowth = enable;
+    m_outputHighWaterMarks.resize(m_outputTensorDescs.size(), 0);
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNExecutor::RunPreparedModelOnce(const std::vector<NN_Tensor*>& inputTensors,
+    const std::vector<NN_Tensor*>& outputTensors, const IOBinding* binding)
+{
+    // Some devices append the output dims to the vector, drop those of the previous run first.
+    m_runOutputsDims.clear();
+    if ((binding != nullptr) && binding->isDeviceBound) {
+        return m_preparedModel->RunWithBinding(binding->deviceBindingId, m_runOutputsDims, m_runIsOutputBufferEnough);
+    }
+    return m_preparedModel->Run(inputTensors, outputTensors, m_runOutputsDims, m_runIsOutputBufferEnough);
+}
+
+OH_NN_ReturnCode NNExecutor::RebindOutputs(const IOBinding* binding)
+{
+    if ((binding == nullptr) || !binding->isDeviceBound) {
+        return OH_NN_SUCCESS;
+    }
+    return m_preparedModel->RebindOutputs(binding->deviceBindingId);
+}
+
+OH_NN_ReturnCode NNExecutor::RunPreparedModel(const std::vector<NN_Tensor*>& inputTensors,
+    const std::vector<NN_Tensor*>& outputTensors, const IOBinding* binding)
+{
+    OH_NN_ReturnCode ret {OH_NN_FAILED};
+    if (m_isOutputAutoGrowth) {
+        bool isReallocated {false};
+        ret = ReserveOutputs(outputTensors, isReallocated);
+        if ((ret == OH_NN_SUCCESS) && isReallocated) {
+            ret = RebindOutputs(binding);
+        }
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("NNExecutor::RunPreparedModel failed, failed to reserve output tensors.");
+            return ret;
+        }
+    }
+
+    ret = RunPreparedModelOnce(inputTensors, outputTensors, binding);
+    if (!m_isOutputAutoGrowth || std::all_of(m_runIsOutputBufferEnough.begin(), m_runIsOutputBufferEnough.end(),
+        [](bool isEnough) { return isEnough; })) {
+        return ret;
+    }
+
+    // The outputs are grown once to the size they need, or to their upper bound, and the model runs again.
+    ret = GrowOutputs(inputTensors, outputTensors);
+    if (ret == OH_NN_SUCCESS) {
+        ret = RebindOutputs(binding);
+    }
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("NNExecutor::RunPreparedModel failed, failed to grow output tensors.");
+        return ret;
+    }
+    return RunPreparedModelOnce(inputTensors, outputTensors, binding);
+}
+
+OH_NN_ReturnCode NNExecutor::ReserveOutputs(const std::vector<NN_Tensor*>& outputTensors, bool& isReallocated)
+{
+    isReallocated = false;
+    for (size_t i = 0; i < outputTensors.size(); ++i) {
+        NNTensor2_0* nnTensor = reinterpret_cast<NNTensor2_0*>(outputTensors[i]);
+        if (nnTensor->IsUserData() || (nnTensor->GetDataSize() >= m_outputHighWaterMarks[i])) {
+            continue;
+        }
+        OH_NN_ReturnCode ret = nnTensor->ReallocateData(m_outputHighWaterMarks[i]);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("NNExecutor::ReserveOutputs failed, failed to reallocate output %{public}zu.", i);
+            return ret;
+        }
+        isReallocated = true;
+    }
+    return OH_NN_SUCCESS;
+}
+
+size_t NNExecutor::GetOutputGrowthFactor(const std::vector<NN_Tensor*>& inputTensors) const
+{
+    // The outputs grow at most as much as the inputs can still grow within the input dim ranges.
+    size_t growthFactor = OUTPUT_GROWTH_FACTOR;
+    if ((m_dimRangesRet != OH_NN_SUCCESS) || (m_maxInputDims.size() != inputTensors.size())) {
+        return growthFactor;
+    }
+
+    for (size_t i = 0; i < inputTensors.size(); ++i) {
+        const TensorDesc* desc = reinterpret_cast<NNTensor2_0*>(inputTensors[i])->GetTensorDesc();
+        size_t elementNum {0};
+        if ((desc == nullptr) || (desc->GetElementNum(&elementNum) != OH_NN_SUCCESS) || (elementNum == 0)) {
+            continue;
+        }
+
+        size_t maxElementNum {1};
+        for (uint32_t dim : m_maxInputDims[i]) {
+            if ((dim != 0) && (maxElementNum > SIZE_MAX / dim)) {
+                maxElementNum = SIZE_MAX;
+                break;
+            }
+            maxElementNum *= dim;
+        }
+        growthFactor = std::max(growthFactor, maxElementNum / elementNum + ((maxElementNum % elementNum) != 0));
+    }
+    return growthFactor;
+}
+
+OH_NN_ReturnCode NNExecutor::GrowOutputs(const std::vector<NN_Tensor*>& inputTensors,
+    const std::vector<NN_Tensor*>& outputTensors)
+{
+    if (m_runIsOutputBufferEnough.size() != outputTensors.size()) {
+        LOGE("NNExecutor::GrowOutputs failed, size of isOutputBufferEnough is not equal to outputTensors.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    // Devices which report the output dims along with the failure tell the exact sizes.
+    bool isOutputsDimsValid = (m_runOutputsDims.size() == outputTensors.size());
+    size_t growthFactor = isOutputsDimsValid ? 1 : GetOutputGrowthFactor(inputTensors);
+
+    for (size_t i = 0; i < outputTensors.size(); ++i) {
+        if (m_runIsOutputBufferEnough[i]) {
+            continue;
+        }
+        NNTensor2_0* nnTensor = reinterpret_cast<NNTensor2_0*>(outputTensors[i]);
+        if (nnTensor->IsUserData()) {
+            LOGE("NNExecutor::GrowOutputs failed, output %{public}zu is created with fd and cannot grow.", i);
+            return OH_NN_INVALID_PARAMETER;
+        }
+
+        size_t dataSize = std::max<size_t>(nnTensor->GetDataSize(), 1);
+        size_t newSize = (dataSize > SIZE_MAX / growthFactor) ? SIZE_MAX : dataSize * growthFactor;
+        OH_NN_DataType dataType {OH_NN_UNKNOWN};
+        if (isOutputsDimsValid && (nnTensor->GetTensorDesc()->GetDataType(&dataType) == OH_NN_SUCCESS)) {
+            newSize = GetTypeSize(dataType);
+            for (int32_t dim : m_runOutputsDims[i]) {
+                newSize *= static_cast<size_t>(std::max(dim, 0));
+            }
+        }
+        newSize = std::max(newSize, m_outputHighWaterMarks[i]);
+
+        OH_NN_ReturnCode ret = nnTensor->ReallocateData(newSize);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("NNExecutor::GrowOutputs failed, failed to reallocate output %{public}zu.", i);
+            return ret;
+        }
+        m_outputHighWaterMarks[i] = newSize;
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNExecutor::BindIOTensors(NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize, size_t* bindingId)
+{
+    if (m_inputTensorDescs.size() != inputSize || m_outputTensorDescs.size() != outputSize) {
+        LOGE("NNExecutor::BindIOTensors failed, inputSize:%{public}zu or outputSize:%{public}zu is not equal to "
+            "that of model.", inputSize, outputSize);
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (std::find(inputTensors, inputTensors + inputSize, nullptr) != inputTensors + inputSize ||
+        std::find(outputTensors, outputTensors + outputSize, nullptr) != outputTensors + outputSize) {
+        LOGE("NNExecutor::BindIOTensors failed, input or output tensor is nullptr.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    IOBinding binding;
+    binding.inputs.assign(inputTensors, inputTensors + inputSize);
+    binding.outputs.assign(outputTensors, outputTensors + outputSize);
+    OH_NN_ReturnCode ret = m_preparedModel->BindIOTensors(binding.inputs, binding.outputs, binding.deviceBindingId);
+    if (ret != OH_NN_SUCCESS && ret != OH_NN_OPERATION_FORBIDDEN) {
+        LOGE("NNExecutor::BindIOTensors failed, failed to bind tensors to prepared model.");
+        return ret;
+    }
+    binding.isDeviceBound = (ret == OH_NN_SUCCESS);
+
+    std::lock_guard<std::mutex> lock(m_bindingMtx);
+    *bindingId = m_nextBindingId++;
+    m_ioBindings.emplace(*bindingId, std::move(binding));
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNExecutor::RunSyncWithBinding(size_t bindingId)
+{
+    std::lock_guard<std::mutex> runLock(m_runMtx);
+    std::lock_guard<std::mutex> lock(m_bindingMtx);
+    auto iter = m_ioBindings.find(bindingId);
+    if (iter == m_ioBindings.end()) {
+        LOGE("NNExecutor::RunSyncWithBinding failed, binding %{public}zu does not exist.", bindingId);
+        return OH_NN_INVALID_PARAMETER;
+    }
+    IOBinding& binding = iter->second;
+
+    OH_NN_ReturnCode ret = CheckInputDimRanges(binding.inputs.data(), binding.inputs.size());
+    if (ret != OH_NN_OPERATION_FORBIDDEN && ret != OH_NN_SUCCESS) {
+        LOGE("NNExecutor::RunSyncWithBinding failed, failed to check input dim ranges.");
+        return ret;
+    }
+
+    ret = RunPreparedModel(binding.inputs, binding.outputs, &binding);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("NNExecutor::RunSyncWithBinding failed, failed to run in prepared model.");
+        return ret;
+    }
+
+    return UpdateOutputShapes(binding.outputs, m_runOutputsDims);
+}
+
+OH_NN_ReturnCode NNExecutor::UnbindIOTensors(size_t bindingId)
+{
+    std::lock_guard<std::mutex> lock(m_bindingMtx);
+    auto iter = m_ioBindings.find(bindingId);
+    if (iter == m_ioBindings.end()) {
+        LOGE("NNExecutor::UnbindIOTensors failed, binding %{public}zu does not exist.", bindingId);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    if (iter->second.isDeviceBound) {
+        m_preparedModel->UnbindIOTensors(iter->second.deviceBindingId);
+    }
+    m_ioBindings.erase(iter);
+    return OH_NN_SUCCESS;
+}
+
+bool NNExecutor::IsSameShape(const TensorDesc& tensorDesc, const std::vector<int32_t>& dims) const
+{
+    int32_t* shape {nullptr};
+    size_t shapeNum {0};
+    if (tensorDesc.GetShape(&shape, &shapeNum) != OH_NN_SUCCESS) {
+        return false;
+    }
+    return (shapeNum == dims.size()) && std::equal(dims.begin(), dims.end(), shape);
+}
+
+OH_NN_ReturnCode NNExecutor::UpdateOutputShapes(const std::vector<NN_Tensor*>& outputTensors,
+    const std::vector<std::vector<int32_t>>& outputsDims)
+{
     // Set the output NNTensor2_0's dimensions from output IOTensor if it is dynamic.
     // NNTensor2_0::SetDimensions will check if the tensor buffer is enough for the new dimensions.
-    if (outputsDims.size() != outputSize) {
+    if (outputsDims.size() != outputTensors.size()) {
         LOGE("NNExecutor::RunSync failed, size of outputsDims is not equal to outputTensors.");
         return OH_NN_INVALID_PARAMETER;
     }
-    for (size_t i = 0; i < outputSize; ++i) {
+    OH_NN_ReturnCode ret {OH_NN_FAILED};
+    for (size_t i = 0; i < outputTensors.size(); ++i) {
         NNTensor2_0* nnTensor = reinterpret_cast<NNTensor2_0*>(outputTensors[i]);
         TensorDesc* nnTensorDesc = nnTensor->GetTensorDesc();
         if (nnTensorDesc == nullptr) {
             LOGE("NNExecutor::RunSync failed, failed to get desc from tensor.");
             return OH_NN_NULL_PTR;
         }
+        // Static outputs and dynamic outputs of an unchanged shape keep their descs.
+        if (IsSameShape(*nnTensorDesc, outputsDims[i]) &&
+            IsSameShape(*(m_outputTensorDescs[i].first), outputsDims[i])) {
+            continue;
+        }
         ret = nnTensorDesc->SetShape(outputsDims[i].data(), outputsDims[i].size());
         if (ret != OH_NN_SUCCESS) {
             LOGE("NNExecutor::RunSync failed, error happened when setting output tensor's dimensions,"
@@ -253,8 +531,390 @@ OH_NN_ReturnCode NNExecutor::RunSync(NN_Tensor* inputTensors[], size_t inputSize
 OH_NN_ReturnCode NNExecutor::RunAsync(NN_Tensor* inputTensors[], size_t inputSize,
     NN_Tensor* outputTensors[], size_t outputSize, int32_t timeout, void* userData)
 {
-    LOGE("NNExecutor::RunAsync failed, RunAsync is not supported.");
-    return OH_NN_OPERATION_FORBIDDEN;
+    if (timeout <= 0) {
+        LOGE("NNExecutor::RunAsync failed, timeout:%{public}d must be greater than 0.", timeout);
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (m_inputTensorDescs.size() != inputSize) {
+        LOGE("NNExecutor::RunAsync failed, inputSize:%{public}zu is not equal to model input size:%{public}zu",
+            inputSize, m_inputTensorDescs.size());
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (m_outputTensorDescs.size() != outputSize) {
+        LOGE("NNExecutor::RunAsync failed, outputSize:%{public}zu is not equal to model output size:%{public}zu",
+            outputSize, m_outputTensorDescs.size());
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    // The tensor arrays belong to the caller, keep a copy of the handles for the worker thread.
+    std::vector<NN_Tensor*> inputTensorsVec;
+    for (size_t i = 0; i < inputSize; ++i) {
+        if (inputTensors[i] == nullptr) {
+            LOGE("NNExecutor::RunAsync failed, input[%{public}zu] is nullptr.", i);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        inputTensorsVec.emplace_back(inputTensors[i]);
+    }
+    std::vector<NN_Tensor*> outputTensorsVec;
+    for (size_t i = 0; i < outputSize; ++i) {
+        if (outputTensors[i] == nullptr) {
+            LOGE("NNExecutor::RunAsync failed, output[%{public}zu] is nullptr.", i);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        outputTensorsVec.emplace_back(outputTensors[i]);
+    }
+
+    std::lock_guard<std::mutex> lock(m_asyncMtx);
+    if (m_onRunDone == nullptr) {
+        LOGE("NNExecutor::RunAsync failed, please call OH_NNExecutor_SetOnRunDone first.");
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    if (m_asyncRunPool == nullptr) {
+        m_asyncRunPool = AsyncRunPool::GetPool(m_backendID);
+        if (m_asyncRunPool == nullptr) {
+            LOGE("NNExecutor::RunAsync failed, failed to get async run pool of backend %{public}zu.", m_backendID);
+            return OH_NN_MEMORY_ERROR;
+        }
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+    auto task = [this, inputs = std::move(inputTensorsVec), outputs = std::move(outputTensorsVec),
+        deadline, userData]() mutable {
+        RunAsyncTask(inputs, outputs, deadline, userData);
+    };
+    OH_NN_ReturnCode ret = m_asyncRunPool->Submit(this, std::move(task));
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("NNExecutor::RunAsync failed, failed to submit the asynchronous execution.");
+        return ret;
+    }
+    ++m_pendingAsyncRunNum;
+    return OH_NN_SUCCESS;
+}
+
+void NNExecutor::RunAsyncTask(std::vector<NN_Tensor*>& inputTensors, std::vector<NN_Tensor*>& outputTensors,
+    std::chrono::steady_clock::time_point deadline, void* userData)
+{
+    OH_NN_ReturnCode ret {OH_NN_FAILED};
+    {
+        // Requests on the same prepared model are serialized, requests of different executors run in parallel.
+        std::lock_guard<std::mutex> runLock(m_runMtx);
+        if (std::chrono::steady_clock::now() >= deadline) {
+            LOGE("NNExecutor::RunAsync failed, the execution timed out before being scheduled.");
+            ret = OH_NN_TIMEOUT;
+        } else {
+            ret = RunSyncLocked(inputTensors.data(), inputTensors.size(), outputTensors.data(),
+                outputTensors.size());
+            if (ret == OH_NN_SUCCESS && std::chrono::steady_clock::now() > deadline) {
+                LOGE("NNExecutor::RunAsync failed, the execution exceeded its time limit.");
+                ret = OH_NN_TIMEOUT;
+            }
+        }
+    }
+
+    NN_OnRunDone onRunDone {nullptr};
+    NN_OnServiceDied onServiceDied {nullptr};
+    {
+        // After the counter is decreased the executor may be destroyed, so don't touch the members any more.
+        std::lock_guard<std::mutex> lock(m_asyncMtx);
+        onRunDone = m_onRunDone;
+        onServiceDied = m_onServiceDied;
+        --m_pendingAsyncRunNum;
+        m_asyncCond.notify_all();
+    }
+
+    // HDI prepared models report OH_NN_UNAVAILABLE_DEVICE when the driver service fails during execution.
+    if (ret == OH_NN_UNAVAILABLE_DEVICE && onServiceDied != nullptr) {
+        onServiceDied(userData);
+    }
+
+    if (ret != OH_NN_SUCCESS) {
+        onRunDone(userData, ret, nullptr, 0);
+        return;
+    }
+    onRunDone(userData, ret, reinterpret_cast<void**>(outputTensors.data()),
+        static_cast<int32_t>(outputTensors.size()));
+}
+
+OH_NN_ReturnCode NNExecutor::RunBatch(NN_Tensor* inputTensors[], size_t inputSize,
+    NN_Tensor* outputTensors[], size_t outputSize, size_t batchSize)
+{
+    if (m_inputTensorDescs.size() != inputSize) {
+        LOGE("NNExecutor::RunBatch failed, inputSize:%{public}zu is not equal to model input size:%{public}zu",
+            inputSize, m_inputTensorDescs.size());
+        return OH_NN_INVALID_PARAMETER;
+    }
+    if (m_outputTensorDescs.size() != outputSize) {
+        LOGE("NNExecutor::RunBatch failed, outputSize:%{public}zu is not equal to model output size:%{public}zu",
+            outputSize, m_outputTensorDescs.size());
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    // Split the flat tensor arrays into requests.
+    std::vector<std::vector<NN_Tensor*>> inputs(batchSize);
+    std::vector<std::vector<NN_Tensor*>> outputs(batchSize);
+    OH_NN_ReturnCode ret {OH_NN_FAILED};
+    for (size_t i = 0; i < batchSize; ++i) {
+        for (size_t j = 0; j < inputSize; ++j) {
+            if (inputTensors[i * inputSize + j] == nullptr) {
+                LOGE("NNExecutor::RunBatch failed, input[%{public}zu] of request %{public}zu is nullptr.", j, i);
+                return OH_NN_INVALID_PARAMETER;
+            }
+            inputs[i].emplace_back(inputTensors[i * inputSize + j]);
+        }
+        for (size_t j = 0; j < outputSize; ++j) {
+            if (outputTensors[i * outputSize + j] == nullptr) {
+                LOGE("NNExecutor::RunBatch failed, output[%{public}zu] of request %{public}zu is nullptr.", j, i);
+                return OH_NN_INVALID_PARAMETER;
+            }
+            outputs[i].emplace_back(outputTensors[i * outputSize + j]);
+        }
+
+        ret = CheckInputDimRanges(inputs[i].data(), inputSize);
+        if (ret != OH_NN_OPERATION_FORBIDDEN && ret != OH_NN_SUCCESS) {
+            LOGE("NNExecutor::RunBatch failed, failed to check input dim ranges of request %{public}zu.", i);
+            return ret;
+        }
+    }
+
+    std::lock_guard<std::mutex> runLock(m_runMtx);
+    ret = RunStackedBatch(inputs, outputs);
+    if (ret != OH_NN_OPERATION_FORBIDDEN) {
+        return ret;
+    }
+
+    std::vector<std::vector<std::vector<int32_t>>> outputsDims;
+    ret = m_preparedModel->RunBatch(inputs, outputs, outputsDims);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("NNExecutor::RunBatch failed, failed to run batch in prepared model.");
+        return ret;
+    }
+    if (outputsDims.size() != batchSize) {
+        LOGE("NNExecutor::RunBatch failed, size of outputsDims is not equal to batch size.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+    for (size_t i = 0; i < batchSize; ++i) {
+        ret = UpdateOutputShapes(outputs[i], outputsDims[i]);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("NNExecutor::RunBatch failed, failed to update output shapes of request %{public}zu.", i);
+            return ret;
+        }
+    }
+    return OH_NN_SUCCESS;
+}
+
+bool NNExecutor::IsBatchStackable(const std::vector<std::vector<NN_Tensor*>>& inputs) const
+{
+    if (inputs.size() <= 1) {
+        return false;
+    }
+
+    const std::vector<std::vector<uint32_t>>& maxInputDims = m_maxInputDims;
+    if ((m_dimRangesRet != OH_NN_SUCCESS) || (maxInputDims.size() != m_inputTensorDescs.size())) {
+        return false;
+    }
+
+    // Requests can be stacked if the first dimension of every input is dynamic, and all requests have the same shape.
+    for (size_t i = 0; i < m_inputTensorDescs.size(); ++i) {
+        int32_t* modelShape {nullptr};
+        size_t modelShapeNum {0};
+        if ((m_inputTensorDescs[i].first->GetShape(&modelShape, &modelShapeNum) != OH_NN_SUCCESS) ||
+            (modelShapeNum == 0) || (modelShape[0] != -1) || maxInputDims[i].empty()) {
+            return false;
+        }
+
+        const TensorDesc* firstDesc = reinterpret_cast<NNTensor2_0*>(inputs[0][i])->GetTensorDesc();
+        int32_t* firstShape {nullptr};
+        size_t firstShapeNum {0};
+        if ((firstDesc == nullptr) || (firstDesc->GetShape(&firstShape, &firstShapeNum) != OH_NN_SUCCESS) ||
+            (firstShapeNum == 0) || (firstShape[0] <= 0) ||
+            (static_cast<uint64_t>(firstShape[0]) * inputs.size() > maxInputDims[i][0])) {
+            return false;
+        }
+
+        for (size_t j = 1; j < inputs.size(); ++j) {
+            const TensorDesc* desc = reinterpret_cast<NNTensor2_0*>(inputs[j][i])->GetTensorDesc();
+            int32_t* shape {nullptr};
+            size_t shapeNum {0};
+            if ((desc == nullptr) || (desc->GetShape(&shape, &shapeNum) != OH_NN_SUCCESS) ||
+                (shapeNum != firstShapeNum) || !std::equal(shape, shape + shapeNum, firstShape)) {
+                return false;
+            }
+        }
+    }
+
+    // The stacked outputs are split back into requests along their first dimension, which must follow the batch.
+    // It is decided before running, so that a batch which cannot be split is not run twice.
+    for (const auto& outputTensorDesc : m_outputTensorDescs) {
+        int32_t* modelShape {nullptr};
+        size_t modelShapeNum {0};
+        if ((outputTensorDesc.first == nullptr) ||
+            (outputTensorDesc.first->GetShape(&modelShape, &modelShapeNum) != OH_NN_SUCCESS) ||
+            (modelShapeNum == 0) || (modelShape[0] != -1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void* NNExecutor::GetBatchBuffer(std::vector<Buffer>& buffers, size_t index, size_t length)
+{
+    if (buffers.size() <= index) {
+        buffers.resize(index + 1);
+    }
+
+    Buffer& buffer = buffers[index];
+    if (buffer.length < length) {
+        if (buffer.data != nullptr) {
+            m_device->ReleaseBuffer(buffer.data);
+            buffer.data = nullptr;
+            buffer.length = 0;
+        }
+        buffer.data = m_device->AllocateBuffer(length);
+        if (buffer.data == nullptr) {
+            LOGE("NNExecutor::GetBatchBuffer failed, failed to allocate %{public}zu bytes.", length);
+            return nullptr;
+        }
+        buffer.length = length;
+    }
+    return buffer.data;
+}
+
+OH_NN_ReturnCode NNExecutor::StackBatchInputs(const std::vector<std::vector<NN_Tensor*>>& inputs,
+    std::vector<IOTensor>& stackedInputs)
+{
+    size_t batchSize = inputs.size();
+    for (size_t i = 0; i < m_inputTensorDescs.size(); ++i) {
+        const NNTensor2_0* firstTensor = reinterpret_cast<const NNTensor2_0*>(inputs[0][i]);
+        const TensorDesc* desc = firstTensor->GetTensorDesc();
+        IOTensor stackedInput;
+        const char* name {nullptr};
+        int32_t* shape {nullptr};
+        size_t shapeNum {0};
+        size_t byteSize {0};
+        if ((desc->GetName(&name) != OH_NN_SUCCESS) || (desc->GetDataType(&stackedInput.dataType) != OH_NN_SUCCESS) ||
+            (desc->GetFormat(&stackedInput.format) != OH_NN_SUCCESS) ||
+            (desc->GetShape(&shape, &shapeNum) != OH_NN_SUCCESS) || (desc->GetByteSize(&byteSize) != OH_NN_SUCCESS)) {
+            LOGE("NNExecutor::RunBatch failed, failed to get attributes of input %{public}zu.", i);
+            return OH_NN_INVALID_PARAMETER;
+        }
+
+        char* data = static_cast<char*>(GetBatchBuffer(m_batchInputBuffers, i, byteSize * batchSize));
+        if (data == nullptr) {
+            return OH_NN_MEMORY_ERROR;
+        }
+        for (size_t j = 0; j < batchSize; ++j) {
+            const NNTensor2_0* tensor = reinterpret_cast<const NNTensor2_0*>(inputs[j][i]);
+            if ((tensor->GetData() == nullptr) || (tensor->GetDataSize() < byteSize) ||
+                (memcpy_s(data + j * byteSize, byteSize, tensor->GetData(), byteSize) != EOK)) {
+                LOGE("NNExecutor::RunBatch failed, failed to copy input %{public}zu of request %{public}zu.", i, j);
+                return OH_NN_INVALID_PARAMETER;
+            }
+        }
+
+        stackedInput.name = (name != nullptr) ? name : "";
+        stackedInput.dimensions.assign(shape, shape + shapeNum);
+        stackedInput.dimensions[0] *= static_cast<int>(batchSize);
+        stackedInput.data = data;
+        stackedInput.length = byteSize * batchSize;
+        stackedInputs.emplace_back(stackedInput);
+    }
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode NNExecutor::RunStackedBatch(const std::vector<std::vector<NN_Tensor*>>& inputs,
+    const std::vector<std::vector<NN_Tensor*>>& outputs)
+{
+    if (!IsBatchStackable(inputs)) {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    // Called with m_runMtx locked, the staging buffers are reused by the following batches.
+    std::vector<IOTensor> stackedInputs;
+    OH_NN_ReturnCode ret = StackBatchInputs(inputs, stackedInputs);
+    if (ret != OH_NN_SUCCESS) {
+        return ret;
+    }
+
+    // Every request gets an equal slice of each output, which must fit in the smallest output buffer of requests.
+    size_t batchSize = inputs.size();
+    std::vector<IOTensor> stackedOutputs;
+    for (size_t i = 0; i < m_outputTensorDescs.size(); ++i) {
+        size_t sliceCapacity = reinterpret_cast<const NNTensor2_0*>(outputs[0][i])->GetDataSize();
+        for (size_t j = 1; j < batchSize; ++j) {
+            sliceCapacity = std::min(sliceCapacity, reinterpret_cast<const NNTensor2_0*>(outputs[j][i])->GetDataSize());
+        }
+        void* data = GetBatchBuffer(m_batchOutputBuffers, i, sliceCapacity * batchSize);
+        if (data == nullptr) {
+            return OH_NN_MEMORY_ERROR;
+        }
+
+        const TensorDesc* desc = m_outputTensorDescs[i].first.get();
+        IOTensor stackedOutput;
+        const char* name {nullptr};
+        int32_t* shape {nullptr};
+        size_t shapeNum {0};
+        if ((desc->GetName(&name) != OH_NN_SUCCESS) || (desc->GetDataType(&stackedOutput.dataType) != OH_NN_SUCCESS) ||
+            (desc->GetFormat(&stackedOutput.format) != OH_NN_SUCCESS) ||
+            (desc->GetShape(&shape, &shapeNum) != OH_NN_SUCCESS)) {
+            LOGE("NNExecutor::RunBatch failed, failed to get attributes of output %{public}zu.", i);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        stackedOutput.name = (name != nullptr) ? name : "";
+        stackedOutput.dimensions.assign(shape, shape + shapeNum);
+        stackedOutput.data = data;
+        stackedOutput.length = sliceCapacity * batchSize;
+        stackedOutputs.emplace_back(stackedOutput);
+    }
+
+    std::vector<std::vector<int32_t>> stackedOutputsDims;
+    std::vector<bool> isOutputBufferEnough;
+    ret = m_preparedModel->Run(stackedInputs, stackedOutputs, stackedOutputsDims, isOutputBufferEnough);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("NNExecutor::RunBatch failed, failed to run the stacked requests in prepared model.");
+        return ret;
+    }
+
+    if (stackedOutputsDims.size() != stackedOutputs.size()) {
+        LOGE("NNExecutor::RunBatch failed, size of outputsDims is not equal to the number of outputs.");
+        return OH_NN_FAILED;
+    }
+    std::vector<std::vector<int32_t>> sliceDims(stackedOutputsDims);
+    std::vector<size_t> sliceSizes;
+    for (size_t i = 0; i < sliceDims.size(); ++i) {
+        if (sliceDims[i].empty() || (sliceDims[i][0] <= 0) ||
+            (static_cast<size_t>(sliceDims[i][0]) % batchSize != 0)) {
+            LOGE("NNExecutor::RunBatch failed, output %{public}zu cannot be split into requests.", i);
+            return OH_NN_FAILED;
+        }
+        sliceDims[i][0] /= static_cast<int32_t>(batchSize);
+
+        size_t sliceSize = GetTypeSize(stackedOutputs[i].dataType);
+        for (int32_t dim : sliceDims[i]) {
+            sliceSize *= static_cast<size_t>(dim);
+        }
+        if (sliceSize * batchSize > stackedOutputs[i].length) {
+            LOGE("NNExecutor::RunBatch failed, buffer of output %{public}zu is not enough.", i);
+            return OH_NN_INVALID_PARAMETER;
+        }
+        sliceSizes.emplace_back(sliceSize);
+    }
+
+    for (size_t j = 0; j < batchSize; ++j) {
+        for (size_t i = 0; i < sliceSizes.size(); ++i) {
+            NNTensor2_0* tensor = reinterpret_cast<NNTensor2_0*>(outputs[j][i]);
+            const char* src = static_cast<const char*>(stackedOutputs[i].data) + j * sliceSizes[i];
+            if (memcpy_s(tensor->GetData(), tensor->GetDataSize(), src, sliceSizes[i]) != EOK) {
+                LOGE("NNExecutor::RunBatch failed, failed to copy output %{public}zu of request %{public}zu.", i, j);
+                return OH_NN_MEMORY_ERROR;
+            }
+        }
+        ret = UpdateOutputShapes(outputs[j], sliceDims);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("NNExecutor::RunBatch failed, failed to update output shapes of request %{public}zu.", j);
+            return ret;
+        }
+    }
+    return OH_NN_SUCCESS;
 }
 
 size_t NNExecutor::GetBackendID()
@@ -264,13 +924,12 @@ size_t NNExecutor::GetBackendID()
 
 OH_NN_ReturnCode NNExecutor::CheckInputDimRanges(NN_Tensor* inputTensors[], size_t inputSize)
 {
-    std::vector<std::vector<uint32_t>> minInputDims;
-    std::vector<std::vector<uint32_t>> maxInputDims;
-    OH_NN_ReturnCode oldRet = m_preparedModel->GetInputDimRanges(minInputDims, maxInputDims);
-    if (oldRet != OH_NN_SUCCESS) {
+    if (m_dimRangesRet != OH_NN_SUCCESS) {
         LOGW("NNExecutor::CheckInputDimRanges failed, current version don't support get input dim ranges.");
         return OH_NN_OPERATION_FORBIDDEN;
     }
+    const std::vector<std::vector<uint32_t>>& minInputDims = m_minInputDims;
+    const std::vector<std::vector<uint32_t>>& maxInputDims = m_maxInputDims;
 
     if (inputSize != minInputDims.size()) {
         LOGE("NNExecutor::CheckInputDimRanges failed, size of minInputDims:%{public}zu is not equal to "
@@ -446,13 +1105,12 @@ void NNExecutor::SetInputTensorWithNewBuffer(uint32_t index,
 
 OH_NN_ReturnCode NNExecutor::CheckInputDimRanges(uint32_t index, const OH_NN_Tensor& nnTensor) const
 {
-    std::vector<std::vector<uint32_t>> minInputDims;
-    std::vector<std::vector<uint32_t>> maxInputDims;
-    auto ret = m_preparedModel->GetInputDimRanges(minInputDims, maxInputDims);
-    if (ret != OH_NN_SUCCESS) {
-        LOGE("Get the dimension ranges of input %u failed. ErrorCode=%d", index, ret);
-        return ret;
+    if (m_dimRangesRet != OH_NN_SUCCESS) {
+        LOGE("Get the dimension ranges of input %u failed. ErrorCode=%d", index, m_dimRangesRet);
+        return m_dimRangesRet;
     }
+    const std::vector<std::vector<uint32_t>>& minInputDims = m_minInputDims;
+    const std::vector<std::vector<uint32_t>>& maxInputDims = m_maxInputDims;
 
     if (index >= minInputDims.size()) {
         LOGE("index is %u, which exceeds the size of minInputDims:%zu.", index, minInputDims.size());
@@ -705,6 +1363,8 @@ OH_NN_ReturnCode NNExecutor::SetOutput(uint32_t index, void* buffer, size_t leng
         return OH_NN_MEMORY_ERROR;
     }
 
+    // The previous buffer is managed by the executor, detach it so that the tensor does not release it.
+    m_outputTensors[index].tensor->SetBuffer(nullptr, 0);
     m_outputTensors[index].tensor->SetBuffer(deviceOutputBuffer, length);
     m_outputTensors[index].userBuffer = buffer;
     m_outputTensors[index].userBufferLength = length;
@@ -753,7 +1413,8 @@ OH_NN_ReturnCode NNExecutor::SetOutputFromMemory(uint32_t index, const OH_NN_Mem
         }
     }
 
-    // Set the output tensor with memory
+    // Set the output tensor with memory, the previous buffer is managed by the executor and only detached.
+    m_outputTensors[index].tensor->SetBuffer(nullptr, 0);
     m_outputTensors[index].tensor->SetBuffer(const_cast<const void*>(memory.data), memory.length);
     m_outputTensors[index].userBuffer = nullptr;
     m_outputTensors[index].userBufferLength = 0;
@@ -944,6 +1605,7 @@ OH_NN_ReturnCode NNExecutor::Run(const std::vector<std::shared_ptr<NNTensor>>& i
 OH_NN_ReturnCode NNExecutor::Run()
 {
     NNRT_TRACE_NAME("Execution");
+    std::lock_guard<std::mutex> runLock(m_runMtx);
     if (m_inputTensorDescs.size() != m_inputTensors.size()) {
         LOGE("Run failed, some input tensors have not been set.");
         return OH_NN_INVALID_PARAMETER;
@@ -1001,8 +1663,57 @@ OH_NN_ReturnCode NNExecutor::Run()
     return OH_NN_SUCCESS;
 }
 
-NNExecutor::~NNExecutor()
+OH_NN_ReturnCode NNExecutor::SyncOutputShapes(NN_Tensor* outputTensors[], size_t outputSize)
 {
+    if ((outputTensors == nullptr) || (m_outputTensorDescs.size() != outputSize)) {
+        LOGE("NNExecutor::SyncOutputShapes failed, outputSize:%{public}zu is not equal to model output "
+             "size:%{public}zu", outputSize, m_outputTensorDescs.size());
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    std::lock_guard<std::mutex> runLock(m_runMtx);
+    for (size_t i = 0; i < outputSize; ++i) {
+        TensorDesc* tensorDesc = reinterpret_cast<NNTensor2_0*>(outputTensors[i])->GetTensorDesc();
+        int32_t* shape {nullptr};
+        size_t shapeNum {0};
+        if ((tensorDesc == nullptr) || (tensorDesc->GetShape(&shape, &shapeNum) != OH_NN_SUCCESS)) {
+            LOGE("NNExecutor::SyncOutputShapes failed, failed to get shape of output %{public}zu.", i);
+            return OH_NN_NULL_PTR;
+        }
+        OH_NN_ReturnCode ret = m_outputTensorDescs[i].first->SetShape(shape, shapeNum);
+        if (ret != OH_NN_SUCCESS) {
+            LOGE("NNExecutor::SyncOutputShapes failed, failed to set shape of output %{public}zu.", i);
+            return ret;
+        }
+    }
+    return OH_NN_SUCCESS;
+}
+
+void NNExecutor::Reset()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_asyncMtx);
+        m_asyncCond.wait(lock, [this] { return m_pendingAsyncRunNum == 0; });
+        m_onRunDone = nullptr;
+        m_onServiceDied = nullptr;
+    }
+
+    // The prepared model may be shared with other executors, release the bindings of this one.
+    {
+        std::lock_guard<std::mutex> lock(m_bindingMtx);
+        for (auto& binding : m_ioBindings) {
+            if (binding.second.isDeviceBound) {
+                m_preparedModel->UnbindIOTensors(binding.second.deviceBindingId);
+            }
+        }
+        m_ioBindings.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(m_runMtx);
+    m_isOutputAutoGrowth = false;
+    m_outputHighWaterMarks.clear();
+    m_isRun = false;
+
     for (auto& it : m_inputTensors) {
         if ((it.second).isInnerMem) {
             m_device->ReleaseBuffer((it.second).tensor->GetBuffer());
@@ -1033,5 +1744,24 @@ NNExecutor::~NNExecutor()
     }
     m_outputCreatedMem.clear();
 }
+
+NNExecutor::~NNExecutor()
+{
+    Reset();
+
+    for (auto& buffer : m_batchInputBuffers) {
+        if (buffer.data != nullptr) {
+            m_device->ReleaseBuffer(buffer.data);
+        }
+    }
+    m_batchInputBuffers.clear();
+
+    for (auto& buffer : m_batchOutputBuffers) {
+        if (buffer.data != nullptr) {
+            m_device->ReleaseBuffer(buffer.data);
+        }
+    }
+    m_batchOutputBuffers.clear();
+}
 }  // namespace NeuralNetworkRuntime
 }  // namespace OHOS
\ No newline at end of file
@@ -16,8 +16,13 @@
 #ifndef NEURAL_NETWORK_RUNTIME_NNEXECUTOR_H
 #define NEURAL_NETWORK_RUNTIME_NNEXECUTOR_H
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 #include "executor.h"
 #include "device.h"
+#include "async_run_pool.h"
 #include "prepared_model.h"
 #include "nn_tensor.h"
 
@@ -55,7 +60,22 @@ public:
                               size_t outputSize,
                               int32_t timeout,
                               void* userData) override;
+    OH_NN_ReturnCode RunBatch(NN_Tensor* inputTensors[],
+                              size_t inputSize,
+                              NN_Tensor* outputTensors[],
+                              size_t outputSize,
+                              size_t batchSize) override;
+    OH_NN_ReturnCode BindIOTensors(NN_Tensor* inputTensors[],
+                                   size_t inputSize,
+                                   NN_Tensor* outputTensors[],
+                                   size_t outputSize,
+                                   size_t* bindingId) override;
+    OH_NN_ReturnCode RunSyncWithBinding(size_t bindingId) override;
+    OH_NN_ReturnCode UnbindIOTensors(size_t bindingId) override;
+    OH_NN_ReturnCode SetOutputAutoGrowth(bool enable) override;
     size_t GetBackendID() override;
+    OH_NN_ReturnCode SyncOutputShapes(NN_Tensor* outputTensors[], size_t outputSize) override;
+    void Reset() override;
 
     // The following APIs are compatible with older versions
     OH_NN_ReturnCode SetInput(uint32_t index, const OH_NN_Tensor& nnTensor, const void* buffer, size_t length);
@@ -72,6 +92,35 @@ public:
 
 private:
     OH_NN_ReturnCode CheckInputDimRanges(NN_Tensor* inputTensors[], size_t inputSize);
+    OH_NN_ReturnCode RunSyncLocked(NN_Tensor* inputTensors[],
+                                   size_t inputSize,
+                                   NN_Tensor* outputTensors[],
+                                   size_t outputSize);
+    void RunAsyncTask(std::vector<NN_Tensor*>& inputTensors, std::vector<NN_Tensor*>& outputTensors,
+                      std::chrono::steady_clock::time_point deadline, void* userData);
+    bool IsSameShape(const TensorDesc& tensorDesc, const std::vector<int32_t>& dims) const;
+    struct IOBinding;
+    // Runs the tensors of the binding on the device binding if there is one, so that both run paths share the output
+    // auto-growth.
+    OH_NN_ReturnCode RunPreparedModel(const std::vector<NN_Tensor*>& inputTensors,
+                                      const std::vector<NN_Tensor*>& outputTensors,
+                                      const IOBinding* binding = nullptr);
+    OH_NN_ReturnCode RunPreparedModelOnce(const std::vector<NN_Tensor*>& inputTensors,
+                                          const std::vector<NN_Tensor*>& outputTensors,
+                                          const IOBinding* binding);
+    OH_NN_ReturnCode RebindOutputs(const IOBinding* binding);
+    OH_NN_ReturnCode ReserveOutputs(const std::vector<NN_Tensor*>& outputTensors, bool& isReallocated);
+    size_t GetOutputGrowthFactor(const std::vector<NN_Tensor*>& inputTensors) const;
+    OH_NN_ReturnCode GrowOutputs(const std::vector<NN_Tensor*>& inputTensors,
+        const std::vector<NN_Tensor*>& outputTensors);
+    OH_NN_ReturnCode UpdateOutputShapes(const std::vector<NN_Tensor*>& outputTensors,
+                                        const std::vector<std::vector<int32_t>>& outputsDims);
+    bool IsBatchStackable(const std::vector<std::vector<NN_Tensor*>>& inputs) const;
+    void* GetBatchBuffer(std::vector<Buffer>& buffers, size_t index, size_t length);
+    OH_NN_ReturnCode StackBatchInputs(const std::vector<std::vector<NN_Tensor*>>& inputs,
+                                      std::vector<IOTensor>& stackedInputs);
+    OH_NN_ReturnCode RunStackedBatch(const std::vector<std::vector<NN_Tensor*>>& inputs,
+                                     const std::vector<std::vector<NN_Tensor*>>& outputs);
 
     // The following APIs are compatible with older versions
     OH_NN_ReturnCode Run(const std::vector<std::shared_ptr<NNTensor>>& inputTensors,
@@ -95,6 +144,48 @@ private:
     std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> m_inputTensorDescs;
     std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> m_outputTensorDescs;
 
+    // Input dim ranges of the prepared model, queried at construction
+    OH_NN_ReturnCode m_dimRangesRet {OH_NN_OPERATION_FORBIDDEN};
+    std::vector<std::vector<uint32_t>> m_minInputDims;
+    std::vector<std::vector<uint32_t>> m_maxInputDims;
+    std::vector<std::vector<size_t>> m_minInputDimRanges;
+    std::vector<std::vector<size_t>> m_maxInputDimRanges;
+
+    // Scratch storage of RunSync, reused by the following runs
+    std::vector<NN_Tensor*> m_runInputTensors;
+    std::vector<NN_Tensor*> m_runOutputTensors;
+    std::vector<std::vector<int32_t>> m_runOutputsDims;
+    std::vector<bool> m_runIsOutputBufferEnough;
+
+    // Output auto-growth, the largest size each output has been grown to
+    bool m_isOutputAutoGrowth {false};
+    std::vector<size_t> m_outputHighWaterMarks;
+
+    // Asynchronous execution
+    NN_OnRunDone m_onRunDone {nullptr};
+    NN_OnServiceDied m_onServiceDied {nullptr};
+    std::shared_ptr<AsyncRunPool> m_asyncRunPool {nullptr};
+    size_t m_pendingAsyncRunNum {0};
+    std::mutex m_asyncMtx;
+    std::condition_variable m_asyncCond;
+    // Taken by every run path, runs of the executor share the scratch storage above and the output descs.
+    std::mutex m_runMtx;
+
+    // Staging buffers of the requests stacked by RunBatch
+    std::vector<Buffer> m_batchInputBuffers;
+    std::vector<Buffer> m_batchOutputBuffers;
+
+    // Tensors bound by BindIOTensors, bound to the prepared model as well if it supports it
+    struct IOBinding {
+        std::vector<NN_Tensor*> inputs;
+        std::vector<NN_Tensor*> outputs;
+        size_t deviceBindingId {0};
+        bool isDeviceBound {false};
+    };
+    std::unordered_map<size_t, IOBinding> m_ioBindings;
+    size_t m_nextBindingId {0};
+    std::mutex m_bindingMtx;
+
     // The following parameters are provided for compatibility with older versions
     struct ExeTensor {
         std::shared_ptr<NNTensor> tensor {nullptr};
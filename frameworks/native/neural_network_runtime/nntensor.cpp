@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <utility>
 #include <sys/mman.h>
 #include <unistd.h>
 
@@ -159,13 +160,15 @@ OH_NN_ReturnCode NNTensor2_0::CreateData(int fd, size_t size, size_t offset)
         return OH_NN_INVALID_PARAMETER;
     }
 
-    m_data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
-    if (m_data == MAP_FAILED) {
+    // The data uses the segment [offset, size) of the shared memory. The offset of a tensor sub-allocated by the
+    // runtime is not aligned to pages, so the shared memory is mapped from the start.
+    void* buffer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (buffer == MAP_FAILED) {
         LOGE("NNTensor2_0::AllocateMemory failed, Map fd to address failed: %{public}s.", strerror(errno));
-        m_data = nullptr;
         return OH_NN_MEMORY_ERROR;
     }
 
+    m_data = static_cast<char*>(buffer) + offset;
     m_fd = fd;
     m_size = size;
     m_offset = offset;
@@ -173,6 +176,55 @@ OH_NN_ReturnCode NNTensor2_0::CreateData(int fd, size_t size, size_t offset)
     return OH_NN_SUCCESS;
 }
 
+OH_NN_ReturnCode NNTensor2_0::ReallocateData(size_t size)
+{
+    if (m_isUserData) {
+        LOGE("NNTensor2_0::ReallocateData failed, data of user cannot be reallocated.");
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    if (size == 0 || size > ALLOCATE_BUFFER_LIMIT) {
+        LOGE("NNTensor2_0::ReallocateData failed, Invalid buffer size, "
+             "it must greater than 0 and less than 1Gb. length=%{public}zu", size);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    // Allocate the new data before releasing the old one, so that the tensor keeps its data if the allocation fails.
+    void* oldData = m_data;
+    int oldFd = m_fd;
+    size_t oldSize = m_size;
+    size_t oldOffset = m_offset;
+    std::shared_ptr<TensorAllocator> oldAllocator = std::move(m_allocator);
+    TensorAllocator::Block oldBlock = m_block;
+    auto swapData = [&]() {
+        std::swap(m_data, oldData);
+        std::swap(m_fd, oldFd);
+        std::swap(m_size, oldSize);
+        std::swap(m_offset, oldOffset);
+        std::swap(m_allocator, oldAllocator);
+        std::swap(m_block, oldBlock);
+    };
+
+    auto ret = AllocateMemory(size);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("NNTensor2_0::ReallocateData failed, failed to allocate memory.");
+        swapData();
+        return ret;
+    }
+
+    swapData();
+    ret = ReleaseMemory();
+    if (ret != OH_NN_SUCCESS) {
+        LOGW("NNTensor2_0::ReallocateData, failed to release the old memory.");
+    }
+    swapData();
+    return OH_NN_SUCCESS;
+}
+
+bool NNTensor2_0::IsUserData() const
+{
+    return m_isUserData;
+}
+
 TensorDesc* NNTensor2_0::GetTensorDesc() const
 {
     return m_tensorDesc;
@@ -198,6 +250,16 @@ size_t NNTensor2_0::GetOffset() const
     return m_offset;
 }
 
+size_t NNTensor2_0::GetDataSize() const
+{
+    return m_size - m_offset;
+}
+
+size_t NNTensor2_0::GetSlabOffset() const
+{
+    return (m_allocator != nullptr) ? m_block.offset : 0;
+}
+
 OH_NN_ReturnCode NNTensor2_0::AllocateMemory(size_t length)
 {
     BackendManager& backendManager = BackendManager::GetInstance();
@@ -207,7 +269,27 @@ OH_NN_ReturnCode NNTensor2_0::AllocateMemory(size_t length)
         return OH_NN_NULL_PTR;
     }
 
+    // Small tensors are carved out of the shared slabs of the backend, without calling the device. The tensor sees
+    // only its own block, the offset of the block in the slab is applied to the buffers sent to the device.
     auto* nnBackend = reinterpret_cast<NNBackend*>(backend.get());
+    std::shared_ptr<TensorAllocator> allocator = nnBackend->GetTensorAllocator();
+    if (allocator != nullptr) {
+        TensorAllocator::Block block;
+        auto allocatorRet = allocator->Allocate(length, block);
+        if (allocatorRet == OH_NN_SUCCESS) {
+            m_allocator = allocator;
+            m_block = block;
+            m_data = block.data;
+            m_fd = block.fd;
+            m_offset = 0;
+            m_size = length;
+            return OH_NN_SUCCESS;
+        }
+        if (allocatorRet != OH_NN_OPERATION_FORBIDDEN) {
+            LOGW("NNTensor2_0::AllocateMemory failed to allocate from slabs, allocate buffer from device instead.");
+        }
+    }
+
     auto device = nnBackend->GetDevice();
     if (device == nullptr) {
         LOGE("NNTensor2_0::AllocateMemory failed, device of nnbackend is nullptr.");
@@ -239,6 +321,18 @@ OH_NN_ReturnCode NNTensor2_0::AllocateMemory(size_t length)
 
 OH_NN_ReturnCode NNTensor2_0::ReleaseMemory()
 {
+    if (m_allocator != nullptr) {
+        auto allocatorRet = m_allocator->Free(m_block);
+        m_allocator = nullptr;
+        m_data = nullptr;
+        m_fd = 0;
+        m_offset = 0;
+        m_size = 0;
+        if (allocatorRet != OH_NN_SUCCESS) {
+            LOGE("NNTensor2_0::ReleaseMemory failed, failed to free block.");
+        }
+        return allocatorRet;
+    }
     if (m_size == 0 || m_data == nullptr) {
         return OH_NN_SUCCESS;
     }
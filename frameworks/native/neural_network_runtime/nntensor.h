@@ -18,6 +18,7 @@
 
 #include <memory>
 #include "tensor.h"
+#include "tensor_allocator.h"
 
 namespace OHOS {
 namespace NeuralNetworkRuntime {
@@ -37,6 +38,16 @@ public:
     size_t GetSize() const override;
     size_t GetOffset() const override;
     size_t GetBackendID() const override;
+    // Size of the segment [offset, size) of the shared memory which holds the tensor data.
+    size_t GetDataSize() const;
+    // Offset of the block in the slab shared memory of the fd, 0 unless the data is sub-allocated from a slab. It is
+    // added to the size and offset of the buffers sent to the device only.
+    size_t GetSlabOffset() const;
+
+    // Replaces the data allocated by the runtime with a buffer of the new size, the content is not kept. Data of the
+    // user is never reallocated.
+    OH_NN_ReturnCode ReallocateData(size_t size);
+    bool IsUserData() const;
 
     bool CheckTensorData() const;
 
@@ -55,6 +66,9 @@ private:
     size_t m_size {0};
     size_t m_offset {0};
     bool m_isUserData {false};
+    // Set if the data is a block sub-allocated by the allocator, which also keeps the allocator alive.
+    std::shared_ptr<TensorAllocator> m_allocator {nullptr};
+    TensorAllocator::Block m_block;
 };
 }  // namespace NeuralNetworkRuntime
 }  // namespace OHOS
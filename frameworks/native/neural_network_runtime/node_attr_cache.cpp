@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "node_attr_cache.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "common/log.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace {
+constexpr size_t PARALLEL_CONVERT_MIN_NODE_NUM = 1024;
+constexpr size_t MAX_CONVERT_THREAD_NUM = 4;
+}
+
+NodeAttrCache& NodeAttrCache::GetInstance()
+{
+    static NodeAttrCache instance;
+    return instance;
+}
+
+std::shared_ptr<const NodeAttrs> NodeAttrCache::GetNodeAttrs(
+    const std::shared_ptr<const mindspore::lite::LiteGraph>& liteGraph,
+    const std::string& version,
+    const NodeAttrConverter& converter)
+{
+    if (liteGraph == nullptr) {
+        LOGE("[NodeAttrCache] GetNodeAttrs failed, liteGraph is nullptr.");
+        return nullptr;
+    }
+
+    auto key = std::make_pair(liteGraph.get(), version);
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        EvictExpiredEntries();
+        auto iter = m_entries.find(key);
+        if (iter != m_entries.end()) {
+            return iter->second.nodeAttrs;
+        }
+    }
+
+    // Converted without the lock, a graph compiled by several threads at once may be converted more than once.
+    std::shared_ptr<const NodeAttrs> nodeAttrs = ConvertNodeAttrs(liteGraph.get(), converter);
+    if (nodeAttrs == nullptr) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mtx);
+    Entry entry;
+    entry.liteGraph = liteGraph;
+    entry.nodeAttrs = nodeAttrs;
+    m_entries.emplace(key, entry);
+    return nodeAttrs;
+}
+
+void NodeAttrCache::EvictExpiredEntries()
+{
+    // Called with m_mtx locked. The address of a destroyed graph may be reused by a new one, so the entries of the
+    // destroyed graphs are dropped before any lookup.
+    for (auto iter = m_entries.begin(); iter != m_entries.end();) {
+        if (iter->second.liteGraph.expired()) {
+            iter = m_entries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+std::shared_ptr<const NodeAttrs> NodeAttrCache::ConvertNodeAttrs(const mindspore::lite::LiteGraph* liteGraph,
+                                                                 const NodeAttrConverter& converter)
+{
+    if (liteGraph == nullptr) {
+        LOGE("[NodeAttrCache] ConvertNodeAttrs failed, liteGraph is nullptr.");
+        return nullptr;
+    }
+
+    const auto& nodes = liteGraph->all_nodes_;
+    auto isInvalidNode = [](const mindspore::lite::LiteGraph::Node* node) {
+        return (node == nullptr) || (node->primitive_ == nullptr);
+    };
+    if (std::any_of(nodes.begin(), nodes.end(), isInvalidNode)) {
+        LOGE("[NodeAttrCache] ConvertNodeAttrs failed, node or its primitive is nullptr.");
+        return nullptr;
+    }
+
+    auto nodeAttrs = std::make_shared<NodeAttrs>(nodes.size());
+    auto convertRange = [&nodes, &converter, &nodeAttrs](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            (*nodeAttrs)[i] = converter(nodes[i]);
+        }
+    };
+
+    size_t threadNum = 1;
+    if (nodes.size() >= PARALLEL_CONVERT_MIN_NODE_NUM) {
+        threadNum = std::min<size_t>(std::max<unsigned int>(std::thread::hardware_concurrency(), 1),
+                                     MAX_CONVERT_THREAD_NUM);
+    }
+
+    // Every thread marshals a contiguous range of nodes into its own slots, the calling thread takes the first one.
+    size_t rangeSize = (nodes.size() + threadNum - 1) / threadNum;
+    std::vector<std::thread> workers;
+    for (size_t begin = rangeSize; begin < nodes.size(); begin += rangeSize) {
+        workers.emplace_back(convertRange, begin, std::min(begin + rangeSize, nodes.size()));
+    }
+    convertRange(0, std::min(rangeSize, nodes.size()));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return nodeAttrs;
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_RUNTIME_NODE_ATTR_CACHE_H
+#define NEURAL_NETWORK_RUNTIME_NODE_ATTR_CACHE_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mindir.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+using NodeAttrs = std::vector<std::vector<int8_t>>;
+using NodeAttrConverter = std::function<std::vector<int8_t>(const mindspore::lite::LiteGraph::Node* node)>;
+
+// Keeps the serialized attributes (nodeAttr) of the nodes of a LiteGraph, so that querying the supported operations
+// and preparing the same graph marshal the attributes once. Attributes are kept per HDI version, as every version has
+// its own attribute types, and are dropped once the graph is destroyed.
+class NodeAttrCache {
+public:
+    static NodeAttrCache& GetInstance();
+
+    // Returns nullptr if a node of the graph is invalid.
+    std::shared_ptr<const NodeAttrs> GetNodeAttrs(const std::shared_ptr<const mindspore::lite::LiteGraph>& liteGraph,
+                                                  const std::string& version,
+                                                  const NodeAttrConverter& converter);
+
+    // Converts the attributes of all nodes without caching them, by several threads for large graphs.
+    static std::shared_ptr<const NodeAttrs> ConvertNodeAttrs(const mindspore::lite::LiteGraph* liteGraph,
+                                                             const NodeAttrConverter& converter);
+
+private:
+    struct Entry {
+        std::weak_ptr<const mindspore::lite::LiteGraph> liteGraph;
+        std::shared_ptr<const NodeAttrs> nodeAttrs {nullptr};
+    };
+
+    NodeAttrCache() = default;
+    ~NodeAttrCache() = default;
+    NodeAttrCache(const NodeAttrCache&) = delete;
+    NodeAttrCache& operator=(const NodeAttrCache&) = delete;
+
+    void EvictExpiredEntries();
+
+private:
+    std::map<std::pair<const mindspore::lite::LiteGraph*, std::string>, Entry> m_entries;
+    std::mutex m_mtx;
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_RUNTIME_NODE_ATTR_CACHE_H
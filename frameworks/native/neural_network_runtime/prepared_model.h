@@ -16,6 +16,7 @@
 #ifndef NEURAL_NETWORK_RUNTIME_PREPARED_MODEL_H
 #define NEURAL_NETWORK_RUNTIME_PREPARED_MODEL_H
 
+#include <utility>
 #include <vector>
 
 #include "interfaces/kits/c/neural_network_runtime/neural_network_runtime_type.h"
@@ -35,11 +36,61 @@ public:
                                  std::vector<std::vector<int32_t>>& outputsDims,
                                  std::vector<bool>& isOutputBufferEnough) = 0;
 
+    // outputsDims and isOutputBufferEnough may hold the results of the previous run, they are overwritten.
     virtual OH_NN_ReturnCode Run(const std::vector<NN_Tensor*>& inputs,
                                  const std::vector<NN_Tensor*>& outputs,
                                  std::vector<std::vector<int32_t>>& outputsDims,
                                  std::vector<bool>& isOutputBufferEnough) = 0;
 
+    // Runs independent requests, one set of input/output tensors per request. Devices which can execute several
+    // requests in one call override it, the others run the requests one by one.
+    virtual OH_NN_ReturnCode RunBatch(const std::vector<std::vector<NN_Tensor*>>& inputs,
+                                      const std::vector<std::vector<NN_Tensor*>>& outputs,
+                                      std::vector<std::vector<std::vector<int32_t>>>& outputsDims)
+    {
+        if (inputs.size() != outputs.size()) {
+            return OH_NN_INVALID_PARAMETER;
+        }
+
+        outputsDims.clear();
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            std::vector<std::vector<int32_t>> singleOutputsDims;
+            std::vector<bool> isOutputBufferEnough;
+            OH_NN_ReturnCode ret = Run(inputs[i], outputs[i], singleOutputsDims, isOutputBufferEnough);
+            if (ret != OH_NN_SUCCESS) {
+                return ret;
+            }
+            outputsDims.emplace_back(std::move(singleOutputsDims));
+        }
+        return OH_NN_SUCCESS;
+    }
+
+    // Converts a fixed set of input/output tensors once, so that the runs on them only refresh the shapes that changed.
+    // The buffers are converted again by RebindOutputs after the outputs are reallocated. Devices which do not override
+    // them are run through Run with the bound tensors.
+    virtual OH_NN_ReturnCode BindIOTensors(const std::vector<NN_Tensor*>& inputs,
+                                           const std::vector<NN_Tensor*>& outputs,
+                                           size_t& bindingId)
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    virtual OH_NN_ReturnCode RunWithBinding(size_t bindingId, std::vector<std::vector<int32_t>>& outputsDims,
+                                            std::vector<bool>& isOutputBufferEnough)
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    virtual OH_NN_ReturnCode RebindOutputs(size_t bindingId)
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    virtual OH_NN_ReturnCode UnbindIOTensors(size_t bindingId)
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
     virtual OH_NN_ReturnCode GetInputDimRanges(std::vector<std::vector<uint32_t>>& minInputDims,
                                                std::vector<std::vector<uint32_t>>& maxInputDims)
     {
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "prepared_model_cache.h"
+
+#include "common/log.h"
+#include "common/utils.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+bool PreparedModelKey::operator==(const PreparedModelKey& other) const
+{
+    return (modelHash == other.modelHash) && (backendID == other.backendID) && (enableFp16 == other.enableFp16) &&
+        (performance == other.performance) && (priority == other.priority);
+}
+
+size_t PreparedModelKeyHash::operator()(const PreparedModelKey& key) const
+{
+    uint64_t hash = GetXXHash64(&key.modelHash, sizeof(key.modelHash));
+    hash = GetXXHash64(&key.backendID, sizeof(key.backendID), hash);
+    hash = GetXXHash64(&key.enableFp16, sizeof(key.enableFp16), hash);
+    hash = GetXXHash64(&key.performance, sizeof(key.performance), hash);
+    hash = GetXXHash64(&key.priority, sizeof(key.priority), hash);
+    return static_cast<size_t>(hash);
+}
+
+PreparedModelCache& PreparedModelCache::GetInstance()
+{
+    static PreparedModelCache instance;
+    return instance;
+}
+
+bool PreparedModelCache::Find(const PreparedModelKey& key, PreparedModelEntry& entry)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end()) {
+        return false;
+    }
+
+    std::shared_ptr<PreparedModel> preparedModel = iter->second.preparedModel.lock();
+    if (preparedModel == nullptr) {
+        // All the compilations sharing the model have been destroyed.
+        m_memorySize -= iter->second.memorySize;
+        m_entries.erase(iter);
+        return false;
+    }
+
+    entry.preparedModel = preparedModel;
+    entry.inputTensorDescs = iter->second.inputTensorDescs;
+    entry.outputTensorDescs = iter->second.outputTensorDescs;
+    entry.memorySize = iter->second.memorySize;
+    return true;
+}
+
+void PreparedModelCache::Add(const PreparedModelKey& key, const PreparedModelEntry& entry)
+{
+    if (entry.preparedModel == nullptr) {
+        LOGE("[PreparedModelCache] Add failed, preparedModel is nullptr.");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto iter = m_entries.find(key);
+    if ((iter != m_entries.end()) && !iter->second.preparedModel.expired()) {
+        // Another compilation prepared the same model at the same time, keep the one added first.
+        return;
+    }
+    if (iter != m_entries.end()) {
+        m_memorySize -= iter->second.memorySize;
+        m_entries.erase(iter);
+    }
+
+    EraseReleasedEntries();
+    if (m_memorySize + entry.memorySize > m_memoryLimit) {
+        LOGI("[PreparedModelCache] Model of %{public}zu bytes exceeds the memory limit, it is not shared.",
+             entry.memorySize);
+        return;
+    }
+
+    CachedEntry newEntry;
+    newEntry.preparedModel = entry.preparedModel;
+    newEntry.inputTensorDescs = entry.inputTensorDescs;
+    newEntry.outputTensorDescs = entry.outputTensorDescs;
+    newEntry.memorySize = entry.memorySize;
+    m_entries.emplace(key, newEntry);
+    m_memorySize += entry.memorySize;
+}
+
+void PreparedModelCache::SetMemoryLimit(size_t memoryLimit)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_memoryLimit = memoryLimit;
+    if (m_memoryLimit == 0) {
+        // The compilations sharing the models keep them, only the later compilations stop sharing.
+        m_entries.clear();
+        m_memorySize = 0;
+    }
+}
+
+bool PreparedModelCache::IsShareable(size_t memorySize)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    return (m_memoryLimit != 0) && (memorySize <= m_memoryLimit);
+}
+
+void PreparedModelCache::EraseReleasedEntries()
+{
+    // Called with m_mtx locked.
+    for (auto iter = m_entries.begin(); iter != m_entries.end();) {
+        if (iter->second.preparedModel.expired()) {
+            m_memorySize -= iter->second.memorySize;
+            iter = m_entries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_RUNTIME_PREPARED_MODEL_CACHE_H
+#define NEURAL_NETWORK_RUNTIME_PREPARED_MODEL_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "prepared_model.h"
+#include "tensor_desc.h"
+#include "interfaces/kits/c/neural_network_runtime/neural_network_runtime_type.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+constexpr size_t DEFAULT_PREPARED_MODEL_MEMORY_LIMIT = 512 * 1024 * 1024; // 512MB
+
+struct PreparedModelKey {
+    uint64_t modelHash {0};
+    size_t backendID {0};
+    bool enableFp16 {false};
+    OH_NN_PerformanceMode performance {OH_NN_PERFORMANCE_NONE};
+    OH_NN_Priority priority {OH_NN_PRIORITY_NONE};
+
+    bool operator==(const PreparedModelKey& other) const;
+};
+
+struct PreparedModelKeyHash {
+    size_t operator()(const PreparedModelKey& key) const;
+};
+
+struct PreparedModelEntry {
+    std::shared_ptr<PreparedModel> preparedModel {nullptr};
+    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> inputTensorDescs;
+    std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> outputTensorDescs;
+    size_t memorySize {0};
+};
+
+// Prepared models shared by all compilations of the process. A compilation building the same model with the same
+// configs on the same backend reuses the prepared model instead of preparing it again. The cache only references the
+// prepared models weakly, a prepared model is released together with the last compiler or executor using it. Models
+// are not shared once the prepared models in use exceed the memory limit, and sharing is disabled by a limit of 0.
+class PreparedModelCache {
+public:
+    static PreparedModelCache& GetInstance();
+
+    bool Find(const PreparedModelKey& key, PreparedModelEntry& entry);
+    void Add(const PreparedModelKey& key, const PreparedModelEntry& entry);
+    void SetMemoryLimit(size_t memoryLimit);
+    // Whether a model of the size can be shared, checked before hashing the model for the key.
+    bool IsShareable(size_t memorySize);
+
+private:
+    PreparedModelCache() = default;
+    ~PreparedModelCache() = default;
+    PreparedModelCache(const PreparedModelCache&) = delete;
+    PreparedModelCache& operator=(const PreparedModelCache&) = delete;
+
+    void EraseReleasedEntries();
+
+private:
+    struct CachedEntry {
+        std::weak_ptr<PreparedModel> preparedModel;
+        std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> inputTensorDescs;
+        std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> outputTensorDescs;
+        size_t memorySize {0};
+    };
+    std::unordered_map<PreparedModelKey, CachedEntry, PreparedModelKeyHash> m_entries;
+    size_t m_memoryLimit {DEFAULT_PREPARED_MODEL_MEMORY_LIMIT};
+    size_t m_memorySize {0};
+    std::mutex m_mtx;
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_RUNTIME_PREPARED_MODEL_CACHE_H
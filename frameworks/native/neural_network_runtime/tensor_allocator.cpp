@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tensor_allocator.h"
+
+#include <algorithm>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "common/log.h"
+#include "common/utils.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace {
+// Blocks are multiples of the minimum size, so every block is aligned to it.
+constexpr size_t MIN_BLOCK_SIZE = 256;
+constexpr size_t MAX_BLOCK_SIZE = 1024 * 1024; // 1MB
+constexpr size_t SLAB_SIZE = 4 * 1024 * 1024; // 4MB
+constexpr size_t MAX_IDLE_SLAB_NUM = 1;
+}
+
+TensorAllocator::TensorAllocator(std::shared_ptr<Device> device) : m_device(device) {}
+
+TensorAllocator::~TensorAllocator()
+{
+    // Every tensor holds the allocator of its block, so all slabs are idle here.
+    for (auto& slab : m_slabs) {
+        ReleaseSlab(slab.first, slab.second);
+    }
+    m_slabs.clear();
+}
+
+OH_NN_ReturnCode TensorAllocator::Allocate(size_t length, Block& block)
+{
+    if (length > MAX_BLOCK_SIZE) {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    size_t blockSize = MIN_BLOCK_SIZE;
+    while (blockSize < length) {
+        blockSize <<= 1;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto& freeBlocks = m_freeBlocks[blockSize];
+    if (!freeBlocks.empty()) {
+        block = freeBlocks.back();
+        freeBlocks.pop_back();
+        ++m_slabs[block.fd].blockNum;
+        return OH_NN_SUCCESS;
+    }
+    return AllocateFromSlabs(blockSize, block);
+}
+
+OH_NN_ReturnCode TensorAllocator::AllocateFromSlabs(size_t blockSize, Block& block)
+{
+    // Called with m_mtx locked. Slabs in use are filled before the idle one, so that it can still be returned.
+    auto slabIter = m_slabs.end();
+    for (auto iter = m_slabs.begin(); iter != m_slabs.end(); ++iter) {
+        if ((iter->second.usedSize + blockSize <= SLAB_SIZE) &&
+            ((slabIter == m_slabs.end()) || (slabIter->second.blockNum == 0))) {
+            slabIter = iter;
+        }
+    }
+
+    if (slabIter == m_slabs.end()) {
+        int fd = -1;
+        OH_NN_ReturnCode ret = AllocateSlab(fd);
+        if (ret != OH_NN_SUCCESS) {
+            return ret;
+        }
+        slabIter = m_slabs.find(fd);
+    }
+
+    Slab& slab = slabIter->second;
+    if (slab.blockNum == 0) {
+        --m_idleSlabNum;
+    }
+    block.fd = slabIter->first;
+    block.offset = slab.usedSize;
+    block.data = static_cast<char*>(slab.data) + slab.usedSize;
+    block.size = blockSize;
+    slab.usedSize += blockSize;
+    ++slab.blockNum;
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode TensorAllocator::AllocateSlab(int& fd)
+{
+    if (m_device == nullptr) {
+        LOGE("[TensorAllocator] AllocateSlab failed, device is nullptr.");
+        return OH_NN_NULL_PTR;
+    }
+
+    OH_NN_ReturnCode ret = m_device->AllocateBuffer(SLAB_SIZE, fd);
+    if (ret != OH_NN_SUCCESS) {
+        LOGE("[TensorAllocator] AllocateSlab failed, failed to allocate buffer.");
+        return OH_NN_MEMORY_ERROR;
+    }
+    if (fd < 0) {
+        LOGE("[TensorAllocator] AllocateSlab failed, fd must greater than 0.");
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    void* data = mmap(nullptr, SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        LOGE("[TensorAllocator] AllocateSlab failed, Map fd to address failed: %{public}s.", strerror(errno));
+        m_device->ReleaseBuffer(fd, SLAB_SIZE);
+        close(fd);
+        return OH_NN_MEMORY_ERROR;
+    }
+
+    Slab slab;
+    slab.data = data;
+    m_slabs.emplace(fd, slab);
+    ++m_idleSlabNum;
+    return OH_NN_SUCCESS;
+}
+
+OH_NN_ReturnCode TensorAllocator::Free(const Block& block)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto iter = m_slabs.find(block.fd);
+    if ((iter == m_slabs.end()) || (iter->second.blockNum == 0)) {
+        LOGE("[TensorAllocator] Free failed, block of fd %{public}d is not allocated by the allocator.", block.fd);
+        return OH_NN_INVALID_PARAMETER;
+    }
+
+    m_freeBlocks[block.size].emplace_back(block);
+    if (--iter->second.blockNum == 0) {
+        RecycleSlab(block.fd);
+    }
+    return OH_NN_SUCCESS;
+}
+
+void TensorAllocator::RecycleSlab(int fd)
+{
+    // Called with m_mtx locked. The free blocks of an empty slab are dropped, so that the slab is carved again from
+    // the start by whatever sizes come next.
+    for (auto& freeBlocks : m_freeBlocks) {
+        auto& blocks = freeBlocks.second;
+        blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+            [fd](const Block& block) { return block.fd == fd; }), blocks.end());
+    }
+
+    auto iter = m_slabs.find(fd);
+    iter->second.usedSize = 0;
+    ++m_idleSlabNum;
+    if (m_idleSlabNum > MAX_IDLE_SLAB_NUM) {
+        ReleaseSlab(iter->first, iter->second);
+        m_slabs.erase(iter);
+        --m_idleSlabNum;
+    }
+}
+
+void TensorAllocator::ReleaseSlab(int fd, Slab& slab)
+{
+    if ((m_device != nullptr) && (m_device->ReleaseBuffer(fd, SLAB_SIZE) != OH_NN_SUCCESS)) {
+        LOGW("[TensorAllocator] ReleaseSlab failed to release buffer of fd %{public}d.", fd);
+    }
+    if (munmap(slab.data, SLAB_SIZE) != 0) {
+        LOGW("[TensorAllocator] ReleaseSlab failed to unmap buffer of fd %{public}d.", fd);
+    }
+    slab.data = nullptr;
+    close(fd);
+}
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NEURAL_NETWORK_RUNTIME_TENSOR_ALLOCATOR_H
+#define NEURAL_NETWORK_RUNTIME_TENSOR_ALLOCATOR_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "device.h"
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+// Sub-allocates the data of the small tensors created on one backend from large shared buffers of the device (slabs),
+// so that creating and destroying such tensors neither calls the device nor maps memory. Blocks are rounded up to
+// power-of-two size classes and recycled through one free list per class. A slab whose blocks are all freed is kept
+// for the next allocations, further empty slabs are returned to the device.
+class TensorAllocator {
+public:
+    struct Block {
+        int fd {-1};
+        void* data {nullptr};
+        size_t offset {0};
+        size_t size {0};
+    };
+
+    explicit TensorAllocator(std::shared_ptr<Device> device);
+    ~TensorAllocator();
+
+    // Returns OH_NN_OPERATION_FORBIDDEN if length is too large for the slabs, the tensor allocates it by itself then.
+    OH_NN_ReturnCode Allocate(size_t length, Block& block);
+    OH_NN_ReturnCode Free(const Block& block);
+
+private:
+    struct Slab {
+        void* data {nullptr};
+        size_t usedSize {0};
+        size_t blockNum {0};
+    };
+
+    TensorAllocator(const TensorAllocator&) = delete;
+    TensorAllocator& operator=(const TensorAllocator&) = delete;
+
+    OH_NN_ReturnCode AllocateFromSlabs(size_t blockSize, Block& block);
+    OH_NN_ReturnCode AllocateSlab(int& fd);
+    void RecycleSlab(int fd);
+    void ReleaseSlab(int fd, Slab& slab);
+
+private:
+    std::shared_ptr<Device> m_device {nullptr};
+    // key: fd of the slab
+    std::map<int, Slab> m_slabs;
+    // key: block size, value: free blocks of the size class
+    std::unordered_map<size_t, std::vector<Block>> m_freeBlocks;
+    size_t m_idleSlabNum {0};
+    std::mutex m_mtx;
+};
+}  // namespace NeuralNetworkRuntime
+}  // namespace OHOS
+#endif  // NEURAL_NETWORK_RUNTIME_TENSOR_ALLOCATOR_H
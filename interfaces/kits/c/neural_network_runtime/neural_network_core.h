@@ -134,6 +134,9 @@ OH_NNCompilation *OH_NNCompilation_ConstructForCache();
  * Note that the cache is the result of compilation building {@link OH_NNCompilation_Build},
  * so that this method must be called after {@link OH_NNCompilation_Build}.\n
  *
+ * If <b>length</b> is less than the cache size, {@link OH_NN_INVALID_PARAMETER} is returned and the required size is
+ * written to <b>modelSize</b>, so that you can call this method again with a large enough buffer.\n
+ *
  * @param compilation Pointer to the {@link OH_NNCompilation} instance.
  * @param buffer Pointer to the given buffer.
  * @param length Buffer length.
@@ -160,6 +163,11 @@ OH_NN_ReturnCode OH_NNCompilation_ExportCacheToBuffer(OH_NNCompilation *compilat
  * Note that <b>compilation</b> only saves the <b>buffer</b> pointer inside, instead of copying its data. You should not
  * release <b>buffer</b> before <b>compilation</b> is destroied.\n
  *
+ * Only a <b>buffer</b> in the shared memory allocated by NNRt for the device, such as the data buffer of an
+ * {@link NN_Tensor} created by {@link OH_NNTensor_Create}, is passed to the device without copying. Any other buffer,
+ * such as the memory allocated or mapped by the caller, is copied in full into a device shared memory during
+ * {@link OH_NNCompilation_Build}, which costs a copy of the model cache and the memory of it until the build ends.\n
+ *
  * @param compilation Pointer to the {@link OH_NNCompilation} instance.
  * @param buffer Pointer to the given buffer.
  * @param modelSize Byte size of the model cache.
@@ -182,6 +190,21 @@ OH_NN_ReturnCode OH_NNCompilation_ImportCacheFromBuffer(OH_NNCompilation *compil
  * and add them into compilation instance one by one. These attributes will be passed directly to device driver,
  * and this method will return error code if the driver cannot parse them. \n
  *
+ * The following configs are handled by NNRt itself, their values are decimal strings, e.g. "8":
+ * - <b>DynamicBatchMaxSize</b>: if greater than 1, {@link OH_NNExecutor_RunSync} calls issued concurrently on the
+ *   executors of the compilation are merged into batches of at most this number of requests.
+ * - <b>DynamicBatchTimeout</b>: time (microsecond) a request waits for other requests to join its batch,
+ *   1000 by default.
+ * - <b>ConstTensorAlignment</b>: alignment (byte) of the constant tensors of the model sent to the device, a power of
+ *   two not larger than 4096, 64 by default.
+ * - <b>PreparedModelMemoryLimit</b>: total size (byte) of the prepared models shared between the compilations of the
+ *   process building the same model with the same configs, 536870912 by default. A prepared model is released with the
+ *   last compilation or executor using it. It applies to the whole process, and "0" disables the sharing.
+ * - <b>HeterogeneousPartition</b>: "true" or "false", "false" by default. If "true", a model with operations not
+ *   supported by the device is split into partitions built on the devices supporting them, and the partitions run
+ *   one after another. The tensors passed between partitions must have static shapes. Asynchronous runs and the
+ *   executor APIs deprecated since API 11 return {@link OH_NN_OPERATION_FORBIDDEN} on them. \n
+ *
  * After {@link OH_NNCompilation_Build} is called, the <b>configName</b> and <b>configValue</b> can be released. \n
  *
  * @param compilation Pointer to the {@link OH_NNCompilation} instance.
@@ -342,6 +365,34 @@ OH_NN_ReturnCode OH_NNCompilation_EnableFloat16(OH_NNCompilation *compilation, b
  */
 OH_NN_ReturnCode OH_NNCompilation_Build(OH_NNCompilation *compilation);
 
+/**
+ * @brief Compiles a model asynchronously.
+ *
+ * It works the same as {@link OH_NNCompilation_Build}, except that the model is compiled by a background thread and
+ * this method returns immediately. {@link NN_OnBuildDone} is called with <b>userData</b> when the compilation is
+ * done. Compilations of several models run concurrently, the number of them running at the same time is limited by
+ * the number of CPU cores. \n
+ *
+ * If a cache directory is set by {@link OH_NNCompilation_SetCache}, the cache is saved in the background after
+ * {@link NN_OnBuildDone} is called, so the compilation can be used as soon as the model is compiled. \n
+ *
+ * No other method can be called on the compilation before {@link NN_OnBuildDone} is called, except
+ * {@link OH_NNCompilation_Destroy}, which waits for the compilation to finish. \n
+ *
+ * @param compilation Pointer to the {@link OH_NNCompilation} instance.
+ * @param onBuildDone Callback function handle {@link NN_OnBuildDone} called when the compilation is done.
+ * @param userData Asynchronous build identifier passed to <b>onBuildDone</b>.
+ * @return Execution result of the function. If the build is submitted, <b>OH_NN_SUCCESS</b> is returned and the
+ *         result of the build is passed to <b>onBuildDone</b>. If the operation fails, an error code is returned and
+ *         <b>onBuildDone</b> is not called.
+ *         For details about the error codes, see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNCompilation_BuildAsync(OH_NNCompilation *compilation,
+                                             NN_OnBuildDone onBuildDone,
+                                             void *userData);
+
 /**
  * @brief Releases the <b>Compilation</b> object.
  *
@@ -352,6 +403,10 @@ OH_NN_ReturnCode OH_NNCompilation_Build(OH_NNCompilation *compilation);
  * If <b>compilation</b> or <b>*compilation</b> is a null pointer,
  * this method only prints warning logs and does not execute the release. \n
  *
+ * If executors acquired by {@link OH_NNCompilation_AcquireExecutor} have not been returned, the compilation is released
+ * when the last of them is returned by {@link OH_NNCompilation_ReleaseExecutor}, and no more executors can be acquired
+ * from it. \n
+ *
  * @param compilation Double pointer to the {@link OH_NNCompilation} instance.
  *                    After a compilation instance is destroyed,
  *                    this method sets <b>*compilation</b> to a null pointer.
@@ -861,6 +916,58 @@ OH_NN_ReturnCode OH_NNExecutor_GetOutputShape(OH_NNExecutor *executor,
  */
 void OH_NNExecutor_Destroy(OH_NNExecutor **executor);
 
+/**
+ * @brief Acquires an executor from the executor pool owned by the compilation.
+ *
+ * Constructing an executor and its tensors on every inference is expensive. This method hands out an executor which
+ * is created on the first acquisition and reused after it is released by {@link OH_NNCompilation_ReleaseExecutor}.
+ * The compilation must be built by {@link OH_NNCompilation_Build} first.\n
+ *
+ * If the model has no dynamic inputs or outputs, the input and output tensors are created together with the executor
+ * and bound to it. They are returned by <b>inputTensor</b> and <b>outputTensor</b> and can be passed directly to
+ * {@link OH_NNExecutor_RunSync} or {@link OH_NNExecutor_RunAsync}. Otherwise <b>*inputCount</b> and
+ * <b>*outputCount</b> are set to 0 and you should create the tensors by yourself.\n
+ *
+ * The bound tensors are owned by the compilation, do not destroy them. The executor must be returned by
+ * {@link OH_NNCompilation_ReleaseExecutor} instead of {@link OH_NNExecutor_Destroy}, and it is destroyed together with
+ * the compilation by {@link OH_NNCompilation_Destroy}.\n
+ *
+ * A compilation holds up to 16 executors. If all of them are acquired, this method fails until one of them is
+ * returned.\n
+ *
+ * @param compilation Pointer to the {@link OH_NNCompilation} instance.
+ * @param inputTensor The returned array of input tensors bound to the executor.
+ * @param inputCount The returned number of input tensors.
+ * @param outputTensor The returned array of output tensors bound to the executor.
+ * @param outputCount The returned number of output tensors.
+ * @return Pointer to a {@link OH_NNExecutor} instance, or NULL if it fails to acquire.
+ * @since 11
+ * @version 1.0
+ */
+OH_NNExecutor *OH_NNCompilation_AcquireExecutor(OH_NNCompilation *compilation,
+                                                NN_Tensor ***inputTensor,
+                                                size_t *inputCount,
+                                                NN_Tensor ***outputTensor,
+                                                size_t *outputCount);
+
+/**
+ * @brief Returns an executor acquired by {@link OH_NNCompilation_AcquireExecutor} to the executor pool.
+ *
+ * The executor and its bound tensors are kept by the compilation for the next acquisition. The asynchronous runs in
+ * flight are waited for, and the state set on the executor is cleared, such as the callbacks, the IO tensor bindings
+ * and the buffers set by the APIs of older versions. After the executor is released, <b>*executor</b> is set to a null
+ * pointer.\n
+ *
+ * @param compilation Pointer to the {@link OH_NNCompilation} instance which the executor is acquired from.
+ * @param executor Double pointer to the {@link OH_NNExecutor} instance.
+ * @return Execution result of the function. If the operation is successful, <b>OH_NN_SUCCESS</b> is returned.
+ *         If the operation fails, an error code is returned.
+ *         For details about the error codes, see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNCompilation_ReleaseExecutor(OH_NNCompilation *compilation, OH_NNExecutor **executor);
+
 /**
  * @brief Gets the input tensor count.
  *
@@ -1038,9 +1145,11 @@ OH_NN_ReturnCode OH_NNExecutor_RunSync(OH_NNExecutor *executor,
  * {@link NN_OnRunDone}. And you can deal with the abnormal termination of device driver service during
  * asynchronous execution by {@link NN_OnServiceDied}.\n
  *
- * If the execution time reaches the <b>timeout</b>, the execution will be terminated
- * with no outputs, and the <b>errCode<b> returned in callback function {@link NN_OnRunDone} will be
- * {@link OH_NN_TIMEOUT}.\n
+ * If the execution time reaches the <b>timeout</b>, the <b>errCode<b> returned in callback function
+ * {@link NN_OnRunDone} will be {@link OH_NN_TIMEOUT} and no outputs are passed to it. An execution which has not
+ * started before the <b>timeout</b> is not run at all. An execution running on the device is not interrupted, so if
+ * it finishes after the <b>timeout</b> the output tensors may already hold its results although
+ * {@link OH_NN_TIMEOUT} is reported.\n
  *
  * The <b>userData</b> is asynchronous execution identifier and will be returned as the first parameter of the callback
  * function. You can input any value you want as long as it can identify different asynchronous executions.\n
@@ -1066,6 +1175,120 @@ OH_NN_ReturnCode OH_NNExecutor_RunAsync(OH_NNExecutor *executor,
                                         int32_t timeout,
                                         void *userData);
 
+/**
+ * @brief Synchronous execution of a batch of independent inference requests.
+ *
+ * Each request is a set of input and output tensors like the arguments of {@link OH_NNExecutor_RunSync}. The tensors
+ * of all requests are passed request by request in <b>inputTensor</b> and <b>outputTensor</b>, so the input tensors
+ * of the <b>i</b>th request start at <b>inputTensor[i * inputCount]</b> and its output tensors start at
+ * <b>outputTensor[i * outputCount]</b>.\n
+ *
+ * The requests are submitted to the device together. If the first dimension of every model input and output is
+ * dynamic and all requests have the same input shapes, the requests are stacked along the first dimension and executed
+ * by the device in one pass. Otherwise the device executes them one after another.\n
+ *
+ * @param executor Pointer to the {@link OH_NNExecutor} instance.
+ * @param inputTensor An array of input tensors {@link NN_Tensor} of all requests.
+ * @param inputCount Number of input tensors of one request.
+ * @param outputTensor An array of output tensors {@link NN_Tensor} of all requests.
+ * @param outputCount Number of output tensors of one request.
+ * @param batchCount Number of requests.
+ * @return Execution result of the function. If the operation is successful, <b>OH_NN_SUCCESS</b> is returned.
+ *         If the operation fails, an error code is returned.
+ *         For details about the error codes, see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNExecutor_RunBatch(OH_NNExecutor *executor,
+                                        NN_Tensor *inputTensor[],
+                                        size_t inputCount,
+                                        NN_Tensor *outputTensor[],
+                                        size_t outputCount,
+                                        size_t batchCount);
+
+/**
+ * @brief Binds a fixed set of input and output tensors to the executor.
+ *
+ * Applications running the same tensors repeatedly can bind them once and run them through
+ * {@link OH_NNExecutor_RunSyncWithBinding}, which saves converting the tensors for the device on every run.
+ * The shapes of the bound tensors can still be changed between runs by {@link OH_NNTensorDesc_SetShape}
+ * on the tensor descs obtained by {@link OH_NNTensor_GetTensorDesc}.\n
+ *
+ * The tensors must not be destroyed before the binding is released by {@link OH_NNExecutor_UnbindIOTensors}
+ * or the executor is destroyed.\n
+ *
+ * @param executor Pointer to the {@link OH_NNExecutor} instance.
+ * @param inputTensor An array of input tensors {@link NN_Tensor}.
+ * @param inputCount Number of input tensors.
+ * @param outputTensor An array of output tensors {@link NN_Tensor}.
+ * @param outputCount Number of output tensors.
+ * @param bindingId Pointer to the ID of the binding returned.
+ * @return Execution result of the function. If the operation is successful, <b>OH_NN_SUCCESS</b> is returned.
+ *         If the operation fails, an error code is returned.
+ *         For details about the error codes, see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNExecutor_BindIOTensors(OH_NNExecutor *executor,
+                                             NN_Tensor *inputTensor[],
+                                             size_t inputCount,
+                                             NN_Tensor *outputTensor[],
+                                             size_t outputCount,
+                                             size_t *bindingId);
+
+/**
+ * @brief Synchronous execution of the tensors bound by {@link OH_NNExecutor_BindIOTensors}.
+ *
+ * It works the same as {@link OH_NNExecutor_RunSync} with the bound tensors, including the output auto-growth enabled
+ * by {@link OH_NNExecutor_SetOutputAutoGrowth}.\n
+ *
+ * @param executor Pointer to the {@link OH_NNExecutor} instance.
+ * @param bindingId ID of the binding returned by {@link OH_NNExecutor_BindIOTensors}.
+ * @return Execution result of the function. If the operation is successful, <b>OH_NN_SUCCESS</b> is returned.
+ *         If the operation fails, an error code is returned.
+ *         For details about the error codes, see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNExecutor_RunSyncWithBinding(OH_NNExecutor *executor, size_t bindingId);
+
+/**
+ * @brief Releases a binding created by {@link OH_NNExecutor_BindIOTensors}.
+ *
+ * @param executor Pointer to the {@link OH_NNExecutor} instance.
+ * @param bindingId ID of the binding returned by {@link OH_NNExecutor_BindIOTensors}.
+ * @return Execution result of the function. If the operation is successful, <b>OH_NN_SUCCESS</b> is returned.
+ *         If the operation fails, an error code is returned.
+ *         For details about the error codes, see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNExecutor_UnbindIOTensors(OH_NNExecutor *executor, size_t bindingId);
+
+/**
+ * @brief Sets whether the executor grows the output tensors that are too small for the results of a run.
+ *
+ * Dynamic-shape models may produce outputs larger than the output tensors passed to {@link OH_NNExecutor_RunSync}.
+ * By default the run fails in that case. With auto-growth enabled, the executor reallocates the data of the output
+ * tensors created by {@link OH_NNTensor_Create} or {@link OH_NNTensor_CreateWithSize} and runs the model once more
+ * within the same call. The outputs are grown to the sizes reported by the device, or to the upper bound derived from
+ * the input dim ranges if the device does not report them. The executor remembers the largest size of each output so
+ * that the output tensors of later runs are allocated large enough in advance. The data addresses and file descriptors
+ * of the grown tensors change, they have to be obtained again by {@link OH_NNTensor_GetDataBuffer} and
+ * {@link OH_NNTensor_GetFd} after the run.\n
+ *
+ * Output tensors created by {@link OH_NNTensor_CreateWithFd} are never reallocated.\n
+ *
+ * @param executor Pointer to the {@link OH_NNExecutor} instance.
+ * @param enable Whether to enable output auto-growth.
+ * @return Execution result of the function. If the operation is successful, <b>OH_NN_SUCCESS</b> is returned.
+ *         If the operation fails, an error code is returned.
+ *         For details about the error codes, see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNExecutor_SetOutputAutoGrowth(OH_NNExecutor *executor, bool enable);
+
 /**
  * @brief Obtains the IDs of all devices connected.
  *
@@ -200,6 +200,52 @@ OH_NN_ReturnCode OH_NNModel_AddTensorToModel(OH_NNModel *model, const NN_TensorD
  */
 OH_NN_ReturnCode OH_NNModel_SetTensorData(OH_NNModel *model, uint32_t index, const void *dataBuffer, size_t length);
 
+/**
+ * @brief Sets the tensor value without copying it.
+ *
+ * Unlike {@link OH_NNModel_SetTensorData}, the model references <b>dataBuffer</b> instead of copying it,
+ * which avoids one copy of large constant tensors such as model weights.
+ * <b>dataBuffer</b> must stay valid and unchanged until the model is destroyed by {@link OH_NNModel_Destroy}. \n
+ *
+ * @param model Pointer to the {@link OH_NNModel} instance.
+ * @param index Index of a tensor.
+ * @param dataBuffer Pointer to real data.
+ * @param length Length of the data buffer.
+ * @return Execution result of the function. If the operation is successful, <b>OH_NN_SUCCESS</b> is returned.
+ *         If the operation fails, an error code is returned. For details about the error codes,
+ *         see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNModel_SetTensorDataByReference(OH_NNModel *model,
+                                                     uint32_t index,
+                                                     const void *dataBuffer,
+                                                     size_t length);
+
+/**
+ * @brief Sets the tensor value from a file descriptor.
+ *
+ * The data of <b>length</b> bytes at <b>offset</b> of <b>fd</b>, for example a weight file, is mapped read-only
+ * instead of being copied into the memory of the process. The mapping is released when the model is destroyed,
+ * <b>fd</b> can be closed after this method returns. \n
+ *
+ * @param model Pointer to the {@link OH_NNModel} instance.
+ * @param index Index of a tensor.
+ * @param fd File descriptor of the data.
+ * @param offset Offset of the data in the file.
+ * @param length Length of the data.
+ * @return Execution result of the function. If the operation is successful, <b>OH_NN_SUCCESS</b> is returned.
+ *         If the operation fails, an error code is returned. For details about the error codes,
+ *         see {@link OH_NN_ReturnCode}.
+ * @since 11
+ * @version 1.0
+ */
+OH_NN_ReturnCode OH_NNModel_SetTensorDataFromFd(OH_NNModel *model,
+                                                uint32_t index,
+                                                int fd,
+                                                size_t offset,
+                                                size_t length);
+
 /**
  * @brief Sets the quantization parameter of a tensor.
  *
@@ -225,6 +225,20 @@ typedef void (*NN_OnRunDone)(void *userData, OH_NN_ReturnCode errCode, void *out
  */
 typedef void (*NN_OnServiceDied)(void *userData);
 
+/**
+ * @brief Defines the callback function handle for the post-process when the asynchronous build has been done.
+ *
+ * Use <b>userData</b> to identify the asynchronous build you want to get.
+ * It is the argument <b>userData</b> passed to {@link OH_NNCompilation_BuildAsync}.\n
+ *
+ * @param userData Asynchronous build identifier, which is the argument <b>userData</b> passed to
+ *                 {@link OH_NNCompilation_BuildAsync}.
+ * @param errCode Error code {@link OH_NN_ReturnCode} returned by the asynchronous build.
+ * @since 11
+ * @version 1.0
+ */
+typedef void (*NN_OnBuildDone)(void *userData, OH_NN_ReturnCode errCode);
+
 /**
  * @brief Defines activation function types in the fusion operator.
  *
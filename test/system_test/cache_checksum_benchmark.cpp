@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "backend_manager.h"
+#include "nncompiled_cache.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace SystemTest {
+namespace {
+constexpr size_t MODEL_CACHE_SIZE = 500 * 1024 * 1024; // 500MB
+constexpr size_t TENSOR_DESC_CACHE_SIZE = 1024;
+constexpr uint32_t CACHE_VERSION = 1;
+}
+
+class CacheCheckSumBenchmark : public testing::Test {
+public:
+    void SetUp()
+    {
+        // Synthetic caches in the shape of a compiled model: one large model cache and the input/output tensor descs.
+        m_modelCache.resize(MODEL_CACHE_SIZE);
+        for (size_t i = 0; i < m_modelCache.size(); ++i) {
+            m_modelCache[i] = static_cast<char>(i * 31 + (i >> 12));
+        }
+        m_inputCache.assign(TENSOR_DESC_CACHE_SIZE, 'i');
+        m_outputCache.assign(TENSOR_DESC_CACHE_SIZE, 'o');
+    }
+
+    void TearDown()
+    {
+        m_modelCache.clear();
+        m_inputCache.clear();
+        m_outputCache.clear();
+    }
+
+    void RestoreWithCheckSum(CacheCheckSumType checkSumType, const std::string& name);
+
+public:
+    std::vector<char> m_modelCache;
+    std::vector<char> m_inputCache;
+    std::vector<char> m_outputCache;
+};
+
+void CacheCheckSumBenchmark::RestoreWithCheckSum(CacheCheckSumType checkSumType, const std::string& name)
+{
+    const std::vector<size_t>& backendIDs = BackendManager::GetInstance().GetAllBackendsID();
+    ASSERT_FALSE(backendIDs.empty());
+
+    NNCompiledCache compiledCache;
+    ASSERT_EQ(OH_NN_SUCCESS, compiledCache.SetBackend(backendIDs[0]));
+    compiledCache.SetCheckSumType(checkSumType);
+
+    std::vector<Buffer> caches {
+        {m_modelCache.data(), m_modelCache.size()},
+        {m_inputCache.data(), m_inputCache.size()},
+        {m_outputCache.data(), m_outputCache.size()},
+    };
+
+    size_t cacheSize {0};
+    std::vector<char> cacheBuffer(MODEL_CACHE_SIZE + TENSOR_DESC_CACHE_SIZE * 4);
+    auto saveStart = std::chrono::steady_clock::now();
+    ASSERT_EQ(OH_NN_SUCCESS,
+        compiledCache.SaveToBuffer(caches, CACHE_VERSION, cacheBuffer.data(), cacheBuffer.size(), &cacheSize));
+    auto saveEnd = std::chrono::steady_clock::now();
+
+    std::vector<Buffer> restoredCaches;
+    auto restoreStart = std::chrono::steady_clock::now();
+    ASSERT_EQ(OH_NN_SUCCESS,
+        compiledCache.RestoreFromBuffer(cacheBuffer.data(), cacheSize, CACHE_VERSION, restoredCaches));
+    auto restoreEnd = std::chrono::steady_clock::now();
+    EXPECT_EQ(caches.size(), restoredCaches.size());
+
+    std::cout << "[CacheCheckSumBenchmark] " << name << ": save "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(saveEnd - saveStart).count() << " ms, restore "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(restoreEnd - restoreStart).count() << " ms."
+              << std::endl;
+}
+
+/*
+ * @tc.name: cache_checksum_benchmark_001
+ * @tc.desc: Restore a 500MB cache validated by CRC16.
+ * @tc.type: PERF
+ */
+HWTEST_F(CacheCheckSumBenchmark, cache_checksum_benchmark_001, testing::ext::TestSize.Level3)
+{
+    RestoreWithCheckSum(CacheCheckSumType::CRC16, "CRC16");
+}
+
+/*
+ * @tc.name: cache_checksum_benchmark_002
+ * @tc.desc: Restore a 500MB cache validated by XXHASH64.
+ * @tc.type: PERF
+ */
+HWTEST_F(CacheCheckSumBenchmark, cache_checksum_benchmark_002, testing::ext::TestSize.Level3)
+{
+    RestoreWithCheckSum(CacheCheckSumType::XXHASH64, "XXHASH64");
+}
+} // namespace SystemTest
+} // namespace NeuralNetworkRuntime
+} // namespace OHOS
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "device.h"
+#include "nnexecutor.h"
+#include "nntensor.h"
+#include "prepared_model.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace SystemTest {
+namespace {
+constexpr size_t RUN_TIMES = 100000;
+constexpr size_t IO_NUM = 4;
+const std::vector<int32_t> TENSOR_SHAPE {1, 3, 224, 224};
+}
+
+// Returns immediately, so the benchmark measures the executor overhead only.
+class NoOpPreparedModel : public PreparedModel {
+public:
+    OH_NN_ReturnCode ExportModelCache(std::vector<Buffer>& modelCache) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    OH_NN_ReturnCode Run(const std::vector<IOTensor>& inputs, const std::vector<IOTensor>& outputs,
+        std::vector<std::vector<int32_t>>& outputsDims, std::vector<bool>& isOutputBufferEnough) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    OH_NN_ReturnCode Run(const std::vector<NN_Tensor*>& inputs, const std::vector<NN_Tensor*>& outputs,
+        std::vector<std::vector<int32_t>>& outputsDims, std::vector<bool>& isOutputBufferEnough) override
+    {
+        outputsDims.resize(outputs.size());
+        for (auto& dims : outputsDims) {
+            dims.assign(TENSOR_SHAPE.begin(), TENSOR_SHAPE.end());
+        }
+        return OH_NN_SUCCESS;
+    }
+
+    OH_NN_ReturnCode GetInputDimRanges(std::vector<std::vector<uint32_t>>& minInputDims,
+        std::vector<std::vector<uint32_t>>& maxInputDims) override
+    {
+        ++m_dimRangesQueryNum;
+        minInputDims.assign(IO_NUM, std::vector<uint32_t>(TENSOR_SHAPE.size(), 1));
+        maxInputDims.assign(IO_NUM, std::vector<uint32_t>(TENSOR_SHAPE.begin(), TENSOR_SHAPE.end()));
+        return OH_NN_SUCCESS;
+    }
+
+    size_t m_dimRangesQueryNum {0};
+};
+
+class NoOpDevice : public Device {
+public:
+    OH_NN_ReturnCode GetDeviceName(std::string& name) override
+    {
+        name = "NoOpDevice";
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetVendorName(std::string& name) override
+    {
+        name = "NoOpVendor";
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetVersion(std::string& version) override
+    {
+        version = "1.0";
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetDeviceType(OH_NN_DeviceType& deviceType) override
+    {
+        deviceType = OH_NN_OTHERS;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetDeviceStatus(DeviceStatus& status) override
+    {
+        status = AVAILABLE;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetSupportedOperation(std::shared_ptr<const mindspore::lite::LiteGraph> model,
+        std::vector<bool>& ops) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode IsFloat16PrecisionSupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode IsPerformanceModeSupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode IsPrioritySupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode IsDynamicInputSupported(bool& isSupported) override
+    {
+        isSupported = true;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode IsModelCacheSupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode PrepareModel(std::shared_ptr<const mindspore::lite::LiteGraph> model, const ModelConfig& config,
+        std::shared_ptr<PreparedModel>& preparedModel) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode PrepareModel(const void* metaGraph, const Buffer& quantBuffer, const ModelConfig& config,
+        std::shared_ptr<PreparedModel>& preparedModel) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode PrepareModelFromModelCache(const std::vector<Buffer>& modelCache, const ModelConfig& config,
+        std::shared_ptr<PreparedModel>& preparedModel) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode PrepareOfflineModel(std::shared_ptr<const mindspore::lite::LiteGraph> model,
+        const ModelConfig& config, std::shared_ptr<PreparedModel>& preparedModel) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    void* AllocateBuffer(size_t length) override
+    {
+        return nullptr;
+    }
+    void* AllocateTensorBuffer(size_t length, std::shared_ptr<TensorDesc> tensor) override
+    {
+        return nullptr;
+    }
+    void* AllocateTensorBuffer(size_t length, std::shared_ptr<NNTensor> tensor) override
+    {
+        return nullptr;
+    }
+    OH_NN_ReturnCode ReleaseBuffer(const void* buffer) override
+    {
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode AllocateBuffer(size_t length, int& fd) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode ReleaseBuffer(int fd, size_t length) override
+    {
+        return OH_NN_SUCCESS;
+    }
+};
+
+class ExecutorOverheadBenchmark : public testing::Test {
+public:
+    void SetUp()
+    {
+        std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> inputTensorDescs;
+        std::vector<std::pair<std::shared_ptr<TensorDesc>, OH_NN_TensorType>> outputTensorDescs;
+        for (size_t i = 0; i < IO_NUM; ++i) {
+            inputTensorDescs.emplace_back(CreateTensorDesc(), OH_NN_TENSOR);
+            outputTensorDescs.emplace_back(CreateTensorDesc(), OH_NN_TENSOR);
+
+            // The device never touches the data, so the tensors are created without buffers.
+            m_tensors.emplace_back(std::make_unique<NNTensor2_0>(0));
+            ASSERT_EQ(OH_NN_SUCCESS, m_tensors.back()->SetTensorDesc(inputTensorDescs.back().first.get()));
+            m_inputTensors.emplace_back(reinterpret_cast<NN_Tensor*>(m_tensors.back().get()));
+            m_tensors.emplace_back(std::make_unique<NNTensor2_0>(0));
+            ASSERT_EQ(OH_NN_SUCCESS, m_tensors.back()->SetTensorDesc(outputTensorDescs.back().first.get()));
+            m_outputTensors.emplace_back(reinterpret_cast<NN_Tensor*>(m_tensors.back().get()));
+        }
+
+        m_preparedModel = std::make_shared<NoOpPreparedModel>();
+        m_executor = std::make_unique<NNExecutor>(0, std::make_shared<NoOpDevice>(), m_preparedModel,
+            inputTensorDescs, outputTensorDescs);
+    }
+
+    void TearDown()
+    {
+        m_executor.reset();
+        m_inputTensors.clear();
+        m_outputTensors.clear();
+        m_tensors.clear();
+    }
+
+    std::shared_ptr<TensorDesc> CreateTensorDesc() const
+    {
+        auto tensorDesc = std::make_shared<TensorDesc>();
+        tensorDesc->SetDataType(OH_NN_FLOAT32);
+        tensorDesc->SetShape(TENSOR_SHAPE.data(), TENSOR_SHAPE.size());
+        return tensorDesc;
+    }
+
+public:
+    std::shared_ptr<NoOpPreparedModel> m_preparedModel;
+    std::unique_ptr<NNExecutor> m_executor;
+    std::vector<std::unique_ptr<NNTensor2_0>> m_tensors;
+    std::vector<NN_Tensor*> m_inputTensors;
+    std::vector<NN_Tensor*> m_outputTensors;
+};
+
+/*
+ * @tc.name: executor_overhead_benchmark_001
+ * @tc.desc: Measure the per-call overhead of NNExecutor::RunSync on a no-op device.
+ * @tc.type: PERF
+ */
+HWTEST_F(ExecutorOverheadBenchmark, executor_overhead_benchmark_001, testing::ext::TestSize.Level3)
+{
+    // Warm up the scratch storage of the executor.
+    ASSERT_EQ(OH_NN_SUCCESS, m_executor->RunSync(m_inputTensors.data(), m_inputTensors.size(),
+        m_outputTensors.data(), m_outputTensors.size()));
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < RUN_TIMES; ++i) {
+        ASSERT_EQ(OH_NN_SUCCESS, m_executor->RunSync(m_inputTensors.data(), m_inputTensors.size(),
+            m_outputTensors.data(), m_outputTensors.size()));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Dim ranges are queried once when the executor is constructed, never on the run path.
+    EXPECT_EQ(1, m_preparedModel->m_dimRangesQueryNum);
+    std::cout << "[ExecutorOverheadBenchmark] RunSync: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / RUN_TIMES
+              << " ns per call." << std::endl;
+}
+} // namespace SystemTest
+} // namespace NeuralNetworkRuntime
+} // namespace OHOS
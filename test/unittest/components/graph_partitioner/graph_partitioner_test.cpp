@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "backend_manager.h"
+#include "device.h"
+#include "graph_partitioner.h"
+#include "nnbackend.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace OHOS::NeuralNetworkRuntime;
+namespace MSLITE = mindspore::lite;
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace UnitTest {
+namespace {
+constexpr size_t PREFERRED_BACKEND_ID = 0x7E57A001;
+constexpr size_t FALLBACK_BACKEND_ID = 0x7E57A002;
+
+// Supports the nodes whose names are in supportedNodes, or every node if supportsAll is set.
+class PartitionMockDevice : public Device {
+public:
+    PartitionMockDevice(const std::string& name, OH_NN_DeviceType deviceType) : m_name(name), m_deviceType(deviceType)
+    {}
+
+    OH_NN_ReturnCode GetDeviceName(std::string& name) override
+    {
+        name = m_name;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetVendorName(std::string& name) override
+    {
+        name = "MockVendor";
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetVersion(std::string& version) override
+    {
+        version = "MockVersion";
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetDeviceType(OH_NN_DeviceType& deviceType) override
+    {
+        deviceType = m_deviceType;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetDeviceStatus(DeviceStatus& status) override
+    {
+        status = AVAILABLE;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetSupportedOperation(std::shared_ptr<const MSLITE::LiteGraph> model,
+        std::vector<bool>& ops) override
+    {
+        ops.clear();
+        for (const auto node : model->all_nodes_) {
+            ops.emplace_back(supportsAll || (supportedNodes.count(node->name_) != 0));
+        }
+        return OH_NN_SUCCESS;
+    }
+
+    OH_NN_ReturnCode IsFloat16PrecisionSupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode IsPerformanceModeSupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode IsPrioritySupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode IsDynamicInputSupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode IsModelCacheSupported(bool& isSupported) override
+    {
+        isSupported = false;
+        return OH_NN_SUCCESS;
+    }
+
+    OH_NN_ReturnCode PrepareModel(std::shared_ptr<const MSLITE::LiteGraph> model, const ModelConfig& config,
+        std::shared_ptr<PreparedModel>& preparedModel) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode PrepareModel(const void* metaGraph, const Buffer& quantBuffer, const ModelConfig& config,
+        std::shared_ptr<PreparedModel>& preparedModel) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode PrepareModelFromModelCache(const std::vector<Buffer>& modelCache, const ModelConfig& config,
+        std::shared_ptr<PreparedModel>& preparedModel) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode PrepareOfflineModel(std::shared_ptr<const MSLITE::LiteGraph> model, const ModelConfig& config,
+        std::shared_ptr<PreparedModel>& preparedModel) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    void* AllocateBuffer(size_t length) override
+    {
+        return nullptr;
+    }
+    void* AllocateTensorBuffer(size_t length, std::shared_ptr<TensorDesc> tensor) override
+    {
+        return nullptr;
+    }
+    void* AllocateTensorBuffer(size_t length, std::shared_ptr<NNTensor> tensor) override
+    {
+        return nullptr;
+    }
+    OH_NN_ReturnCode ReleaseBuffer(const void* buffer) override
+    {
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode AllocateBuffer(size_t length, int& fd) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode ReleaseBuffer(int fd, size_t length) override
+    {
+        return OH_NN_SUCCESS;
+    }
+
+public:
+    bool supportsAll {false};
+    std::set<std::string> supportedNodes;
+
+private:
+    std::string m_name;
+    OH_NN_DeviceType m_deviceType {OH_NN_OTHERS};
+};
+
+class LiteGraphDeleter {
+public:
+    void operator()(MSLITE::LiteGraph* liteGraph) const
+    {
+        MSLITE::MindIR_LiteGraph_Destroy(&liteGraph);
+    }
+};
+}
+
+class GraphPartitionerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    void SetUp() override;
+
+    // Builds a graph of numTensors float tensors, tensors with a dynamic shape are listed in dynamicTensors.
+    std::shared_ptr<MSLITE::LiteGraph> CreateGraph(size_t numTensors, const std::vector<uint32_t>& dynamicTensors);
+    void AddNode(MSLITE::LiteGraph& liteGraph, const std::string& name, const std::vector<uint32_t>& inputs,
+        const std::vector<uint32_t>& outputs);
+
+public:
+    static std::shared_ptr<PartitionMockDevice> s_preferredDevice;
+    static std::shared_ptr<PartitionMockDevice> s_fallbackDevice;
+};
+
+std::shared_ptr<PartitionMockDevice> GraphPartitionerTest::s_preferredDevice {nullptr};
+std::shared_ptr<PartitionMockDevice> GraphPartitionerTest::s_fallbackDevice {nullptr};
+
+void GraphPartitionerTest::SetUpTestCase()
+{
+    s_preferredDevice = std::make_shared<PartitionMockDevice>("PreferredDevice", OH_NN_CPU);
+    s_fallbackDevice = std::make_shared<PartitionMockDevice>("FallbackDevice", OH_NN_ACCELERATOR);
+    BackendManager& backendManager = BackendManager::GetInstance();
+    backendManager.RegisterBackend([]() -> std::shared_ptr<Backend> {
+        return std::make_shared<NNBackend>(s_preferredDevice, PREFERRED_BACKEND_ID);
+    });
+    backendManager.RegisterBackend([]() -> std::shared_ptr<Backend> {
+        return std::make_shared<NNBackend>(s_fallbackDevice, FALLBACK_BACKEND_ID);
+    });
+}
+
+void GraphPartitionerTest::SetUp()
+{
+    s_preferredDevice->supportsAll = false;
+    s_preferredDevice->supportedNodes.clear();
+    s_fallbackDevice->supportsAll = true;
+    s_fallbackDevice->supportedNodes.clear();
+}
+
+std::shared_ptr<MSLITE::LiteGraph> GraphPartitionerTest::CreateGraph(size_t numTensors,
+    const std::vector<uint32_t>& dynamicTensors)
+{
+    std::shared_ptr<MSLITE::LiteGraph> liteGraph(new MSLITE::LiteGraph(), LiteGraphDeleter());
+    liteGraph->name_ = "partitionGraph";
+    const std::vector<MSLITE::QuantParam> quantParams;
+    const std::vector<uint8_t> data;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(numTensors); ++i) {
+        bool isDynamic = std::find(dynamicTensors.begin(), dynamicTensors.end(), i) != dynamicTensors.end();
+        std::vector<int32_t> dims = isDynamic ? std::vector<int32_t> {-1, 3} : std::vector<int32_t> {1, 3};
+        liteGraph->all_tensors_.emplace_back(MSLITE::MindIR_Tensor_Create("tensor" + std::to_string(i),
+            MSLITE::DATA_TYPE_FLOAT32, dims, MSLITE::FORMAT_NCHW, data, quantParams));
+    }
+    return liteGraph;
+}
+
+void GraphPartitionerTest::AddNode(MSLITE::LiteGraph& liteGraph, const std::string& name,
+    const std::vector<uint32_t>& inputs, const std::vector<uint32_t>& outputs)
+{
+    MSLITE::LiteGraph::Node* node = new MSLITE::LiteGraph::Node();
+    node->name_ = name;
+    node->primitive_ = MSLITE::MindIR_AddFusion_CreatePrimitive(MSLITE::ACTIVATION_TYPE_NO_ACTIVATION);
+    node->input_indices_ = inputs;
+    node->output_indices_ = outputs;
+    liteGraph.all_nodes_.emplace_back(node);
+}
+
+/**
+ * @tc.name: graph_partitioner_partition_001
+ * @tc.desc: Verify that consecutive nodes of the same backend form one partition, and the graph is split where the
+ *           backend changes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GraphPartitionerTest, graph_partitioner_partition_001, TestSize.Level0)
+{
+    // t0 -> n0 -> t1 -> n1 -> t2 -> n2 -> t3 -> n3 -> t4, n1 is only supported by the fallback backend.
+    std::shared_ptr<MSLITE::LiteGraph> liteGraph = CreateGraph(5, {});
+    liteGraph->input_indices_ = {0};
+    liteGraph->output_indices_ = {4};
+    AddNode(*liteGraph, "n0", {0}, {1});
+    AddNode(*liteGraph, "n1", {1}, {2});
+    AddNode(*liteGraph, "n2", {2}, {3});
+    AddNode(*liteGraph, "n3", {3}, {4});
+    s_preferredDevice->supportedNodes = {"n0", "n2", "n3"};
+
+    std::vector<GraphPartition> partitions;
+    OH_NN_ReturnCode ret = GraphPartitioner(liteGraph, PREFERRED_BACKEND_ID).Partition(partitions);
+    EXPECT_EQ(OH_NN_SUCCESS, ret);
+    ASSERT_EQ(3U, partitions.size());
+
+    EXPECT_EQ(PREFERRED_BACKEND_ID, partitions[0].backendID);
+    EXPECT_EQ(std::vector<uint32_t>({0}), partitions[0].inputIndices);
+    EXPECT_EQ(std::vector<uint32_t>({1}), partitions[0].outputIndices);
+    EXPECT_EQ(1U, partitions[0].liteGraph->all_nodes_.size());
+
+    EXPECT_EQ(FALLBACK_BACKEND_ID, partitions[1].backendID);
+    EXPECT_EQ(std::vector<uint32_t>({1}), partitions[1].inputIndices);
+    EXPECT_EQ(std::vector<uint32_t>({2}), partitions[1].outputIndices);
+    EXPECT_EQ(1U, partitions[1].liteGraph->all_nodes_.size());
+
+    EXPECT_EQ(PREFERRED_BACKEND_ID, partitions[2].backendID);
+    EXPECT_EQ(std::vector<uint32_t>({2}), partitions[2].inputIndices);
+    EXPECT_EQ(std::vector<uint32_t>({4}), partitions[2].outputIndices);
+    ASSERT_EQ(2U, partitions[2].liteGraph->all_nodes_.size());
+    EXPECT_EQ(1U, partitions[2].liteGraph->sub_graphs_.size());
+    EXPECT_EQ(1U, partitions[2].inputTensorDescs.size());
+    EXPECT_EQ(1U, partitions[2].outputTensorDescs.size());
+
+    // The tensors of a partition are renumbered, t3 stays inside the last partition.
+    EXPECT_EQ(3U, partitions[2].liteGraph->all_tensors_.size());
+    EXPECT_EQ(partitions[2].liteGraph->all_nodes_[0]->output_indices_,
+              partitions[2].liteGraph->all_nodes_[1]->input_indices_);
+}
+
+/**
+ * @tc.name: graph_partitioner_partition_002
+ * @tc.desc: Verify that a graph whose nodes are not in topological order across partitions is rejected.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GraphPartitionerTest, graph_partitioner_partition_002, TestSize.Level0)
+{
+    // n0 consumes t1, which is produced by the later node n1 on another backend.
+    std::shared_ptr<MSLITE::LiteGraph> liteGraph = CreateGraph(3, {});
+    liteGraph->input_indices_ = {0};
+    liteGraph->output_indices_ = {2};
+    AddNode(*liteGraph, "n0", {1}, {2});
+    AddNode(*liteGraph, "n1", {0}, {1});
+    s_preferredDevice->supportedNodes = {"n0"};
+
+    std::vector<GraphPartition> partitions;
+    OH_NN_ReturnCode ret = GraphPartitioner(liteGraph, PREFERRED_BACKEND_ID).Partition(partitions);
+    EXPECT_EQ(OH_NN_INVALID_PARAMETER, ret);
+    EXPECT_TRUE(partitions.empty());
+}
+
+/**
+ * @tc.name: graph_partitioner_partition_003
+ * @tc.desc: Verify that a tensor of dynamic shape passed between partitions is rejected.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GraphPartitionerTest, graph_partitioner_partition_003, TestSize.Level0)
+{
+    std::shared_ptr<MSLITE::LiteGraph> liteGraph = CreateGraph(3, {1});
+    liteGraph->input_indices_ = {0};
+    liteGraph->output_indices_ = {2};
+    AddNode(*liteGraph, "n0", {0}, {1});
+    AddNode(*liteGraph, "n1", {1}, {2});
+    s_preferredDevice->supportedNodes = {"n0"};
+
+    std::vector<GraphPartition> partitions;
+    OH_NN_ReturnCode ret = GraphPartitioner(liteGraph, PREFERRED_BACKEND_ID).Partition(partitions);
+    EXPECT_EQ(OH_NN_OPERATION_FORBIDDEN, ret);
+    EXPECT_TRUE(partitions.empty());
+}
+
+/**
+ * @tc.name: graph_partitioner_partition_004
+ * @tc.desc: Verify that dynamic graph inputs and outputs are allowed, only the tensors between partitions must be
+ *           static.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GraphPartitionerTest, graph_partitioner_partition_004, TestSize.Level0)
+{
+    std::shared_ptr<MSLITE::LiteGraph> liteGraph = CreateGraph(3, {0, 2});
+    liteGraph->input_indices_ = {0};
+    liteGraph->output_indices_ = {2};
+    AddNode(*liteGraph, "n0", {0}, {1});
+    AddNode(*liteGraph, "n1", {1}, {2});
+    s_preferredDevice->supportedNodes = {"n0"};
+
+    std::vector<GraphPartition> partitions;
+    OH_NN_ReturnCode ret = GraphPartitioner(liteGraph, PREFERRED_BACKEND_ID).Partition(partitions);
+    EXPECT_EQ(OH_NN_SUCCESS, ret);
+    EXPECT_EQ(2U, partitions.size());
+}
+
+/**
+ * @tc.name: graph_partitioner_partition_005
+ * @tc.desc: Verify that a graph output consumed by a later partition is an output of its producing partition and an
+ *           input of the consuming one.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GraphPartitionerTest, graph_partitioner_partition_005, TestSize.Level0)
+{
+    // t1 is a graph output, and also consumed by n1 together with the graph input t0.
+    std::shared_ptr<MSLITE::LiteGraph> liteGraph = CreateGraph(3, {});
+    liteGraph->input_indices_ = {0};
+    liteGraph->output_indices_ = {1, 2};
+    AddNode(*liteGraph, "n0", {0}, {1});
+    AddNode(*liteGraph, "n1", {1, 0}, {2});
+    s_preferredDevice->supportedNodes = {"n0"};
+
+    std::vector<GraphPartition> partitions;
+    OH_NN_ReturnCode ret = GraphPartitioner(liteGraph, PREFERRED_BACKEND_ID).Partition(partitions);
+    EXPECT_EQ(OH_NN_SUCCESS, ret);
+    ASSERT_EQ(2U, partitions.size());
+    EXPECT_EQ(std::vector<uint32_t>({0}), partitions[0].inputIndices);
+    EXPECT_EQ(std::vector<uint32_t>({1}), partitions[0].outputIndices);
+    EXPECT_EQ(std::vector<uint32_t>({1, 0}), partitions[1].inputIndices);
+    EXPECT_EQ(std::vector<uint32_t>({2}), partitions[1].outputIndices);
+}
+} // namespace UnitTest
+} // namespace NeuralNetworkRuntime
+} // namespace OHOS
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "backend_manager.h"
+#include "pipeline_executor.h"
+
+using namespace testing;
+using namespace testing::ext;
+using namespace OHOS::NeuralNetworkRuntime;
+namespace OHOS {
+namespace NeuralNetworkRuntime {
+namespace UnitTest {
+namespace {
+constexpr size_t PIPELINE_BACKEND_ID = 0x7E57B001;
+constexpr size_t STAGE_NUM = 3;
+constexpr size_t INTERMEDIATE_NUM = 2;
+
+// Holds a single float value in host memory.
+class PipelineMockTensor : public Tensor {
+public:
+    OH_NN_ReturnCode SetTensorDesc(const TensorDesc* tensorDesc) override
+    {
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode CreateData() override
+    {
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode CreateData(size_t size) override
+    {
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode CreateData(int fd, size_t size, size_t offset) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    TensorDesc* GetTensorDesc() const override
+    {
+        return nullptr;
+    }
+    void* GetData() const override
+    {
+        return const_cast<float*>(&m_value);
+    }
+    int GetFd() const override
+    {
+        return -1;
+    }
+    size_t GetSize() const override
+    {
+        return sizeof(m_value);
+    }
+    size_t GetOffset() const override
+    {
+        return 0;
+    }
+    size_t GetBackendID() const override
+    {
+        return PIPELINE_BACKEND_ID;
+    }
+
+private:
+    float m_value {0.0f};
+};
+
+// Adds one to its input, and records the intermediate tensors it has been given for every request.
+class PipelineMockExecutor : public Executor {
+public:
+    OH_NN_ReturnCode GetInputDimRange(size_t inputIndex, size_t** minInputDims, size_t** maxInputDims,
+        size_t* shapeNum) const override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode GetOutputShape(uint32_t outputIndex, int32_t** shape, uint32_t* shapeNum) const override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+
+    size_t GetInputNum() const override
+    {
+        return 1;
+    }
+    size_t GetOutputNum() const override
+    {
+        return 1;
+    }
+    NN_TensorDesc* CreateInputTensorDesc(size_t index) const override
+    {
+        return nullptr;
+    }
+    NN_TensorDesc* CreateOutputTensorDesc(size_t index) const override
+    {
+        return nullptr;
+    }
+
+    OH_NN_ReturnCode SetOnRunDone(NN_OnRunDone onRunDone) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode SetOnServiceDied(NN_OnServiceDied onServiceDied) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode RunSync(NN_Tensor* inputTensors[], size_t inputSize, NN_Tensor* outputTensors[],
+        size_t outputSize) override
+    {
+        Tensor* input = reinterpret_cast<Tensor*>(inputTensors[0]);
+        Tensor* output = reinterpret_cast<Tensor*>(outputTensors[0]);
+        *static_cast<float*>(output->GetData()) = *static_cast<float*>(input->GetData()) + 1.0f;
+
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_seenInputs.emplace_back(input);
+        m_seenOutputs.emplace_back(output);
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode RunAsync(NN_Tensor* inputTensors[], size_t inputSize, NN_Tensor* outputTensors[],
+        size_t outputSize, int32_t timeout, void* userData) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode RunBatch(NN_Tensor* inputTensors[], size_t inputSize, NN_Tensor* outputTensors[],
+        size_t outputSize, size_t batchSize) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode BindIOTensors(NN_Tensor* inputTensors[], size_t inputSize, NN_Tensor* outputTensors[],
+        size_t outputSize, size_t* bindingId) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode RunSyncWithBinding(size_t bindingId) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode UnbindIOTensors(size_t bindingId) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    OH_NN_ReturnCode SetOutputAutoGrowth(bool enable) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    size_t GetBackendID() override
+    {
+        return PIPELINE_BACKEND_ID;
+    }
+
+public:
+    // Tensors given to RunSync, in the order of the requests
+    std::vector<Tensor*> m_seenInputs;
+    std::vector<Tensor*> m_seenOutputs;
+
+private:
+    std::mutex m_mtx;
+};
+
+// Creates PipelineMockTensor for the intermediate tensors and counts them.
+class PipelineMockBackend : public Backend {
+public:
+    size_t GetBackendID() const override
+    {
+        return PIPELINE_BACKEND_ID;
+    }
+    OH_NN_ReturnCode GetBackendName(std::string& name) const override
+    {
+        name = "PipelineMockBackend";
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetBackendType(OH_NN_DeviceType& backendType) const override
+    {
+        backendType = OH_NN_OTHERS;
+        return OH_NN_SUCCESS;
+    }
+    OH_NN_ReturnCode GetBackendStatus(DeviceStatus& status) const override
+    {
+        status = AVAILABLE;
+        return OH_NN_SUCCESS;
+    }
+
+    Compiler* CreateCompiler(Compilation* compilation) override
+    {
+        return nullptr;
+    }
+    OH_NN_ReturnCode DestroyCompiler(Compiler* compiler) override
+    {
+        return OH_NN_OPERATION_FORBIDDEN;
+    }
+    Executor* CreateExecutor(Compilation* compilation) override
+    {
+        return nullptr;
+    }
+    OH_NN_ReturnCode DestroyExecutor(Executor* executor) override
+    {
+        delete executor;
+        return OH_NN_SUCCESS;
+    }
+    Tensor* CreateTensor(TensorDesc* desc) override
+    {
+        ++createdTensorNum;
+        return new (std::nothrow) PipelineMockTensor();
+    }
+    OH_NN_ReturnCode DestroyTensor(Tensor* tensor) override
+    {
+        delete tensor;
+        return OH_NN_SUCCESS;
+    }
+
+public:
+    std::atomic<size_t> createdTensorNum {0};
+};
+}
+
+class PipelineExecutorTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    void SetUp() override;
+
+public:
+    static std::shared_ptr<PipelineMockBackend> s_backend;
+};
+
+std::shared_ptr<PipelineMockBackend> PipelineExecutorTest::s_backend {nullptr};
+
+void PipelineExecutorTest::SetUpTestCase()
+{
+    s_backend = std::make_shared<PipelineMockBackend>();
+    BackendManager::GetInstance().RegisterBackend([]() -> std::shared_ptr<Backend> {
+        return s_backend;
+    });
+}
+
+void PipelineExecutorTest::SetUp()
+{
+    s_backend->createdTensorNum = 0;
+}
+
+/**
+ * @tc.name: pipeline_executor_runbatch_001
+ * @tc.desc: Verify that RunBatch allocates one slot of intermediate tensors per stage, and a request reuses the slot
+ *           of the request one pipeline depth before it.
+ * @tc.type: FUNC
+ */
+HWTEST_F(PipelineExecutorTest, pipeline_executor_runbatch_001, TestSize.Level0)
+{
+    // input -> stage0 -> i0 -> stage1 -> i1 -> stage2 -> output
+    std::vector<PipelineMockExecutor*> stageExecutors;
+    std::vector<PipelineStage> stages(STAGE_NUM);
+    for (size_t i = 0; i < STAGE_NUM; ++i) {
+        stageExecutors.emplace_back(new PipelineMockExecutor());
+        stages[i].backendID = PIPELINE_BACKEND_ID;
+        stages[i].executor = stageExecutors[i];
+        stages[i].inputs = {{(i == 0) ? PipelineTensorKind::PIPELINE_INPUT : PipelineTensorKind::INTERMEDIATE,
+            (i == 0) ? 0 : i - 1}};
+        stages[i].outputs = {{(i == STAGE_NUM - 1) ? PipelineTensorKind::PIPELINE_OUTPUT :
+            PipelineTensorKind::INTERMEDIATE, (i == STAGE_NUM - 1) ? 0 : i}};
+    }
+    std::vector<std::shared_ptr<TensorDesc>> intermediateTensorDescs;
+    for (size_t i = 0; i < INTERMEDIATE_NUM; ++i) {
+        intermediateTensorDescs.emplace_back(std::make_shared<TensorDesc>());
+    }
+    PipelineExecutor pipelineExecutor(PIPELINE_BACKEND_ID, 1, 1, stages, intermediateTensorDescs);
+
+    const size_t batchSize = 5;
+    std::vector<PipelineMockTensor> inputs(batchSize);
+    std::vector<PipelineMockTensor> outputs(batchSize);
+    std::vector<NN_Tensor*> inputTensors;
+    std::vector<NN_Tensor*> outputTensors;
+    for (size_t r = 0; r < batchSize; ++r) {
+        *static_cast<float*>(inputs[r].GetData()) = static_cast<float>(r);
+        inputTensors.emplace_back(reinterpret_cast<NN_Tensor*>(&inputs[r]));
+        outputTensors.emplace_back(reinterpret_cast<NN_Tensor*>(&outputs[r]));
+    }
+
+    OH_NN_ReturnCode ret = pipelineExecutor.RunBatch(inputTensors.data(), 1, outputTensors.data(), 1, batchSize);
+    EXPECT_EQ(OH_NN_SUCCESS, ret);
+    for (size_t r = 0; r < batchSize; ++r) {
+        EXPECT_EQ(static_cast<float>(r + STAGE_NUM), *static_cast<float*>(outputs[r].GetData()));
+    }
+    EXPECT_EQ(STAGE_NUM * INTERMEDIATE_NUM, s_backend->createdTensorNum.load());
+
+    // The first stage writes the intermediate tensors of request r into slot r % STAGE_NUM.
+    const std::vector<Tensor*>& slotTensors = stageExecutors[0]->m_seenOutputs;
+    ASSERT_EQ(batchSize, slotTensors.size());
+    for (size_t r = 0; r + STAGE_NUM < batchSize; ++r) {
+        EXPECT_EQ(slotTensors[r], slotTensors[r + STAGE_NUM]);
+    }
+    EXPECT_NE(slotTensors[0], slotTensors[1]);
+    EXPECT_NE(slotTensors[1], slotTensors[2]);
+    EXPECT_EQ(stageExecutors[0]->m_seenOutputs, stageExecutors[1]->m_seenInputs);
+
+    // The slots are kept for the following runs.
+    ret = pipelineExecutor.RunBatch(inputTensors.data(), 1, outputTensors.data(), 1, batchSize);
+    EXPECT_EQ(OH_NN_SUCCESS, ret);
+    EXPECT_EQ(STAGE_NUM * INTERMEDIATE_NUM, s_backend->createdTensorNum.load());
+}
+} // namespace UnitTest
+} // namespace NeuralNetworkRuntime
+} // namespace OHOS
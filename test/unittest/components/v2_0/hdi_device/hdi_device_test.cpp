@@ -350,7 +350,7 @@ HWTEST_F(HDIDeviceTest, hdidevice_getsupportedoperation_001, TestSize.Level0)
 
 /* *
  * @tc.name: hdidevice_getsupportedoperation_002
- * @tc.desc: Verify the GetSupportedOperation function return failed in case of allocate buffer failure.
+ * @tc.desc: Verify the GetSupportedOperation function does not allocate buffer for the constant tensors.
  * @tc.type: FUNC
  */
 HWTEST_F(HDIDeviceTest, hdidevice_getsupportedoperation_002, TestSize.Level0)
@@ -364,12 +364,12 @@ HWTEST_F(HDIDeviceTest, hdidevice_getsupportedoperation_002, TestSize.Level0)
     std::unique_ptr<HDIDeviceV2_0> hdiDevice = std::make_unique<HDIDeviceV2_0>(device);
     EXPECT_NE(hdiDevice, nullptr);
 
-    V2_0::SharedBuffer buffer {1, 1, 0, 1};
-    EXPECT_CALL(*((V2_0::MockIDevice *)device.GetRefPtr()), AllocateBuffer(::testing::_, ::testing::_))
-        .WillRepeatedly(::testing::DoAll(::testing::SetArgReferee<1>(buffer), ::testing::Return(HDF_FAILURE)));
+    EXPECT_CALL(*((V2_0::MockIDevice *)device.GetRefPtr()), AllocateBuffer(::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(*((V2_0::MockIDevice *)device.GetRefPtr()), GetSupportedOperation(::testing::_, ::testing::_))
+        .WillRepeatedly(::testing::Return(HDF_SUCCESS));
 
     OH_NN_ReturnCode result = hdiDevice->GetSupportedOperation(model, ops);
-    EXPECT_EQ(OH_NN_FAILED, result);
+    EXPECT_EQ(OH_NN_SUCCESS, result);
 }
 
 /* *